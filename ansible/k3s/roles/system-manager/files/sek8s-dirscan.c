@@ -0,0 +1,393 @@
+/*
+ * sek8s-dirscan: parallel directory size scanner for the system-manager disk endpoint.
+ *
+ * Walks a tree with getdents64 + statx on a pool of threads and prints the
+ * disk usage (allocated blocks, like du) of every directory up to a maximum
+ * depth, including everything below it.  Files with several hard links are
+ * counted once.  Records are NUL-terminated so any path can be represented:
+ *
+ *     <bytes>\t<depth>\t<path>\0
+ *
+ * The root is depth 0.  The number of entries that could not be read is
+ * reported on stderr as "errors=<n>", and the number of multiply-linked files
+ * seen as "hardlinks=<n>" (a scan of a subtree counts those once within the
+ * subtree only, so its size cannot be swapped into a larger scan).
+ */
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define DENTS_BUF_SIZE (1 << 20)
+#define INODE_STRIPES 256
+#define MAX_EXCLUDES 64
+
+struct linux_dirent64 {
+    uint64_t d_ino;
+    int64_t d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[];
+};
+
+/* A directory reported in the output (depth <= max_depth). */
+struct node {
+    char *path;
+    int depth;
+    struct node *parent;
+    uint64_t own;   /* bytes of this directory and of entries accounted to it */
+    uint64_t total; /* own + all descendant nodes, filled in after the walk */
+};
+
+/* A directory still to be read; entries are accounted to acct. */
+struct work {
+    char *path;
+    int depth;
+    struct node *acct;
+    struct work *next;
+};
+
+struct inode_key {
+    uint64_t dev;
+    uint64_t ino;
+};
+
+struct inode_set {
+    pthread_mutex_t lock;
+    struct inode_key *keys;
+    size_t capacity;
+    size_t count;
+};
+
+static int max_depth = 1;
+static int one_filesystem = 0;
+static uint64_t root_dev;
+static const char *excludes[MAX_EXCLUDES];
+static int num_excludes = 0;
+
+static pthread_mutex_t queue_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t queue_cond = PTHREAD_COND_INITIALIZER;
+static struct work *queue_head = NULL;
+static long pending = 0; /* queued + being read */
+
+static pthread_mutex_t nodes_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct node **nodes = NULL;
+static size_t num_nodes = 0, nodes_capacity = 0;
+
+static struct inode_set inode_sets[INODE_STRIPES];
+static uint64_t error_count = 0;
+static uint64_t hardlink_count = 0;
+
+static void *xmalloc(size_t size) {
+    void *p = malloc(size);
+    if (!p) {
+        fprintf(stderr, "Error: out of memory\n");
+        exit(1);
+    }
+    return p;
+}
+
+static uint64_t dev_of(const struct statx *stx) {
+    return ((uint64_t)stx->stx_dev_major << 32) | stx->stx_dev_minor;
+}
+
+static char *join_path(const char *dir, const char *name) {
+    size_t dlen = strlen(dir), nlen = strlen(name);
+    int sep = dlen > 0 && dir[dlen - 1] != '/';
+    char *path = xmalloc(dlen + sep + nlen + 1);
+    memcpy(path, dir, dlen);
+    if (sep)
+        path[dlen] = '/';
+    memcpy(path + dlen + sep, name, nlen + 1);
+    return path;
+}
+
+static int is_excluded(const char *path) {
+    for (int i = 0; i < num_excludes; i++) {
+        if (strcmp(path, excludes[i]) == 0)
+            return 1;
+    }
+    return 0;
+}
+
+/* Returns 1 the first time (dev, ino) is seen, 0 afterwards. */
+static int first_sighting(uint64_t dev, uint64_t ino) {
+    uint64_t hash = (ino * 0x9E3779B97F4A7C15ULL) ^ dev;
+    struct inode_set *set = &inode_sets[hash % INODE_STRIPES];
+    int inserted = 0;
+
+    pthread_mutex_lock(&set->lock);
+    if (set->count * 2 >= set->capacity) {
+        size_t capacity = set->capacity ? set->capacity * 2 : 1024;
+        struct inode_key *keys = calloc(capacity, sizeof(*keys));
+        if (!keys) {
+            fprintf(stderr, "Error: out of memory\n");
+            exit(1);
+        }
+        for (size_t i = 0; i < set->capacity; i++) {
+            struct inode_key *k = &set->keys[i];
+            if (k->ino == 0 && k->dev == 0)
+                continue;
+            size_t j = ((k->ino * 0x9E3779B97F4A7C15ULL) >> 8) & (capacity - 1);
+            while (keys[j].ino || keys[j].dev)
+                j = (j + 1) & (capacity - 1);
+            keys[j] = *k;
+        }
+        free(set->keys);
+        set->keys = keys;
+        set->capacity = capacity;
+    }
+    size_t j = ((ino * 0x9E3779B97F4A7C15ULL) >> 8) & (set->capacity - 1);
+    for (;;) {
+        struct inode_key *k = &set->keys[j];
+        if (k->ino == 0 && k->dev == 0) {
+            k->dev = dev;
+            k->ino = ino ? ino : 1;
+            set->count++;
+            inserted = 1;
+            break;
+        }
+        if (k->dev == dev && k->ino == ino)
+            break;
+        j = (j + 1) & (set->capacity - 1);
+    }
+    pthread_mutex_unlock(&set->lock);
+    return inserted;
+}
+
+static struct node *add_node(char *path, int depth, struct node *parent) {
+    struct node *n = xmalloc(sizeof(*n));
+    n->path = path;
+    n->depth = depth;
+    n->parent = parent;
+    n->own = 0;
+    n->total = 0;
+    pthread_mutex_lock(&nodes_lock);
+    if (num_nodes == nodes_capacity) {
+        nodes_capacity = nodes_capacity ? nodes_capacity * 2 : 256;
+        nodes = realloc(nodes, nodes_capacity * sizeof(*nodes));
+        if (!nodes) {
+            fprintf(stderr, "Error: out of memory\n");
+            exit(1);
+        }
+    }
+    /* A child is always added after its parent; the final pass relies on it */
+    nodes[num_nodes++] = n;
+    pthread_mutex_unlock(&nodes_lock);
+    return n;
+}
+
+static void push_work(char *path, int depth, struct node *acct) {
+    struct work *w = xmalloc(sizeof(*w));
+    w->path = path;
+    w->depth = depth;
+    w->acct = acct;
+    pthread_mutex_lock(&queue_lock);
+    w->next = queue_head;
+    queue_head = w;
+    pending++;
+    pthread_cond_signal(&queue_cond);
+    pthread_mutex_unlock(&queue_lock);
+}
+
+static void scan_dir(struct work *w, char *buf) {
+    int fd = open(w->path, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC | O_NOATIME);
+    if (fd < 0 && errno == EPERM)
+        fd = open(w->path, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    if (fd < 0) {
+        __atomic_add_fetch(&error_count, 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    uint64_t own = 0;
+    for (;;) {
+        long n = syscall(SYS_getdents64, fd, buf, DENTS_BUF_SIZE);
+        if (n < 0) {
+            __atomic_add_fetch(&error_count, 1, __ATOMIC_RELAXED);
+            break;
+        }
+        if (n == 0)
+            break;
+        for (long pos = 0; pos < n;) {
+            struct linux_dirent64 *d = (struct linux_dirent64 *)(buf + pos);
+            pos += d->d_reclen;
+            const char *name = d->d_name;
+            if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+                continue;
+
+            struct statx stx;
+            if (statx(fd, name, AT_SYMLINK_NOFOLLOW | AT_NO_AUTOMOUNT,
+                      STATX_TYPE | STATX_INO | STATX_NLINK | STATX_BLOCKS, &stx) != 0) {
+                __atomic_add_fetch(&error_count, 1, __ATOMIC_RELAXED);
+                continue;
+            }
+            uint64_t bytes = (uint64_t)stx.stx_blocks * 512;
+
+            if (S_ISDIR(stx.stx_mode)) {
+                if (one_filesystem && dev_of(&stx) != root_dev)
+                    continue;
+                char *child = join_path(w->path, name);
+                if (is_excluded(child)) {
+                    free(child);
+                    continue;
+                }
+                struct node *acct = w->acct;
+                if (w->depth + 1 <= max_depth) {
+                    acct = add_node(strdup(child), w->depth + 1, w->acct);
+                    __atomic_add_fetch(&acct->own, bytes, __ATOMIC_RELAXED);
+                } else {
+                    own += bytes;
+                }
+                push_work(child, w->depth + 1, acct);
+            } else {
+                if (stx.stx_nlink > 1) {
+                    __atomic_add_fetch(&hardlink_count, 1, __ATOMIC_RELAXED);
+                    if (!first_sighting(dev_of(&stx), stx.stx_ino))
+                        continue;
+                }
+                own += bytes;
+            }
+        }
+    }
+    close(fd);
+    __atomic_add_fetch(&w->acct->own, own, __ATOMIC_RELAXED);
+}
+
+static void *worker(void *arg) {
+    char *buf = xmalloc(DENTS_BUF_SIZE);
+    (void)arg;
+    for (;;) {
+        pthread_mutex_lock(&queue_lock);
+        while (!queue_head && pending > 0)
+            pthread_cond_wait(&queue_cond, &queue_lock);
+        struct work *w = queue_head;
+        if (!w) {
+            pthread_mutex_unlock(&queue_lock);
+            break;
+        }
+        queue_head = w->next;
+        pthread_mutex_unlock(&queue_lock);
+
+        scan_dir(w, buf);
+        free(w->path);
+        free(w);
+
+        pthread_mutex_lock(&queue_lock);
+        if (--pending == 0)
+            pthread_cond_broadcast(&queue_cond);
+        pthread_mutex_unlock(&queue_lock);
+    }
+    free(buf);
+    return NULL;
+}
+
+static void print_usage(const char *prog_name) {
+    printf("Usage: %s [OPTIONS] PATH\n", prog_name);
+    printf("Options:\n");
+    printf("  -d, --max-depth N       Report directories up to N levels below PATH (default: 1)\n");
+    printf("  -x, --one-file-system   Skip directories on other filesystems\n");
+    printf("  -e, --exclude DIR       Skip DIR (absolute path; may be repeated)\n");
+    printf("  -j, --threads N         Scanner threads (default: online CPUs, max 64)\n");
+    printf("  -h, --help              Show this help message\n");
+}
+
+int main(int argc, char *argv[]) {
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+
+    static struct option long_options[] = {
+        {"max-depth", required_argument, 0, 'd'},
+        {"one-file-system", no_argument, 0, 'x'},
+        {"exclude", required_argument, 0, 'e'},
+        {"threads", required_argument, 0, 'j'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0}
+    };
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "d:xe:j:h", long_options, NULL)) != -1) {
+        switch (opt) {
+            case 'd':
+                max_depth = atoi(optarg);
+                break;
+            case 'x':
+                one_filesystem = 1;
+                break;
+            case 'e':
+                if (num_excludes == MAX_EXCLUDES) {
+                    fprintf(stderr, "Error: at most %d excludes\n", MAX_EXCLUDES);
+                    return 2;
+                }
+                excludes[num_excludes++] = optarg;
+                break;
+            case 'j':
+                threads = atol(optarg);
+                break;
+            case 'h':
+                print_usage(argv[0]);
+                return 0;
+            default:
+                print_usage(argv[0]);
+                return 2;
+        }
+    }
+    if (optind != argc - 1 || max_depth < 0) {
+        print_usage(argv[0]);
+        return 2;
+    }
+    if (threads < 1)
+        threads = 1;
+    if (threads > 64)
+        threads = 64;
+
+    const char *root = argv[optind];
+    struct statx stx;
+    if (statx(AT_FDCWD, root, AT_SYMLINK_NOFOLLOW, STATX_TYPE | STATX_BLOCKS, &stx) != 0) {
+        fprintf(stderr, "Error: cannot stat %s: %s\n", root, strerror(errno));
+        return 1;
+    }
+    if (!S_ISDIR(stx.stx_mode)) {
+        fprintf(stderr, "Error: %s is not a directory\n", root);
+        return 1;
+    }
+    root_dev = dev_of(&stx);
+    for (int i = 0; i < INODE_STRIPES; i++)
+        pthread_mutex_init(&inode_sets[i].lock, NULL);
+
+    struct node *root_node = add_node(strdup(root), 0, NULL);
+    root_node->own = (uint64_t)stx.stx_blocks * 512;
+    push_work(strdup(root), 0, root_node);
+
+    pthread_t *tids = xmalloc(threads * sizeof(*tids));
+    for (long i = 0; i < threads; i++) {
+        if (pthread_create(&tids[i], NULL, worker, NULL) != 0) {
+            fprintf(stderr, "Error: cannot start thread: %s\n", strerror(errno));
+            return 1;
+        }
+    }
+    for (long i = 0; i < threads; i++)
+        pthread_join(tids[i], NULL);
+
+    /* Children come after their parents, so one reverse pass sums every subtree */
+    for (size_t i = num_nodes; i-- > 0;) {
+        struct node *n = nodes[i];
+        n->total += n->own;
+        if (n->parent)
+            n->parent->total += n->total;
+    }
+    for (size_t i = 0; i < num_nodes; i++) {
+        printf("%llu\t%d\t%s", (unsigned long long)nodes[i]->total, nodes[i]->depth, nodes[i]->path);
+        putchar('\0');
+    }
+    fflush(stdout);
+    fprintf(stderr, "errors=%llu\n", (unsigned long long)error_count);
+    fprintf(stderr, "hardlinks=%llu\n", (unsigned long long)hardlink_count);
+    return 0;
+}
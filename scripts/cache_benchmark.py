@@ -0,0 +1,199 @@
+"""Benchmark the model cache against a local fake validator and hub.
+
+Starts ``cache_fake_upstream`` in-process, points a CacheManager at it with a
+scratch cache directory, and grows the number of cached chutes step by step
+(``--chutes 1,4,16``).  At every step it reports:
+
+* download MB/s - bytes served by the fake hub while the new chutes download
+  (verification after the transfer included),
+* verify MB/s - full content hashing of the new chutes, manifests bypassed,
+* reconcile time - a fresh CacheManager loading and reconciling every cached
+  chute, as on system-manager startup,
+* overview latency - the ``GET /cache/overview`` handler, p50/p95/max.
+
+Any CACHE_* setting can be overridden through the environment as usual, e.g.
+``CACHE_DOWNLOAD_CONNECTIONS=32 python scripts/cache_benchmark.py --chutes 1,8``.
+"""
+
+import argparse
+import asyncio
+import json
+import os
+import shutil
+import statistics
+import sys
+import tempfile
+import time
+import uuid
+from pathlib import Path
+
+from aiohttp import web
+
+from cache_fake_upstream import add_arguments, from_args
+
+MB = 1024 * 1024
+
+
+def _chute_id(index: int) -> str:
+    return str(uuid.UUID(int=index + 1))
+
+
+async def _wait(predicate, timeout: float) -> None:
+    deadline = time.monotonic() + timeout
+    while not await predicate():
+        if time.monotonic() > deadline:
+            raise TimeoutError("benchmark step timed out")
+        await asyncio.sleep(0.05)
+
+
+async def _download(mgr, upstream, indices: range, timeout: float) -> dict:
+    from sek8s.system_manager.cache.models import CacheChuteStatusEnum
+
+    sent, started = upstream.bytes_sent, time.monotonic()
+    chutes = []
+    for index in indices:
+        chute = await mgr.get_or_create(_chute_id(index))
+        repo = upstream.repo_for_chute(chute.chute_id)
+        await mgr.start_download(chute, repo.repo_id, repo.revision)
+        chutes.append(chute)
+
+    async def done() -> bool:
+        return not any(c.is_in_progress for c in chutes)
+
+    await _wait(done, timeout)
+    elapsed = time.monotonic() - started
+    fetched = upstream.bytes_sent - sent
+    failed = [c.chute_id for c in chutes if c.status != CacheChuteStatusEnum.PRESENT]
+    return {
+        "seconds": round(elapsed, 3),
+        "bytes_fetched": fetched,
+        "mb_per_s": round(fetched / MB / elapsed, 1) if elapsed > 0 else None,
+        "failed": failed,
+    }
+
+
+async def _verify(upstream, indices: range) -> dict:
+    from sek8s.system_manager.cache.util import verify_cache
+
+    cache_base = Path(os.environ["HF_CACHE_BASE"])
+    hashed, started = 0, time.monotonic()
+    for index in indices:
+        chute_id = _chute_id(index)
+        repo = upstream.repo_for_chute(chute_id)
+        await verify_cache(
+            repo.repo_id, repo.revision, str(cache_base / chute_id), verify_content=True, use_manifest=False
+        )
+        hashed += repo.total_size
+    elapsed = time.monotonic() - started
+    return {"seconds": round(elapsed, 3), "mb_per_s": round(hashed / MB / elapsed, 1) if elapsed > 0 else None}
+
+
+async def _reconcile(timeout: float) -> dict:
+    from sek8s.system_manager.cache.manager import CacheManager
+
+    mgr = CacheManager()
+    started = time.monotonic()
+    try:
+        await mgr.initialize()
+        loaded = time.monotonic() - started
+
+        async def reconciled() -> bool:
+            return not any(c.needs_reconciliation for c in await mgr.all())
+
+        await _wait(reconciled, timeout)
+        return {"seconds": round(time.monotonic() - started, 3), "initialize_seconds": round(loaded, 3)}
+    finally:
+        await mgr.shutdown()
+
+
+async def _overview(mgr, samples: int) -> dict:
+    from sek8s.system_manager.cache.router import overview
+
+    latencies = []
+    for _ in range(samples):
+        started = time.monotonic()
+        await overview(mgr=mgr, _auth=True)
+        latencies.append((time.monotonic() - started) * 1000)
+    latencies.sort()
+    return {
+        "p50_ms": round(statistics.median(latencies), 2),
+        "p95_ms": round(latencies[min(len(latencies) - 1, int(len(latencies) * 0.95))], 2),
+        "max_ms": round(latencies[-1], 2),
+    }
+
+
+async def run(args: argparse.Namespace) -> list[dict]:
+    counts = sorted({int(n) for n in args.chutes.split(",")})
+    if args.repos <= 0:
+        args.repos = counts[-1]
+    upstream = from_args(args)
+    runner = web.AppRunner(upstream.make_app())
+    await runner.setup()
+    site = web.TCPSite(runner, "127.0.0.1", 0)
+    await site.start()
+    base_url = f"http://127.0.0.1:{runner.addresses[0][1]}"
+
+    workdir = Path(args.workdir or tempfile.mkdtemp(prefix="cache-bench-"))
+    cache_base = workdir / "cache"
+    cache_base.mkdir(parents=True, exist_ok=True)
+    # Settings are read when sek8s.config is first imported, so set them before any import below
+    os.environ["VALIDATOR_BASE_URL"] = base_url
+    os.environ["HF_ENDPOINT"] = base_url
+    os.environ["HF_CACHE_BASE"] = str(cache_base)
+    os.environ.setdefault("CACHE_EVICTION_ENABLED", "false")
+
+    from sek8s.system_manager.cache import util as cache_util
+    from sek8s.system_manager.cache.manager import CacheManager
+
+    # The fake validator does not check signatures, so no miner keys are needed
+    cache_util.sign_request = lambda **_: ({}, None)
+
+    results = []
+    mgr = CacheManager()
+    await mgr.initialize()
+    try:
+        cached = 0
+        for count in counts:
+            step = {"chutes": count}
+            step["download"] = await _download(mgr, upstream, range(cached, count), args.timeout)
+            step["verify"] = await _verify(upstream, range(cached, count))
+            step["reconcile"] = await _reconcile(args.timeout)
+            step["overview"] = await _overview(mgr, args.overview_samples)
+            cached = count
+            results.append(step)
+            print(
+                f"chutes={count:<5} download={step['download']['mb_per_s']} MB/s"
+                f" verify={step['verify']['mb_per_s']} MB/s"
+                f" reconcile={step['reconcile']['seconds']}s"
+                f" overview p50={step['overview']['p50_ms']}ms p95={step['overview']['p95_ms']}ms"
+                + (f" failed={len(step['download']['failed'])}" if step["download"]["failed"] else ""),
+                flush=True,
+            )
+    finally:
+        await mgr.shutdown()
+        await runner.cleanup()
+        if not args.keep and not args.workdir:
+            shutil.rmtree(workdir, ignore_errors=True)
+    return results
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--chutes", default="1,4,16", help="Comma-separated numbers of cached chutes to measure at")
+    parser.add_argument("--overview-samples", type=int, default=50, help="Overview calls per step")
+    parser.add_argument("--timeout", type=float, default=3600, help="Seconds allowed per download/reconcile step")
+    parser.add_argument("--workdir", help="Cache directory to use (kept afterwards); a temp dir by default")
+    parser.add_argument("--keep", action="store_true", help="Keep the temporary cache directory")
+    parser.add_argument("--json", dest="json_out", help="Also write the results to this file")
+    add_arguments(parser)
+    parser.set_defaults(repos=0, file_size_mb=16)  # one repo per chute unless --repos is given
+    args = parser.parse_args()
+
+    results = asyncio.run(run(args))
+    if args.json_out:
+        Path(args.json_out).write_text(json.dumps(results, indent=2))
+        print(f"Wrote {args.json_out}", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,273 @@
+"""Local stand-in for the validator and the Hugging Face hub, for cache benchmarks.
+
+Serves synthetic repos the cache manager can download and verify without
+network access or credentials:
+
+* ``GET /chutes/{chute_id}/hf_info`` - repo and revision of a chute (chutes are
+  spread over the repos by their UUID).
+* ``GET /misc/hf_repo_info`` - file list with sizes and digests.
+* ``GET|HEAD /{org}/{name}/resolve/{revision}/{path}`` - file contents, with
+  single-range requests answered by 206 unless range support is turned off.
+
+File contents are generated on the fly from a seeded block, so repos of any
+size cost no disk space on the server side; digests are computed once at
+startup.  Every request can be delayed, and file requests can fail with a 503
+or be cut off mid-body at configurable rates.
+
+Run standalone and point the system manager at it::
+
+    python scripts/cache_fake_upstream.py --repos 4 --files 8 --file-size-mb 256
+    VALIDATOR_BASE_URL=http://127.0.0.1:8765 HF_ENDPOINT=http://127.0.0.1:8765 ...
+"""
+
+import argparse
+import asyncio
+import hashlib
+import json
+import random
+import re
+import uuid
+from dataclasses import dataclass, field
+from functools import cached_property
+from typing import Optional
+
+from aiohttp import web
+
+BLOCK_SIZE = 1024 * 1024
+_RANGE = re.compile(r"bytes=(\d*)-(\d*)$")
+
+
+@dataclass
+class FaultConfig:
+    """Latency and failure injection (rates are per file request, 0..1)."""
+
+    latency: float = 0.0  # seconds added to every request
+    error_rate: float = 0.0  # answer 503 before sending anything
+    truncate_rate: float = 0.0  # drop the connection halfway through the body
+    range_support: bool = True  # answer Range requests with 206 (else the whole file with 200)
+    seed: int = 0
+
+
+@dataclass
+class SyntheticFile:
+    """One file of a synthetic repo; content is a rotation of the shared random block."""
+
+    path: str
+    size: int
+    ring: bytes  # the random block twice over, shared by all files
+    is_lfs: bool = True
+    salt: str = ""  # makes equal-sized files of different repos differ
+    digest: Optional[str] = None
+
+    @cached_property
+    def _rotation(self) -> int:
+        key = hashlib.sha256(f"{self.salt}/{self.path}".encode()).digest()
+        return int.from_bytes(key[:4], "big") % (len(self.ring) // 2)
+
+    def read(self, offset: int, length: int) -> bytes:
+        """``length`` bytes of content starting at ``offset`` (at most one block)."""
+        block_size = len(self.ring) // 2
+        length = max(0, min(length, self.size - offset, block_size))
+        start = (offset + self._rotation) % block_size
+        return self.ring[start:start + length]
+
+    def iter_range(self, start: int, end: int):
+        """Content of the inclusive range ``start``..``end`` in block-sized pieces."""
+        offset = start
+        while offset <= end:
+            data = self.read(offset, end - offset + 1)
+            yield data
+            offset += len(data)
+
+    def compute_digest(self) -> str:
+        """sha256 for LFS files, the git blob id for regular ones (blocking)."""
+        if self.is_lfs:
+            hasher = hashlib.sha256()
+        else:
+            hasher = hashlib.sha1(b"blob %d\0" % self.size)
+        for data in self.iter_range(0, self.size - 1):
+            hasher.update(data)
+        self.digest = hasher.hexdigest()
+        return self.digest
+
+    def manifest_entry(self) -> dict:
+        entry = {"path": self.path, "size": self.size, "is_lfs": self.is_lfs}
+        entry["sha256" if self.is_lfs else "blob_id"] = self.digest
+        return entry
+
+
+@dataclass
+class SyntheticRepo:
+    """A repo of ``num_files`` LFS shards plus a small ``config.json``."""
+
+    repo_id: str
+    num_files: int
+    file_size: int
+    ring: bytes
+    files: dict[str, SyntheticFile] = field(default_factory=dict)
+
+    def __post_init__(self) -> None:
+        self.revision = hashlib.sha1(self.repo_id.encode()).hexdigest()
+        for i in range(self.num_files):
+            path = f"model-{i + 1:05d}-of-{self.num_files:05d}.safetensors"
+            self.files[path] = SyntheticFile(path, self.file_size, self.ring, salt=self.repo_id)
+        self.files["config.json"] = SyntheticFile("config.json", 512, self.ring, is_lfs=False, salt=self.repo_id)
+
+    @property
+    def total_size(self) -> int:
+        return sum(f.size for f in self.files.values())
+
+    def repo_info(self) -> dict:
+        return {"files": [f.manifest_entry() for _, f in sorted(self.files.items())]}
+
+
+class FakeUpstream:
+    """aiohttp application serving the validator and hub endpoints for a set of synthetic repos."""
+
+    def __init__(
+        self,
+        num_repos: int = 1,
+        num_files: int = 4,
+        file_size: int = 64 * 1024 * 1024,
+        faults: Optional[FaultConfig] = None,
+    ):
+        self.faults = faults or FaultConfig()
+        block = random.Random(self.faults.seed).randbytes(BLOCK_SIZE)
+        ring = block + block
+        self.repos = [
+            SyntheticRepo(f"bench/model-{i}", num_files, file_size, ring) for i in range(max(1, num_repos))
+        ]
+        self._by_id = {repo.repo_id: repo for repo in self.repos}
+        self._rng = random.Random(self.faults.seed)
+        self.requests = 0
+        self.bytes_sent = 0
+        self.faults_injected = 0
+
+    async def prepare(self) -> None:
+        """Compute file digests (in threads; large repos take a while)."""
+        files = [f for repo in self.repos for f in repo.files.values() if f.digest is None]
+        await asyncio.gather(*(asyncio.to_thread(f.compute_digest) for f in files))
+
+    def repo_for_chute(self, chute_id: str) -> SyntheticRepo:
+        try:
+            index = uuid.UUID(chute_id).int
+        except ValueError:
+            index = int.from_bytes(hashlib.sha256(chute_id.encode()).digest()[:8], "big")
+        return self.repos[index % len(self.repos)]
+
+    def make_app(self) -> web.Application:
+        app = web.Application()
+        app.router.add_get("/chutes/{chute_id}/hf_info", self.hf_info)
+        app.router.add_get("/misc/hf_repo_info", self.hf_repo_info)
+        app.router.add_get("/{org}/{name}/resolve/{revision}/{path:.+}", self.resolve)
+        app.on_startup.append(lambda _: self.prepare())
+        return app
+
+    async def _delay(self) -> None:
+        self.requests += 1
+        if self.faults.latency > 0:
+            await asyncio.sleep(self.faults.latency)
+
+    async def hf_info(self, request: web.Request) -> web.Response:
+        await self._delay()
+        repo = self.repo_for_chute(request.match_info["chute_id"])
+        return web.json_response({"repo_id": repo.repo_id, "revision": repo.revision})
+
+    def _lookup(self, repo_id: str, revision: str) -> Optional[SyntheticRepo]:
+        repo = self._by_id.get(repo_id)
+        if repo is None or revision not in ("main", repo.revision):
+            return None
+        return repo
+
+    async def hf_repo_info(self, request: web.Request) -> web.Response:
+        await self._delay()
+        repo = self._lookup(request.query.get("repo_id", ""), request.query.get("revision", "main"))
+        if repo is None:
+            raise web.HTTPNotFound()
+        return web.json_response(repo.repo_info())
+
+    async def resolve(self, request: web.Request) -> web.StreamResponse:
+        await self._delay()
+        info = request.match_info
+        repo = self._lookup(f"{info['org']}/{info['name']}", info["revision"])
+        synthetic = repo.files.get(info["path"]) if repo is not None else None
+        if synthetic is None:
+            raise web.HTTPNotFound()
+        if self.faults.error_rate and self._rng.random() < self.faults.error_rate:
+            self.faults_injected += 1
+            raise web.HTTPServiceUnavailable(text="injected fault")
+
+        start, end = 0, synthetic.size - 1
+        response = web.StreamResponse(headers={"Accept-Ranges": "bytes" if self.faults.range_support else "none"})
+        match = _RANGE.match(request.headers.get("Range", "")) if self.faults.range_support else None
+        if match and (match.group(1) or match.group(2)):
+            if match.group(1):
+                start = int(match.group(1))
+                end = min(end, int(match.group(2))) if match.group(2) else end
+            else:
+                start = max(0, synthetic.size - int(match.group(2)))
+            if start > end:
+                raise web.HTTPRequestRangeNotSatisfiable(headers={"Content-Range": f"bytes */{synthetic.size}"})
+            response.set_status(206)
+            response.headers["Content-Range"] = f"bytes {start}-{end}/{synthetic.size}"
+        response.content_length = end - start + 1
+        response.headers["ETag"] = f'"{synthetic.digest}"'
+        await response.prepare(request)
+        if request.method == "HEAD":
+            return response
+
+        cut = None
+        if self.faults.truncate_rate and self._rng.random() < self.faults.truncate_rate:
+            self.faults_injected += 1
+            cut = start + (end - start + 1) // 2
+        for data in synthetic.iter_range(start, end if cut is None else cut):
+            await response.write(data)
+            self.bytes_sent += len(data)
+        if cut is not None:
+            if request.transport is not None:
+                request.transport.close()
+            return response
+        await response.write_eof()
+        return response
+
+
+def add_arguments(parser: argparse.ArgumentParser) -> None:
+    """Options describing the synthetic repos and injected faults (shared with the benchmark)."""
+    parser.add_argument("--repos", type=int, default=1, help="Number of synthetic repos")
+    parser.add_argument("--files", type=int, default=4, help="LFS files per repo")
+    parser.add_argument("--file-size-mb", type=float, default=64, help="Size of each LFS file")
+    parser.add_argument("--latency-ms", type=float, default=0, help="Delay added to every request")
+    parser.add_argument("--error-rate", type=float, default=0, help="Fraction of file requests answered 503")
+    parser.add_argument("--truncate-rate", type=float, default=0, help="Fraction of file requests cut off")
+    parser.add_argument("--no-range", action="store_true", help="Ignore Range headers (always send whole files)")
+    parser.add_argument("--seed", type=int, default=0)
+
+
+def from_args(args: argparse.Namespace) -> FakeUpstream:
+    return FakeUpstream(
+        num_repos=args.repos,
+        num_files=args.files,
+        file_size=int(args.file_size_mb * 1024 * 1024),
+        faults=FaultConfig(
+            latency=args.latency_ms / 1000,
+            error_rate=args.error_rate,
+            truncate_rate=args.truncate_rate,
+            range_support=not args.no_range,
+            seed=args.seed,
+        ),
+    )
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=8765)
+    add_arguments(parser)
+    args = parser.parse_args()
+    upstream = from_args(args)
+    print(json.dumps({r.repo_id: {"revision": r.revision, "size": r.total_size} for r in upstream.repos}, indent=2))
+    web.run_app(upstream.make_app(), host=args.host, port=args.port)
+
+
+if __name__ == "__main__":
+    main()
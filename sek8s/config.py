@@ -151,6 +151,55 @@ class SystemStatusConfig(AuthConfig):
         ge=1,
         le=7 * 24 * 60,
     )
+    log_stream_buffer_lines: int = Field(
+        default=2000,
+        alias="LOG_STREAM_BUFFER_LINES",
+        ge=100,
+        le=100_000,
+        description="Lines a log stream client may fall behind before it is dropped",
+    )
+    systemd_dbus_enabled: bool = Field(
+        default=True,
+        alias="SYSTEMD_DBUS_ENABLED",
+        description="Track unit state over the systemd D-Bus API (falls back to systemctl when unavailable)",
+    )
+    overview_max_wait_seconds: float = Field(
+        default=2.0,
+        alias="OVERVIEW_MAX_WAIT_SECONDS",
+        ge=0.0,
+        le=30.0,
+        description="Longest the overview waits for sources that have not been collected yet",
+    )
+    gpu_telemetry_enabled: bool = Field(
+        default=True,
+        alias="GPU_TELEMETRY_ENABLED",
+        description="Sample GPU telemetry from NVML in the background",
+    )
+    gpu_telemetry_interval_seconds: float = Field(
+        default=1.0,
+        alias="GPU_TELEMETRY_INTERVAL_SECONDS",
+        ge=0.1,
+        le=60.0,
+    )
+    disk_scan_threads: int = Field(default=8, alias="DISK_SCAN_THREADS", ge=1, le=64)
+    disk_usage_refresh_seconds: float = Field(
+        default=600.0,
+        alias="DISK_USAGE_REFRESH_SECONDS",
+        ge=30.0,
+        description="Full rescan interval of in-memory disk usage trees",
+    )
+    disk_usage_idle_seconds: float = Field(
+        default=3600.0,
+        alias="DISK_USAGE_IDLE_SECONDS",
+        ge=60.0,
+        description="Drop a disk usage tree not requested for this long",
+    )
+    disk_usage_max_watches: int = Field(
+        default=4096,
+        alias="DISK_USAGE_MAX_WATCHES",
+        ge=0,
+        description="inotify watches for change-driven subtree refresh (0 = schedule only)",
+    )
 
     model_config = SettingsConfigDict(
         env_file_encoding="utf-8",
@@ -188,6 +237,176 @@ class CacheConfig(AuthConfig):
         alias="VALIDATOR_BASE_URL",
         description="Base URL for validator API (e.g. GET /chutes/{chute_id}/hf_info, GET /misc/hf_repo_info)",
     )
+    verify_content: bool = Field(
+        default=True,
+        alias="CACHE_VERIFY_CONTENT",
+        description="Hash cached file contents against the validator manifest (not just sizes/blob names)",
+    )
+    verify_workers: int = Field(
+        default=8, alias="CACHE_VERIFY_WORKERS", ge=1, le=64, description="Parallel hashing threads"
+    )
+    verify_read_size_mb: int = Field(
+        default=16, alias="CACHE_VERIFY_READ_SIZE_MB", ge=1, le=256, description="Read size per hashing I/O"
+    )
+    verify_direct_io: bool = Field(
+        default=True,
+        alias="CACHE_VERIFY_DIRECT_IO",
+        description="Hash with O_DIRECT reads so verification does not evict the page cache",
+    )
+    hf_endpoint: str = Field(
+        default="https://huggingface.co",
+        alias="HF_ENDPOINT",
+        description="Hugging Face endpoint model files are downloaded from",
+    )
+    download_engine_enabled: bool = Field(
+        default=True,
+        alias="CACHE_DOWNLOAD_ENGINE_ENABLED",
+        description="Use the parallel ranged-chunk downloader (falls back to snapshot_download when off)",
+    )
+    download_connections: int = Field(
+        default=16, alias="CACHE_DOWNLOAD_CONNECTIONS", ge=1, le=128, description="Concurrent range requests"
+    )
+    download_chunk_size_mb: int = Field(
+        default=64, alias="CACHE_DOWNLOAD_CHUNK_SIZE_MB", ge=1, le=1024, description="Range request size"
+    )
+    download_retries: int = Field(
+        default=5, alias="CACHE_DOWNLOAD_RETRIES", ge=1, le=20, description="Attempts per chunk before failing"
+    )
+    repair_enabled: bool = Field(
+        default=True,
+        alias="CACHE_REPAIR_ENABLED",
+        description="Record Merkle leaves of verified blobs and re-fetch only damaged ranges on mismatch",
+    )
+    merkle_leaf_size_mb: int = Field(
+        default=64, alias="CACHE_MERKLE_LEAF_SIZE_MB", ge=1, le=1024, description="Merkle leaf (repair unit) size"
+    )
+    peer_urls: str = Field(
+        default="",
+        alias="CACHE_PEERS",
+        description="Comma-separated system-manager base URLs of fleet nodes to fetch verified blobs from first",
+    )
+    peer_timeout: float = Field(
+        default=10.0, alias="CACHE_PEER_TIMEOUT", gt=0, description="Connect/read timeout for peer requests (s)"
+    )
+    download_max_concurrent: int = Field(
+        default=2, alias="CACHE_DOWNLOAD_MAX_CONCURRENT", ge=1, le=32, description="Downloads running at once"
+    )
+    download_max_bandwidth_mbps: float = Field(
+        default=0.0,
+        alias="CACHE_DOWNLOAD_MAX_BANDWIDTH_MBPS",
+        ge=0,
+        description=(
+            "Bandwidth cap shared by all downloads in Mbit/s, split by priority weight; 0 = unlimited. "
+            "Applies to the chunked download engine only: snapshot_download fallbacks are not throttled"
+        ),
+    )
+    download_preemption: bool = Field(
+        default=True,
+        alias="CACHE_DOWNLOAD_PREEMPTION",
+        description="Let higher-priority downloads preempt (and requeue) resumable lower-priority ones",
+    )
+    blob_store_enabled: bool = Field(
+        default=True,
+        alias="CACHE_BLOB_STORE_ENABLED",
+        description="Share verified blobs across chute cache dirs via hardlinks into {cache_base}/.blobs",
+    )
+    reconcile_concurrency: int = Field(
+        default=4, alias="CACHE_RECONCILE_CONCURRENCY", ge=1, le=64, description="Chutes reconciled at once"
+    )
+    reconcile_timeout: float = Field(
+        default=900.0,
+        alias="CACHE_RECONCILE_TIMEOUT",
+        gt=0,
+        description="Seconds one chute's reconciliation may take before it is deferred to the next sync",
+    )
+    space_reservation_enabled: bool = Field(
+        default=True,
+        alias="CACHE_SPACE_RESERVATION_ENABLED",
+        description="Reserve disk space for a download before starting it; reject it (507) if it cannot fit",
+    )
+    space_headroom_gb: float = Field(
+        default=1.0,
+        alias="CACHE_SPACE_HEADROOM_GB",
+        ge=0,
+        description="Free space on the cache filesystem that download reservations never claim",
+    )
+    eviction_enabled: bool = Field(
+        default=True,
+        alias="CACHE_EVICTION_ENABLED",
+        description="Evict cold entries in the background when the cache filesystem passes the high watermark",
+    )
+    eviction_high_watermark: float = Field(
+        default=0.90,
+        alias="CACHE_EVICTION_HIGH_WATERMARK",
+        gt=0,
+        le=1,
+        description="Fraction of the cache filesystem in use that starts eviction",
+    )
+    eviction_low_watermark: float = Field(
+        default=0.80,
+        alias="CACHE_EVICTION_LOW_WATERMARK",
+        gt=0,
+        le=1,
+        description="Fraction of the cache filesystem in use that eviction brings usage back down to",
+    )
+    eviction_interval: float = Field(
+        default=60.0, alias="CACHE_EVICTION_INTERVAL", gt=0, description="Seconds between disk usage checks"
+    )
+    eviction_min_idle_seconds: float = Field(
+        default=3600.0,
+        alias="CACHE_EVICTION_MIN_IDLE_SECONDS",
+        ge=0,
+        description="Entries accessed more recently than this are never evicted",
+    )
+    eviction_access_half_life_hours: float = Field(
+        default=72.0,
+        alias="CACHE_EVICTION_ACCESS_HALF_LIFE_HOURS",
+        gt=0,
+        description="Half-life of recorded accesses in the eviction score",
+    )
+    prewarm_workers: int = Field(
+        default=4, alias="CACHE_PREWARM_WORKERS", ge=1, le=64, description="Parallel page-cache prewarm readers"
+    )
+    prewarm_budget_gb: float = Field(
+        default=0.0,
+        alias="CACHE_PREWARM_BUDGET_GB",
+        ge=0,
+        description="Max bytes of a snapshot to pull into the page cache; 0 = half of MemAvailable",
+    )
+    prewarm_after_urgent_download: bool = Field(
+        default=True,
+        alias="CACHE_PREWARM_AFTER_URGENT_DOWNLOAD",
+        description="Prewarm the page cache when an urgent download (a pod is waiting) completes",
+    )
+    tensor_index_enabled: bool = Field(
+        default=True,
+        alias="CACHE_TENSOR_INDEX_ENABLED",
+        description="Index safetensors headers of verified snapshots (GET /cache/{chute_id}/tensors)",
+    )
+    repo_info_cache_ttl: float = Field(
+        default=3600.0,
+        alias="CACHE_REPO_INFO_TTL",
+        gt=0,
+        description="Seconds a validator repo manifest (/misc/hf_repo_info) stays cached",
+    )
+    repo_info_cache_max_entries: int = Field(
+        default=256, alias="CACHE_REPO_INFO_MAX_ENTRIES", ge=1, description="Repo manifests kept in memory"
+    )
+    repo_info_cache_max_mb: int = Field(
+        default=64, alias="CACHE_REPO_INFO_MAX_MB", ge=1, description="Memory bound of the repo manifest cache"
+    )
+    events_interval: float = Field(
+        default=1.0,
+        alias="CACHE_EVENTS_INTERVAL",
+        gt=0,
+        description="Seconds between status samples pushed to /cache/events subscribers",
+    )
+    validator_max_connections: int = Field(
+        default=32,
+        alias="CACHE_VALIDATOR_MAX_CONNECTIONS",
+        ge=1,
+        description="Connection pool size of the shared validator HTTP session",
+    )
 
     model_config = SettingsConfigDict(
         env_file_encoding="utf-8",
@@ -263,6 +482,9 @@ class AdmissionConfig(ServerConfig):
     # Metrics configuration
     metrics_enabled: bool = Field(default=True, alias="METRICS_ENABLED")
 
+    # Mutating webhook: pin tag-based pod images to the digest verified during validation
+    digest_pinning_enabled: bool = Field(default=True, alias="DIGEST_PINNING_ENABLED")
+
     # Chutes namespace: path to cosign public key used to enforce signed images in chutes namespace
     chutes_cosign_public_key_path: Optional[Path] = Field(
         default=Path("/etc/admission-controller/cosign/cosign.pub"),
@@ -391,6 +613,9 @@ class CosignConfig(BaseSettings):
     # Admission-level result cache: same pod/spec re-admissions reuse result to avoid registry rate limits
     admission_result_cache_ttl: int = Field(default=600, ge=0)  # 10 minutes
     admission_result_cache_maxsize: int = Field(default=2048, ge=1)
+    # Verified tag -> digest resolutions shared with the digest-pinning mutating webhook
+    digest_cache_ttl: int = Field(default=3600, ge=0)
+    digest_cache_maxsize: int = Field(default=2048, ge=1)
 
     # Cosign config
     oidc_identity_regex: str = Field(default="^https://github.com/your-org/.*")
@@ -5,17 +5,19 @@ Phase 4a - Basic Python + OPA
 """
 
 import asyncio
+import base64
 import json
 import logging
 import time
-from typing import Dict, List
+from typing import Dict, List, Union
 
+import orjson
 from fastapi import Request
-from fastapi.responses import JSONResponse, PlainTextResponse
+from fastapi.responses import JSONResponse, ORJSONResponse, PlainTextResponse
 
 from sek8s.config import AdmissionConfig
 from sek8s.server import WebServer
-from sek8s.validators.base import ValidatorBase
+from sek8s.validators.base import AdmissionContext, ValidatorBase, pod_container_images
 from sek8s.validators.cosign import CosignValidator
 from sek8s.validators.opa import OPAValidator
 from sek8s.validators.registry import RegistryValidator
@@ -49,36 +51,44 @@ class AdmissionController:
         # Registry validator (lightweight, always enabled)
         self.validators.append(RegistryValidator(self.config))
 
-        self.validators.append(CosignValidator(self.config))
+        cosign = CosignValidator(self.config)
+        self.validators.append(cosign)
+
+        # Verified tag -> digest resolutions, shared with the mutating webhook
+        self.digest_cache = cosign.digest_cache
 
         logger.info("Initialized validators: %s", [v.__class__.__name__ for v in self.validators])
 
-    async def validate_admission(self, admission_review: Dict) -> Dict:
+    async def validate_admission(self, admission_review: Union[Dict, AdmissionContext]) -> Dict:
         """
         Main validation entry point.
 
         Args:
-            admission_review: Kubernetes admission review request
+            admission_review: Kubernetes admission review request, or a context
+                already built from the raw request body
 
         Returns:
             Admission review response
         """
         start_time = time.time()
-        request = admission_review.get("request", {})
-        uid = request.get("uid", "unknown")
+        if isinstance(admission_review, AdmissionContext):
+            ctx = admission_review
+        else:
+            ctx = AdmissionContext.from_review(admission_review, self.config)
+        uid = ctx.uid
+        kind = ctx.kind or "unknown"
+        operation = ctx.operation or "unknown"
 
         logger.debug(
             "Processing admission request: uid=%s, kind=%s, operation=%s",
             uid,
-            request.get("kind", {}).get("kind", "unknown"),
-            request.get("operation", "unknown"),
+            kind,
+            operation,
         )
 
         try:
-            # Run validators in parallel
-            validation_tasks = [
-                validator.validate(admission_review) for validator in self.validators
-            ]
+            # Run validators in parallel; they all share the single parsed context
+            validation_tasks = [validator.validate(ctx) for validator in self.validators]
 
             results = await asyncio.gather(*validation_tasks, return_exceptions=True)
 
@@ -121,8 +131,8 @@ class AdmissionController:
             elapsed = time.time() - start_time
             self.metrics.record_admission_decision(
                 allowed=allowed,
-                resource_kind=request.get("kind", {}).get("kind", "unknown"),
-                operation=request.get("operation", "unknown"),
+                resource_kind=kind,
+                operation=operation,
                 duration=elapsed,
             )
 
@@ -140,6 +150,33 @@ class AdmissionController:
                 uid=uid, allowed=False, messages=[f"Internal error: {str(e)}"], warnings=[]
             )
 
+    def mutate_admission(self, ctx: AdmissionContext) -> Dict:
+        """
+        Mutation entry point: pin tag-based Pod images to their verified digests.
+
+        Only images whose digest was resolved and verified by a previous validation
+        (e.g. of the owning Deployment) are rewritten; everything else is left as-is
+        and still goes through full validation. Never denies.
+        """
+        patch = []
+        if (
+            self.config.digest_pinning_enabled
+            and ctx.kind == "Pod"
+            and ctx.operation == "CREATE"
+            and not ctx.exempt
+        ):
+            for path, image in pod_container_images(ctx.object):
+                pinned = self.digest_cache.get(image)
+                if pinned and pinned != image:
+                    patch.append({"op": "replace", "path": path, "value": pinned})
+
+        response = self._build_response(uid=ctx.uid, allowed=True, messages=[], warnings=[])
+        if patch:
+            logger.debug("Pinning %d image(s) to digests for %s", len(patch), ctx.uid)
+            response["response"]["patchType"] = "JSONPatch"
+            response["response"]["patch"] = base64.b64encode(orjson.dumps(patch)).decode()
+        return response
+
     def _build_response(
         self, uid: str, allowed: bool, messages: List[str], warnings: List[str]
     ) -> Dict:
@@ -197,20 +234,15 @@ class AdmissionWebhookServer(WebServer):
 
     async def handle_validate(self, request: Request) -> JSONResponse:
         """Handle validation webhook requests."""
+        ctx = None
         try:
-            admission_review = await request.json()
-
-            # Validate request structure
-            if not admission_review.get("request"):
-                return JSONResponse(
-                    content={"error": "Invalid admission review: missing request"}, 
-                    status_code=400
-                )
+            # Parse the body once; validators and OPA all work from this context
+            ctx = AdmissionContext.from_bytes(await request.body(), self.controller.config)
 
             # Process admission
-            response = await self.controller.validate_admission(admission_review)
+            response = await self.controller.validate_admission(ctx)
 
-            return JSONResponse(content=response)
+            return ORJSONResponse(content=response)
 
         except json.JSONDecodeError as e:
             logger.error("Invalid JSON in request: %s", e)
@@ -218,36 +250,34 @@ class AdmissionWebhookServer(WebServer):
                 content={"error": "Invalid JSON"}, 
                 status_code=400
             )
+        except ValueError as e:
+            # Validate request structure
+            if ctx is None:
+                return JSONResponse(content={"error": str(e)}, status_code=400)
+            return self._internal_error_response(ctx.uid, e)
         except Exception as e:
-            logger.exception("Error handling validation request")
-
-            # Return a valid admission response that denies the request
-            return JSONResponse(
-                content={
-                    "apiVersion": "admission.k8s.io/v1",
-                    "kind": "AdmissionReview",
-                    "response": {
-                        "uid": admission_review.get("request", {}).get("uid", "unknown"),
-                        "allowed": False,
-                        "status": {"message": f"Internal server error: {str(e)}"},
-                    },
-                }
-            )
+            return self._internal_error_response(ctx.uid if ctx else "unknown", e)
+
+    def _internal_error_response(self, uid: str, error: Exception) -> JSONResponse:
+        """Return a valid admission response that denies the request."""
+        logger.exception("Error handling validation request")
+        return JSONResponse(
+            content={
+                "apiVersion": "admission.k8s.io/v1",
+                "kind": "AdmissionReview",
+                "response": {
+                    "uid": uid,
+                    "allowed": False,
+                    "status": {"message": f"Internal server error: {str(error)}"},
+                },
+            }
+        )
 
     async def handle_mutate(self, request: Request) -> JSONResponse:
-        """Handle mutation webhook requests (placeholder for future)."""
+        """Handle mutation webhook requests (digest pinning of pod images)."""
         try:
-            request_data = await request.json()
-            return JSONResponse(
-                content={
-                    "apiVersion": "admission.k8s.io/v1",
-                    "kind": "AdmissionReview",
-                    "response": {
-                        "uid": request_data.get("request", {}).get("uid", "unknown"),
-                        "allowed": True,
-                    },
-                }
-            )
+            ctx = AdmissionContext.from_bytes(await request.body(), self.controller.config)
+            return ORJSONResponse(content=self.controller.mutate_admission(ctx))
         except Exception as e:
             logger.exception("Error handling mutation request")
             return JSONResponse(
@@ -9,7 +9,13 @@ from sek8s.config import SystemManagerConfig
 from sek8s.server import WebServer
 from sek8s.system_manager.cache.manager import CacheManager
 from sek8s.system_manager.cache.router import router as cache_router
+from sek8s.system_manager.status.collectors import build_overview_collector
+from sek8s.system_manager.status.disk_usage import DiskUsageModel
+from sek8s.system_manager.status.follow import JournalFollowerHub
+from sek8s.system_manager.status.gpu_telemetry import GpuTelemetry
+from sek8s.system_manager.status.router import get_config as get_status_config
 from sek8s.system_manager.status.router import router as status_router
+from sek8s.system_manager.status.units import UnitStateTracker
 
 
 @asynccontextmanager
@@ -22,7 +28,35 @@ async def lifespan(app: FastAPI):
     except Exception as e:
         logger.error("Cache manager initialization failed (non-fatal): {}", e)
     app.state.cache_manager = cache_mgr
+    status_config = get_status_config()
+    disk_usage = DiskUsageModel(status_config)
+    await disk_usage.start()
+    app.state.disk_usage = disk_usage
+    unit_tracker = UnitStateTracker() if status_config.systemd_dbus_enabled else None
+    if unit_tracker is not None:
+        await unit_tracker.start()
+    app.state.unit_tracker = unit_tracker
+    journal_hub = JournalFollowerHub(status_config.log_stream_buffer_lines)
+    app.state.journal_hub = journal_hub
+    gpu_telemetry = (
+        GpuTelemetry(status_config.gpu_telemetry_interval_seconds)
+        if status_config.gpu_telemetry_enabled
+        else None
+    )
+    if gpu_telemetry is not None:
+        await gpu_telemetry.start()
+    app.state.gpu_telemetry = gpu_telemetry
+    overview_collector = build_overview_collector(status_config, unit_tracker, cache_mgr)
+    app.state.overview_collector = overview_collector
     yield
+    await overview_collector.stop()
+    if gpu_telemetry is not None:
+        await gpu_telemetry.stop()
+    await journal_hub.close()
+    if unit_tracker is not None:
+        await unit_tracker.stop()
+    await disk_usage.stop()
+    await cache_mgr.shutdown()
 
 
 class SystemManagerServer(WebServer):
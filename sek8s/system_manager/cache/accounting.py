@@ -0,0 +1,331 @@
+"""Cache submodule: incremental size accounting for chute cache directories.
+
+Each chute keeps a ``ChuteUsage`` tally of its HF blobs (size and atime per
+blob) so status and overview endpoints read counters instead of walking the
+hub tree.  The tally is built once by listing ``hub/models--*/blobs`` and then
+kept current by inotify events on the cache tree, which covers both our own
+downloads and models written by chute pods.  Reads do not produce events:
+``last_accessed`` is the newest blob atime as of the last (re)scan, so callers
+that need current atimes invalidate the tally first.  Download progress itself
+comes from the downloader's byte counters, not from the tally.
+
+Without inotify (or after an event queue overflow) tallies are marked dirty
+and rebuilt on the next read, at most once per ``rescan_interval``.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import ctypes
+import ctypes.util
+import os
+import struct
+import time
+from pathlib import Path
+from typing import Iterable, Optional
+
+from loguru import logger
+
+from .blobstore import blob_algorithm
+
+_REPO_PREFIX = "models--"
+
+# <sys/inotify.h>
+IN_CLOSE_WRITE = 0x00000008
+IN_MOVED_FROM = 0x00000040
+IN_MOVED_TO = 0x00000080
+IN_CREATE = 0x00000100
+IN_DELETE = 0x00000200
+IN_DELETE_SELF = 0x00000400
+IN_Q_OVERFLOW = 0x00004000
+IN_IGNORED = 0x00008000
+IN_ONLYDIR = 0x01000000
+IN_ISDIR = 0x40000000
+IN_NONBLOCK = 0o4000
+IN_CLOEXEC = 0o2000000
+
+_DIR_EVENTS = IN_CREATE | IN_MOVED_TO | IN_DELETE | IN_MOVED_FROM | IN_DELETE_SELF | IN_ONLYDIR
+_BLOB_EVENTS = _DIR_EVENTS | IN_CLOSE_WRITE
+_EVENT_HEADER = struct.Struct("iIII")
+
+
+class ChuteUsage:
+    """Blob tally of one ``{cache_base}/{chute_id}`` directory."""
+
+    def __init__(self, path: Path):
+        self.path = Path(path)
+        self.size_bytes = 0
+        self.repo_id: Optional[str] = None
+        self.revision: Optional[str] = None
+        self.last_accessed: Optional[float] = None
+        self.dirty = True
+        self.scanned_at = 0.0
+        self._blobs: dict[str, tuple[int, float]] = {}
+        self._events = 0
+
+    def rescan(self) -> None:
+        """Rebuild the tally by listing blob directories (blocking; run in a thread)."""
+        events_before = self._events
+        blobs: dict[str, tuple[int, float]] = {}
+        repo_id = revision = None
+        hub = self.path / "hub"
+        try:
+            repo_dirs = sorted(p for p in hub.iterdir() if p.name.startswith(_REPO_PREFIX))
+        except FileNotFoundError:
+            repo_dirs = []
+        for repo_dir in repo_dirs:
+            if repo_id is None:
+                repo_id = repo_dir.name[len(_REPO_PREFIX):].replace("--", "/")
+                try:
+                    revisions = sorted(p.name for p in (repo_dir / "snapshots").iterdir())
+                    revision = revisions[0] if revisions else None
+                except FileNotFoundError:
+                    pass
+            try:
+                with os.scandir(repo_dir / "blobs") as entries:
+                    for entry in entries:
+                        if blob_algorithm(entry.name) and entry.is_file(follow_symlinks=False):
+                            st = entry.stat(follow_symlinks=False)
+                            blobs[entry.path] = (st.st_size, st.st_atime)
+            except FileNotFoundError:
+                continue
+        # Swap in one step so readers on the event loop never see a half-built tally
+        self._blobs = blobs
+        self.size_bytes = sum(size for size, _ in blobs.values())
+        self.last_accessed = max((atime for _, atime in blobs.values()), default=None)
+        self.repo_id = repo_id
+        self.revision = revision
+        self.scanned_at = time.monotonic()
+        # An event applied to the old tally mid-scan may be missing from the new one
+        self.dirty = self._events != events_before
+
+    def blob_updated(self, path: str) -> None:
+        self._events += 1
+        try:
+            st = os.stat(path, follow_symlinks=False)
+        except FileNotFoundError:
+            self.blob_removed(path)
+            return
+        old_size, _ = self._blobs.get(path, (0, 0.0))
+        self._blobs[path] = (st.st_size, st.st_atime)
+        self.size_bytes += st.st_size - old_size
+        if self.last_accessed is None or st.st_atime > self.last_accessed:
+            self.last_accessed = st.st_atime
+
+    def blob_removed(self, path: str) -> None:
+        self._events += 1
+        old = self._blobs.pop(path, None)
+        if old is not None:
+            self.size_bytes -= old[0]
+
+
+class _Inotify:
+    """Minimal ctypes binding for inotify(7)."""
+
+    def __init__(self):
+        libc = ctypes.CDLL(ctypes.util.find_library("c") or None, use_errno=True)
+        self._add_watch = libc.inotify_add_watch
+        self._add_watch.argtypes = [ctypes.c_int, ctypes.c_char_p, ctypes.c_uint32]
+        self.fd = libc.inotify_init1(IN_NONBLOCK | IN_CLOEXEC)
+        if self.fd < 0:
+            err = ctypes.get_errno()
+            raise OSError(err, os.strerror(err))
+
+    def add_watch(self, path: Path, mask: int) -> int:
+        wd = self._add_watch(self.fd, os.fsencode(path), mask)
+        if wd < 0:
+            err = ctypes.get_errno()
+            raise OSError(err, os.strerror(err), str(path))
+        return wd
+
+    def read_events(self) -> list[tuple[int, int, str]]:
+        """Drain pending events as ``(wd, mask, name)``."""
+        try:
+            data = os.read(self.fd, 256 * 1024)
+        except BlockingIOError:
+            return []
+        events = []
+        offset = 0
+        while offset + _EVENT_HEADER.size <= len(data):
+            wd, mask, _cookie, length = _EVENT_HEADER.unpack_from(data, offset)
+            offset += _EVENT_HEADER.size
+            name = os.fsdecode(data[offset:offset + length].rstrip(b"\0"))
+            offset += length
+            events.append((wd, mask, name))
+        return events
+
+    def close(self) -> None:
+        os.close(self.fd)
+
+
+class UsageTracker:
+    """Owns every chute's ``ChuteUsage`` and the inotify watches that keep them current.
+
+    Watched levels: ``cache_base`` -> ``<chute>`` -> ``hub`` -> ``models--*`` -> ``blobs``.
+    A newly created directory gets a watch and marks its chute dirty, so files
+    written before the watch existed are picked up by one rescan.
+    """
+
+    def __init__(self, cache_base: Path, rescan_interval: float = 300.0):
+        self.cache_base = Path(cache_base)
+        self.rescan_interval = rescan_interval
+        self._usage: dict[str, ChuteUsage] = {}
+        self._inotify: Optional[_Inotify] = None
+        self._watches: dict[int, tuple[Path, str]] = {}
+        self._loop: Optional[asyncio.AbstractEventLoop] = None
+        self._started = False
+
+    @property
+    def watching(self) -> bool:
+        return self._inotify is not None
+
+    def start(self) -> None:
+        """Start inotify tracking on the running loop; falls back to periodic rescans."""
+        if self._started or not self.cache_base.exists():
+            return
+        self._started = True
+        try:
+            self._inotify = _Inotify()
+            self._watch(self.cache_base, "base")
+        except (OSError, AttributeError) as e:
+            logger.warning("inotify unavailable ({}); cache sizes will be rescanned periodically", e)
+            self._close_inotify()
+            return
+        for chute_id in list(self._usage):
+            self._watch_chute(chute_id)
+        self._loop = asyncio.get_running_loop()
+        self._loop.add_reader(self._inotify.fd, self._on_readable)
+        logger.info("Tracking cache usage under {} with inotify", self.cache_base)
+
+    def stop(self) -> None:
+        if self._loop is not None and self._inotify is not None:
+            self._loop.remove_reader(self._inotify.fd)
+        self._close_inotify()
+
+    def _close_inotify(self) -> None:
+        if self._inotify is not None:
+            self._inotify.close()
+        self._inotify = None
+        self._watches.clear()
+
+    def usage(self, chute_id: str) -> ChuteUsage:
+        usage = self._usage.get(chute_id)
+        if usage is None:
+            usage = self._usage[chute_id] = ChuteUsage(self.cache_base / chute_id)
+            if self._inotify is not None:
+                self._watch_chute(chute_id)
+        return usage
+
+    def forget(self, chute_id: str) -> None:
+        self._usage.pop(chute_id, None)
+
+    async def prime(self, chute_ids: Iterable[str]) -> None:
+        """Build the tallies of ``chute_ids`` so their synchronous sizes are current from the start."""
+        await asyncio.gather(*(self.read(chute_id) for chute_id in chute_ids))
+
+    async def read(self, chute_id: str) -> ChuteUsage:
+        """The chute's tally, rescanned first if dirty or (without inotify) stale."""
+        usage = self.usage(chute_id)
+        stale = not self.watching and time.monotonic() - usage.scanned_at > self.rescan_interval
+        if usage.dirty or stale:
+            await asyncio.to_thread(usage.rescan)
+        return usage
+
+    def invalidate(self, chute_id: str) -> None:
+        usage = self._usage.get(chute_id)
+        if usage is not None:
+            usage.dirty = True
+
+    # ------------------------------------------------------------------
+    # inotify plumbing
+    # ------------------------------------------------------------------
+
+    def _watch(self, path: Path, level: str) -> None:
+        mask = _BLOB_EVENTS if level == "blobs" else _DIR_EVENTS
+        try:
+            wd = self._inotify.add_watch(path, mask)
+        except FileNotFoundError:
+            return
+        except OSError as e:
+            # ENOSPC: fs.inotify.max_user_watches exhausted; rescans still keep tallies correct
+            logger.warning("Cannot watch {}: {}", path, e)
+            return
+        self._watches[wd] = (path, level)
+
+    def _watch_chute(self, chute_id: str) -> None:
+        chute_dir = self.cache_base / chute_id
+        self._watch(chute_dir, "chute")
+        hub = chute_dir / "hub"
+        self._watch(hub, "hub")
+        try:
+            repo_dirs = [p for p in hub.iterdir() if p.name.startswith(_REPO_PREFIX)]
+        except FileNotFoundError:
+            repo_dirs = []
+        for repo_dir in repo_dirs:
+            self._watch(repo_dir, "repo")
+            self._watch(repo_dir / "blobs", "blobs")
+
+    def _chute_id(self, path: Path) -> Optional[str]:
+        try:
+            return path.relative_to(self.cache_base).parts[0]
+        except (ValueError, IndexError):
+            return None
+
+    def _on_readable(self) -> None:
+        for wd, mask, name in self._inotify.read_events():
+            if mask & IN_Q_OVERFLOW:
+                logger.warning("inotify queue overflow; rescanning all cache tallies")
+                for usage in self._usage.values():
+                    usage.dirty = True
+                continue
+            watch = self._watches.get(wd)
+            if watch is None:
+                continue
+            if mask & IN_IGNORED:
+                del self._watches[wd]
+                continue
+            path, level = watch
+            self._handle(path, level, mask, name)
+
+    def _handle(self, path: Path, level: str, mask: int, name: str) -> None:
+        child = path / name
+        created = mask & (IN_CREATE | IN_MOVED_TO)
+        if level == "base":
+            # Untracked chute dirs are picked up by CacheManager.sync_from_disk
+            if mask & IN_ISDIR and created and name in self._usage:
+                self._watch_chute(name)
+                self._usage[name].dirty = True
+            return
+
+        chute_id = self._chute_id(path)
+        usage = self._usage.get(chute_id) if chute_id else None
+        if usage is None:
+            return
+        if level == "blobs":
+            if mask & IN_ISDIR or not blob_algorithm(name):
+                return
+            if created or mask & IN_CLOSE_WRITE:
+                usage.blob_updated(str(child))
+            elif mask & (IN_DELETE | IN_MOVED_FROM):
+                usage.blob_removed(str(child))
+            return
+
+        # Structural change in the chute/hub/repo levels; plain files there (markers,
+        # manifests) do not affect the tally
+        if not mask & IN_ISDIR:
+            return
+        if created:
+            next_level = {"chute": "hub", "hub": "repo", "repo": "blobs"}.get(level)
+            if next_level == "hub" and name != "hub":
+                return
+            if next_level == "repo" and not name.startswith(_REPO_PREFIX):
+                return
+            if next_level == "blobs" and name != "blobs":
+                # e.g. a new snapshots/<rev> directory: revision may have changed
+                usage.dirty = True
+                return
+            if next_level is not None:
+                self._watch(child, next_level)
+                if next_level == "repo":
+                    self._watch(child / "blobs", "blobs")
+        usage.dirty = True
@@ -0,0 +1,308 @@
+"""Cache submodule: node-wide content-addressed blob store.
+
+Verified blobs are hardlinked into ``{cache_base}/.blobs/<algorithm>/<ab>/<digest>``
+and every chute's ``hub/models--*/blobs/<digest>`` is a hardlink to the same
+inode, so chutes serving the same repo/revision share one copy on disk.
+
+The inode link count is the reference count: a store entry with
+``st_nlink == 1`` is referenced by no chute and can be collected.  Deleting a
+chute directory therefore frees only the bytes no other chute still links.
+Only content-verified blobs are adopted, so the store never hands out bytes
+that were not hashed against the validator manifest.  The store records each
+entry's stat tuple when it was last known good (a verification manifest at its
+root); a chute is linked to an entry only while that record still matches,
+otherwise the chute's freshly verified inode replaces the entry.
+"""
+
+from __future__ import annotations
+
+import itertools
+import os
+import re
+import threading
+from pathlib import Path
+from typing import Iterable, Iterator, Optional
+
+from loguru import logger
+
+from sek8s.config import cache_config
+
+from .manifest import VerificationManifest
+from .verify import HASH_GIT_BLOB, HASH_SHA256
+
+BLOB_STORE_DIR = ".blobs"
+
+_DIGEST_ALGORITHMS = {64: HASH_SHA256, 40: HASH_GIT_BLOB}
+# Temp link names must be unique across threads of this process, not only across processes
+_link_seq = itertools.count()
+# Serializes read-modify-write of the store's verified-entry records
+_records_lock = threading.Lock()
+_HEX = re.compile(r"^[0-9a-f]+$")
+
+
+def blob_algorithm(name: str) -> Optional[str]:
+    """Algorithm implied by an HF blob file name (sha256 for LFS, git blob id otherwise)."""
+    if not _HEX.match(name):
+        return None
+    return _DIGEST_ALGORITHMS.get(len(name))
+
+
+def iter_chute_blobs(chute_dir: Path) -> Iterator[Path]:
+    """Regular blob files of every repo in a chute's hub tree."""
+    for blobs_dir in (Path(chute_dir) / "hub").glob("models--*/blobs"):
+        for entry in os.scandir(blobs_dir):
+            if entry.is_file(follow_symlinks=False) and blob_algorithm(entry.name):
+                yield Path(entry.path)
+
+
+class BlobStore:
+    """Hardlink-based shared blob store; reference counts are inode link counts."""
+
+    def __init__(self, root: Path):
+        self.root = Path(root)
+
+    def path_for(self, digest: str, algorithm: str) -> Path:
+        return self.root / algorithm / digest[:2] / digest
+
+    def refcount(self, digest: str, algorithm: str) -> int:
+        """Number of chute blob files linked to the store entry (0 if absent)."""
+        try:
+            return os.stat(self.path_for(digest, algorithm)).st_nlink - 1
+        except FileNotFoundError:
+            return 0
+
+    def is_verified(self, digest: str, algorithm: str, st: Optional[os.stat_result] = None) -> bool:
+        """True if the store entry is unchanged since it was last recorded as verified."""
+        try:
+            st = st or os.stat(self.path_for(digest, algorithm))
+        except FileNotFoundError:
+            return False
+        records = VerificationManifest.load(self.root, BLOB_STORE_DIR, "")
+        return records.is_verified(f"{algorithm}/{digest}", st, digest, algorithm)
+
+    def _record(self, digest: str, algorithm: str) -> None:
+        """Record the store entry's current stat tuple as verified."""
+        with _records_lock:
+            records = VerificationManifest.load(self.root, BLOB_STORE_DIR, "")
+            key = f"{algorithm}/{digest}"
+            try:
+                records.record(key, os.stat(self.path_for(digest, algorithm)), digest, algorithm)
+            except FileNotFoundError:
+                records.entries.pop(key, None)
+            records.save(self.root)
+
+    def _forget(self, entries: Iterable[Path]) -> None:
+        """Drop the records of removed store entries."""
+        keys = {f"{Path(entry).parent.parent.name}/{Path(entry).name}" for entry in entries}
+        if not keys:
+            return
+        with _records_lock:
+            records = VerificationManifest.load(self.root, BLOB_STORE_DIR, "")
+            if records.prune(set(records.entries) - keys) == 0:
+                return
+            if records.entries:
+                records.save(self.root)
+            else:
+                VerificationManifest.invalidate(self.root)
+
+    def link_into(self, digest: str, algorithm: str, dest: Path) -> bool:
+        """Materialize ``dest`` as a hardlink to the stored blob; False if not stored."""
+        src = self.path_for(digest, algorithm)
+        verified = self.is_verified(digest, algorithm)
+        tmp = dest.with_name(f"{dest.name}.link.{os.getpid()}.{next(_link_seq)}")
+        try:
+            os.link(src, tmp)
+        except FileNotFoundError:
+            return False
+        except OSError as e:
+            logger.debug("Cannot link {} from blob store: {}", dest, e)
+            return False
+        os.replace(tmp, dest)
+        # rename() is a no-op when dest already is a link to the same inode
+        tmp.unlink(missing_ok=True)
+        if verified:
+            # The new link changed the entry's ctime, not its content
+            self._record(digest, algorithm)
+        return True
+
+    def adopt(self, path: Path, digest: str, algorithm: str) -> int:
+        """Share a verified chute blob through the store.
+
+        If the store holds the digest and the entry is unchanged since it was
+        recorded as verified, ``path`` is replaced by a link to it and the bytes
+        this saved are returned; otherwise ``path`` becomes the store's copy
+        and 0 is returned.
+        """
+        target = self.path_for(digest, algorithm)
+        st = os.stat(path)
+        try:
+            target_st = os.stat(target)
+        except FileNotFoundError:
+            target.parent.mkdir(parents=True, exist_ok=True)
+            try:
+                os.link(path, target)
+                self._record(digest, algorithm)
+                return 0
+            except FileExistsError:
+                target_st = os.stat(target)  # adopted concurrently by another chute
+            except OSError as e:
+                logger.debug("Cannot add {} to blob store: {}", path, e)
+                return 0
+
+        if target_st.st_ino == st.st_ino and target_st.st_dev == st.st_dev:
+            self._record(digest, algorithm)
+            return 0
+        if not self.is_verified(digest, algorithm, target_st):
+            # Changed (or never recorded) since it was known good: the chute's copy was just hashed
+            logger.warning("Blob store entry {} is not known good; replacing it with {}", target, path)
+            tmp = target.with_name(f"{target.name}.adopt.{os.getpid()}.{next(_link_seq)}")
+            try:
+                os.link(path, tmp)
+                os.replace(tmp, target)
+            except OSError as e:
+                tmp.unlink(missing_ok=True)
+                logger.debug("Cannot replace blob store entry {}: {}", target, e)
+                return 0
+            self._record(digest, algorithm)
+            return 0
+        if not self.link_into(digest, algorithm, path):
+            return 0
+        # Only the last link to the old inode actually frees its blocks
+        return st.st_size if st.st_nlink == 1 else 0
+
+    def adopt_snapshot(self, snapshot_dir: Path) -> tuple[int, int]:
+        """Adopt every blob referenced by a verified snapshot; returns ``(blobs, bytes_deduplicated)``."""
+        adopted = 0
+        saved = 0
+        for link in Path(snapshot_dir).rglob("*"):
+            if not link.is_symlink():
+                continue
+            blob = link.resolve()
+            algorithm = blob_algorithm(blob.name)
+            if algorithm is None or not blob.is_file():
+                continue
+            saved += self.adopt(blob, blob.name, algorithm)
+            adopted += 1
+        return adopted, saved
+
+    def is_shared(self, path: Path, st: Optional[os.stat_result] = None) -> bool:
+        """True if ``path`` is the same inode as its store entry."""
+        algorithm = blob_algorithm(path.name)
+        if algorithm is None:
+            return False
+        st = st or os.stat(path)
+        try:
+            target_st = os.stat(self.path_for(path.name, algorithm))
+        except FileNotFoundError:
+            return False
+        return target_st.st_ino == st.st_ino and target_st.st_dev == st.st_dev
+
+    def exclusive_bytes(self, chute_dir: Path) -> int:
+        """Bytes that deleting ``chute_dir`` would free (blobs no other chute links)."""
+        total = 0
+        for blob in iter_chute_blobs(chute_dir):
+            try:
+                st = os.stat(blob)
+            except FileNotFoundError:
+                continue
+            # Links besides this one: the store entry (if shared) plus other chutes
+            others = st.st_nlink - 1 - (1 if self.is_shared(blob, st) else 0)
+            if others == 0:
+                total += st.st_size
+        return total
+
+    def unique_bytes(self, chute_dirs: Iterable[Path]) -> int:
+        """Actual bytes used by the blobs of ``chute_dirs``, counting shared inodes once."""
+        seen: set[tuple[int, int]] = set()
+        total = 0
+        for chute_dir in chute_dirs:
+            for blob in iter_chute_blobs(chute_dir):
+                try:
+                    st = os.stat(blob)
+                except FileNotFoundError:
+                    continue
+                if (st.st_dev, st.st_ino) not in seen:
+                    seen.add((st.st_dev, st.st_ino))
+                    total += st.st_size
+        return total
+
+    def shared_entries(self, chute_dir: Path) -> list[Path]:
+        """Store entries referenced by ``chute_dir``; pass to :meth:`release` after deleting it."""
+        entries = []
+        for blob in iter_chute_blobs(chute_dir):
+            try:
+                if self.is_shared(blob):
+                    entries.append(self.path_for(blob.name, blob_algorithm(blob.name)))
+            except FileNotFoundError:
+                continue
+        return entries
+
+    def release(self, entries: Iterable[Path]) -> int:
+        """Drop store entries no chute references anymore; returns bytes freed."""
+        freed = 0
+        removed = []
+        for entry in entries:
+            try:
+                st = os.stat(entry)
+                if st.st_nlink == 1:
+                    os.unlink(entry)
+                    freed += st.st_size
+                    removed.append(entry)
+            except FileNotFoundError:
+                continue
+        self._forget(removed)
+        return freed
+
+    def evict(self, entries: Iterable[Path]) -> None:
+        """Remove store entries outright; chutes keep their links but no new chute gets them."""
+        entries = list(entries)
+        for entry in entries:
+            Path(entry).unlink(missing_ok=True)
+        self._forget(entries)
+
+    def gc(self) -> int:
+        """Collect every unreferenced store entry (e.g. left behind by a crash)."""
+        if not self.root.exists():
+            return 0
+        freed = self.release(p for p in self.root.glob("*/*/*") if p.is_file())
+        if freed:
+            logger.info("Blob store GC freed {} bytes", freed)
+        return freed
+
+
+def share_snapshot(store: BlobStore, cache_dir: Path, repo_id: str, revision: str) -> tuple[int, int]:
+    """Adopt a verified snapshot into the store and keep its verification manifest current.
+
+    Adopted files now point at the store's inode (a new inode, or a new ctime
+    from the extra link), which is either this chute's just-verified inode or
+    one unchanged since it was recorded as verified, so their manifest entries
+    are re-recorded instead of forcing a re-hash on the next verification.
+
+    Other chutes linking the same inode see its ctime change too; their
+    manifests are not rewritten here, so their next verification re-hashes
+    those blobs once.
+    """
+    snapshot_dir = Path(cache_dir) / "hub" / f"models--{repo_id.replace('/', '--')}" / "snapshots" / revision
+    adopted, saved = store.adopt_snapshot(snapshot_dir)
+    if adopted:
+        manifest = VerificationManifest.load(cache_dir, repo_id, revision)
+        changed = False
+        for rel_path, entry in list(manifest.entries.items()):
+            try:
+                blob = (snapshot_dir / rel_path).resolve()
+                st = os.stat(blob)
+            except OSError:
+                continue
+            if not entry.matches(st, entry.digest, entry.algorithm) and store.is_shared(blob, st):
+                manifest.record(rel_path, st, entry.digest, entry.algorithm)
+                changed = True
+        if changed:
+            manifest.save(cache_dir)
+    return adopted, saved
+
+
+def get_blob_store() -> Optional[BlobStore]:
+    """BlobStore under the cache base, or None when sharing is disabled."""
+    if not cache_config.blob_store_enabled:
+        return None
+    return BlobStore(Path(cache_config.cache_base).resolve() / BLOB_STORE_DIR)
@@ -0,0 +1,802 @@
+"""Cache submodule: parallel ranged-chunk download engine with resume.
+
+Files listed by the validator manifest are fetched from the HF endpoint as
+HTTP range requests spread over a shared pool of connections.  Each blob is
+preallocated as ``blobs/<hash>.chunked`` and chunks are written in place
+with ``pwrite``; completed chunks are checkpointed in a small bitmap sidecar
+so a failed or restarted download only fetches what is missing.  The
+contiguous downloaded prefix of every file is hashed while the rest is still
+in flight, so the digest is ready (and recorded in the verification manifest)
+as soon as the last chunk lands, along with the blob's Merkle leaves (see
+``merkle``).  The finished tree uses the regular HF hub layout (``blobs/`` +
+relative ``snapshots/<revision>`` symlinks).
+
+A blob that later fails verification is repaired: its leaves are hashed
+against the Merkle manifest and only the damaged ones are fetched again with
+range requests.  A blob hardlinked elsewhere (other chutes, the blob store)
+is repaired in a private copy that then replaces it, so the other links are
+never written to.
+
+With peers configured (see ``peers``), chunks of blobs that other nodes of
+the fleet hold are fetched from them first.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import errno
+import json
+import os
+import shutil
+import time
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Optional
+from urllib.parse import quote
+
+import aiohttp
+from huggingface_hub import snapshot_download
+from loguru import logger
+
+from sek8s.config import cache_config
+
+from .blobstore import BlobStore, get_blob_store
+from .fileio import open_noatime
+from .manifest import VerificationManifest
+from .merkle import LeafHasher, MerkleEntry, MerkleManifest
+from .peers import PeerDirectory, peer_headers
+from .scheduler import Throttle
+from .verify import HASH_GIT_BLOB, HASH_SHA256, new_hasher
+
+# Distinct from huggingface_hub's ``.incomplete`` files, which it resumes by appending
+INCOMPLETE_SUFFIX = ".chunked"
+_CHECKPOINT_SUFFIX = ".chunked.json"
+_REPAIR_SUFFIX = ".repair"
+# Mode the chute tree is given after a download; blobs get it before they are
+# recorded in the verification manifest, so that chmod does not change their ctime
+CACHE_FILE_MODE = 0o2775
+_WRITE_BUFFER = 8 * 1024 * 1024
+_HASH_READ_SIZE = 16 * 1024 * 1024
+
+
+@dataclass
+class DownloadProgress:
+    """Byte-level progress of one snapshot download; updated on the event loop."""
+
+    files_total: int = 0
+    bytes_total: int = 0
+    files_done: int = 0
+    bytes_done: int = 0
+    bytes_resumed: int = 0
+    bytes_allocated: int = 0
+    bytes_from_peers: int = 0
+    started_at: float = field(default_factory=time.monotonic)
+    finished_at: Optional[float] = None
+
+    @property
+    def throughput(self) -> Optional[float]:
+        """Bytes/sec fetched in this session (resumed bytes excluded)."""
+        elapsed = (self.finished_at or time.monotonic()) - self.started_at
+        fetched = self.bytes_done - self.bytes_resumed
+        return fetched / elapsed if elapsed > 0 and fetched > 0 else None
+
+    @property
+    def percent_complete(self) -> Optional[float]:
+        if self.bytes_total <= 0:
+            return None
+        return min(100.0, 100.0 * self.bytes_done / self.bytes_total)
+
+    @property
+    def eta_seconds(self) -> Optional[float]:
+        rate = self.throughput
+        if not rate:
+            return None
+        return max(0.0, (self.bytes_total - self.bytes_done) / rate)
+
+
+@dataclass
+class RemoteFile:
+    """One file from the validator manifest, addressed by its HF blob name."""
+
+    path: str
+    size: int
+    blob: str
+    algorithm: str
+
+    @classmethod
+    def from_manifest(cls, item: dict) -> Optional["RemoteFile"]:
+        if item.get("is_lfs"):
+            blob, algorithm = item.get("sha256"), HASH_SHA256
+        else:
+            blob, algorithm = item.get("blob_id"), HASH_GIT_BLOB
+        if not blob or item.get("size") is None:
+            return None
+        return cls(path=item["path"], size=int(item["size"]), blob=str(blob), algorithm=algorithm)
+
+
+class ChunkCheckpoint:
+    """Completed-chunk bitmap for one partial blob, persisted as a JSON sidecar."""
+
+    def __init__(self, path: Path, size: int, chunk_size: int, blob: str):
+        self.path = path
+        self.size = size
+        self.chunk_size = chunk_size
+        self.blob = blob
+        self.num_chunks = max(1, -(-size // chunk_size))
+        self.done = bytearray(-(-self.num_chunks // 8))
+
+    @classmethod
+    def load(cls, path: Path, size: int, chunk_size: int, blob: str) -> "ChunkCheckpoint":
+        """Load the sidecar; a missing or mismatched one yields an empty bitmap."""
+        checkpoint = cls(path, size, chunk_size, blob)
+        try:
+            data = json.loads(path.read_text(encoding="utf-8"))
+            if (data.get("size"), data.get("chunk_size"), data.get("blob")) == (size, chunk_size, blob):
+                bitmap = bytes.fromhex(data.get("done", ""))
+                if len(bitmap) == len(checkpoint.done):
+                    checkpoint.done[:] = bitmap
+        except FileNotFoundError:
+            pass
+        except (OSError, ValueError) as e:
+            logger.warning("Ignoring unreadable download checkpoint {}: {}", path, e)
+        return checkpoint
+
+    def save(self) -> None:
+        tmp = self.path.with_name(f"{self.path.name}.tmp")
+        data = {"size": self.size, "chunk_size": self.chunk_size, "blob": self.blob, "done": self.done.hex()}
+        tmp.write_text(json.dumps(data), encoding="utf-8")
+        os.replace(tmp, self.path)
+
+    def is_done(self, index: int) -> bool:
+        return bool(self.done[index >> 3] & (1 << (index & 7)))
+
+    def mark_done(self, index: int) -> None:
+        self.done[index >> 3] |= 1 << (index & 7)
+
+    def chunk_range(self, index: int) -> tuple[int, int]:
+        """Inclusive byte range of chunk ``index``."""
+        start = index * self.chunk_size
+        return start, min(self.size, start + self.chunk_size) - 1
+
+    def missing(self) -> list[int]:
+        return [i for i in range(self.num_chunks) if not self.is_done(i)]
+
+    def bytes_done(self) -> int:
+        total = 0
+        for i in range(self.num_chunks):
+            if self.is_done(i):
+                start, end = self.chunk_range(i)
+                total += end - start + 1
+        return total
+
+
+class _BlobIO:
+    """An open blob written by range requests; ``checkpoint`` defines the ranges."""
+
+    remote: RemoteFile
+    checkpoint: ChunkCheckpoint
+    fd: int
+    _io: set[asyncio.Future]
+
+    async def run_io(self, fn, *args):
+        """Run blocking I/O on the fd in a thread.
+
+        Cancelling the caller does not stop the thread, so the operation is
+        tracked and :meth:`drain` waits for it before the fd is closed.
+        """
+        future = asyncio.ensure_future(asyncio.to_thread(fn, *args))
+        self._io.add(future)
+        future.add_done_callback(self._io.discard)
+        return await asyncio.shield(future)
+
+    async def drain(self) -> None:
+        if self._io:
+            await asyncio.gather(*self._io, return_exceptions=True)
+
+    def close(self) -> None:
+        if self.fd >= 0:
+            os.close(self.fd)
+            self.fd = -1
+
+
+class _FileDownload(_BlobIO):
+    """In-flight state of one blob: fd, checkpoint, and the prefix hasher."""
+
+    def __init__(self, remote: RemoteFile, blobs_dir: Path, chunk_size: int, leaf_size: int = 0):
+        self.remote = remote
+        self.final_path = blobs_dir / remote.blob
+        self.incomplete_path = blobs_dir / f"{remote.blob}{INCOMPLETE_SUFFIX}"
+        self.checkpoint = ChunkCheckpoint.load(
+            blobs_dir / f"{remote.blob}{_CHECKPOINT_SUFFIX}", remote.size, chunk_size, remote.blob
+        )
+        if not self.incomplete_path.exists():
+            # A checkpoint without its data file is meaningless
+            self.checkpoint.done[:] = bytes(len(self.checkpoint.done))
+        self.fd = os.open(self.incomplete_path, os.O_RDWR | os.O_CREAT, 0o664)
+        existing = os.fstat(self.fd).st_size
+        if existing != remote.size:
+            try:
+                self._preallocate()
+            except OSError:
+                self.close()
+                raise
+        # Only what this session added; a partial blob of an earlier attempt already held the rest
+        self.allocated = max(0, remote.size - existing)
+        self.remaining = len(self.checkpoint.missing())
+        self.hasher = new_hasher(remote.algorithm, remote.size)
+        self.leaves = LeafHasher(leaf_size) if leaf_size > 0 else None
+        self.hashed_through = 0  # next chunk index the prefix hasher needs
+        self.hash_lock = asyncio.Lock()
+        self.checkpoint_lock = asyncio.Lock()
+        self._io: set[asyncio.Future] = set()
+        self.peers: list[str] = []  # blob URLs of peers holding this blob
+        self.used_peers = False
+
+    def _preallocate(self) -> None:
+        """Allocate the whole blob up front: contiguous extents, and ENOSPC before any download.
+
+        The size is only extended once allocation succeeds, so a blob left
+        behind by an ENOSPC failure is allocated again on the next attempt.
+        """
+        try:
+            os.posix_fallocate(self.fd, 0, self.remote.size)
+        except OSError as e:
+            if e.errno == errno.ENOSPC:
+                raise
+            # Not supported on every filesystem; the sparse file still allows in-place writes
+        except AttributeError:
+            pass
+        os.ftruncate(self.fd, self.remote.size)
+
+    def _hash_range(self, start: int, end: int) -> None:
+        offset = start
+        while offset <= end:
+            data = os.pread(self.fd, min(_HASH_READ_SIZE, end - offset + 1), offset)
+            if not data:
+                raise OSError(f"Short read hashing {self.incomplete_path} at {offset}")
+            self.hasher.update(data)
+            if self.leaves is not None:
+                self.leaves.update(data)
+            offset += len(data)
+
+    async def advance_hash(self) -> None:
+        """Hash every newly contiguous completed chunk (re-reads from the page cache)."""
+        async with self.hash_lock:
+            checkpoint = self.checkpoint
+            while self.hashed_through < checkpoint.num_chunks and checkpoint.is_done(self.hashed_through):
+                start, end = checkpoint.chunk_range(self.hashed_through)
+                if end >= start:
+                    await self.run_io(self._hash_range, start, end)
+                self.hashed_through += 1
+
+    async def restart(self) -> None:
+        """Forget every chunk and start over from the HF endpoint alone (peer data failed the digest)."""
+        self.checkpoint.done[:] = bytes(len(self.checkpoint.done))
+        async with self.checkpoint_lock:
+            await asyncio.to_thread(self.checkpoint.save)
+        self.remaining = self.checkpoint.num_chunks
+        self.hasher = new_hasher(self.remote.algorithm, self.remote.size)
+        if self.leaves is not None:
+            self.leaves = LeafHasher(self.leaves.leaf_size)
+        self.hashed_through = 0
+        self.peers = []
+        self.used_peers = False
+
+    def discard(self) -> None:
+        """Remove partial data and checkpoint (used after a digest mismatch)."""
+        self.close()
+        self.incomplete_path.unlink(missing_ok=True)
+        self.checkpoint.path.unlink(missing_ok=True)
+
+
+class _BlobRepair(_BlobIO):
+    """A finished blob (or its private copy) opened for rewriting some of its Merkle leaves."""
+
+    def __init__(self, remote: RemoteFile, path: Path, entry: MerkleEntry):
+        self.remote = remote
+        # Never saved: only provides leaf-sized ranges to the chunk fetcher
+        self.checkpoint = ChunkCheckpoint(
+            path.with_name(f"{remote.blob}{_CHECKPOINT_SUFFIX}"), entry.size, entry.leaf_size, remote.blob
+        )
+        self.fd = open_noatime(path, os.O_RDWR)
+        self._io: set[asyncio.Future] = set()
+        try:
+            # A short or overlong blob is brought to its recorded size; the tail leaves are re-fetched
+            if os.fstat(self.fd).st_size != entry.size:
+                os.ftruncate(self.fd, entry.size)
+        except OSError:
+            self.close()
+            raise
+
+
+class _PeerDataMismatch(ValueError):
+    """A blob assembled partly from peer chunks does not match its digest."""
+
+
+class ChunkedDownloader:
+    """Download a repo snapshot into the HF hub layout with parallel range requests."""
+
+    def __init__(
+        self,
+        endpoint: str = "https://huggingface.co",
+        *,
+        chunk_size: int = 64 * 1024 * 1024,
+        connections: int = 16,
+        retries: int = 5,
+        token: Optional[str] = None,
+        blob_store: Optional[BlobStore] = None,
+        leaf_size: int = 64 * 1024 * 1024,
+        peers: Optional[PeerDirectory] = None,
+    ):
+        self.endpoint = endpoint.rstrip("/")
+        self.chunk_size = chunk_size
+        self.leaf_size = leaf_size  # 0 = no Merkle leaves
+        self.connections = max(1, connections)
+        self.retries = max(1, retries)
+        self.token = token
+        self.blob_store = blob_store
+        self.peers = peers
+
+    @classmethod
+    def from_config(cls) -> "ChunkedDownloader":
+        return cls(
+            cache_config.hf_endpoint,
+            chunk_size=cache_config.download_chunk_size_mb * 1024 * 1024,
+            connections=cache_config.download_connections,
+            retries=cache_config.download_retries,
+            token=os.environ.get("HF_TOKEN") or os.environ.get("HUGGING_FACE_HUB_TOKEN"),
+            blob_store=get_blob_store(),
+            leaf_size=cache_config.merkle_leaf_size_mb * 1024 * 1024 if cache_config.repair_enabled else 0,
+            peers=PeerDirectory.from_config(),
+        )
+
+    def file_url(self, repo_id: str, revision: str, path: str) -> str:
+        return f"{self.endpoint}/{repo_id}/resolve/{quote(revision, safe='')}/{quote(path)}"
+
+    async def download(
+        self,
+        repo_id: str,
+        revision: str,
+        cache_dir: Path,
+        files: list[RemoteFile],
+        progress: Optional[DownloadProgress] = None,
+        throttle: Optional[Throttle] = None,
+    ) -> None:
+        """Fetch all files into ``cache_dir/hub`` and link the snapshot; raises on failure.
+
+        Partial blobs and their checkpoints are kept on failure (or cancellation)
+        so the next call resumes; a blob whose digest does not match the
+        manifest is discarded.  ``throttle`` paces received bytes.  Files with
+        identical content share one blob, which is fetched (and counted in
+        ``progress``) once.
+        """
+        progress = progress if progress is not None else DownloadProgress()
+        repo_dir = Path(cache_dir) / "hub" / f"models--{repo_id.replace('/', '--')}"
+        blobs_dir = repo_dir / "blobs"
+        snapshot_dir = repo_dir / "snapshots" / revision
+        blobs_dir.mkdir(parents=True, exist_ok=True)
+        snapshot_dir.mkdir(parents=True, exist_ok=True)
+
+        manifest = VerificationManifest.load(cache_dir, repo_id, revision)
+        merkle = MerkleManifest.load(cache_dir) if self.leaf_size else None
+        unique: dict[str, RemoteFile] = {}
+        for remote in files:
+            unique.setdefault(remote.blob, remote)
+        pending: list[_FileDownload] = []
+        try:
+            for remote in sorted(unique.values(), key=lambda f: f.size, reverse=True):
+                progress.files_total += 1
+                progress.bytes_total += remote.size
+                final_path = blobs_dir / remote.blob
+                if final_path.exists() or self._link_from_store(remote, final_path):
+                    progress.files_done += 1
+                    progress.bytes_done += remote.size
+                    progress.bytes_resumed += remote.size
+                    continue
+                state = _FileDownload(remote, blobs_dir, self.chunk_size, self.leaf_size)
+                progress.bytes_allocated += state.allocated
+                resumed = state.checkpoint.bytes_done()
+                progress.bytes_done += resumed
+                progress.bytes_resumed += resumed
+                pending.append(state)
+
+            if pending:
+                await self._fetch_all(repo_id, revision, pending, manifest, merkle, progress, throttle)
+        finally:
+            for state in pending:
+                await state.drain()
+                state.close()
+            progress.finished_at = time.monotonic()
+            if merkle is not None and pending:
+                # Leaves of blobs finished before a failure stay usable
+                await asyncio.to_thread(merkle.save, cache_dir)
+
+        for remote in files:
+            self._link_snapshot(snapshot_dir, remote)
+            first = unique[remote.blob]
+            if remote is not first and first.path in manifest.entries:
+                manifest.entries[remote.path] = manifest.entries[first.path]
+        manifest.prune({remote.path for remote in files})
+        manifest.save(cache_dir)
+        logger.info(
+            "Chunked download complete: repo={}, rev={}, files={}, bytes={}, resumed={}, from_peers={}, "
+            "throughput={:.1f} MB/s",
+            repo_id, revision[:12], progress.files_total, progress.bytes_total,
+            progress.bytes_resumed, progress.bytes_from_peers, (progress.throughput or 0) / 1e6,
+        )
+
+    def _link_from_store(self, remote: RemoteFile, final_path: Path) -> bool:
+        """Reuse a blob another chute already downloaded and verified."""
+        if self.blob_store is None or not self.blob_store.link_into(remote.blob, remote.algorithm, final_path):
+            return False
+        for suffix in (INCOMPLETE_SUFFIX, _CHECKPOINT_SUFFIX):
+            final_path.with_name(f"{remote.blob}{suffix}").unlink(missing_ok=True)
+        logger.debug("Linked {} from the shared blob store", remote.path)
+        return True
+
+    async def _fetch_all(
+        self,
+        repo_id: str,
+        revision: str,
+        pending: list[_FileDownload],
+        manifest: VerificationManifest,
+        merkle: Optional[MerkleManifest],
+        progress: DownloadProgress,
+        throttle: Optional[Throttle],
+    ) -> None:
+        # Largest files first, chunks in order, so prefix hashing keeps up with the network
+        queue: asyncio.Queue[tuple[_FileDownload, int]] = asyncio.Queue()
+        for state in pending:
+            for index in state.checkpoint.missing():
+                queue.put_nowait((state, index))
+
+        peer_session = self.peers.session() if self.peers is not None else None
+        try:
+            async with self._session() as session:
+                # Files fully present from a previous run only need hashing and finalizing
+                for state in pending:
+                    if state.remaining == 0:
+                        await self._finalize(state, manifest, merkle, progress)
+                if peer_session is not None:
+                    await self._locate_peers(peer_session, pending)
+
+                async def worker() -> None:
+                    while True:
+                        state, index = await queue.get()
+                        try:
+                            await self._fetch_from_sources(
+                                session, peer_session, repo_id, revision, state, index, progress, throttle
+                            )
+                            await self._complete_chunk(state, index, queue, manifest, merkle, progress)
+                        finally:
+                            queue.task_done()
+
+                # Workers wait on the queue rather than exit when it drains: a blob
+                # restarted after a peer mismatch puts all of its chunks back
+                workers = [asyncio.create_task(worker()) for _ in range(min(self.connections, queue.qsize()))]
+                joined = asyncio.ensure_future(queue.join())
+                try:
+                    await asyncio.wait([joined, *workers], return_when=asyncio.FIRST_COMPLETED)
+                    for task in workers:
+                        if task.done():
+                            task.result()
+                finally:
+                    for task in (joined, *workers):
+                        task.cancel()
+                    await asyncio.gather(joined, *workers, return_exceptions=True)
+        finally:
+            if peer_session is not None:
+                await peer_session.close()
+
+    async def _complete_chunk(
+        self,
+        state: _FileDownload,
+        index: int,
+        queue: asyncio.Queue,
+        manifest: VerificationManifest,
+        merkle: Optional[MerkleManifest],
+        progress: DownloadProgress,
+    ) -> None:
+        state.checkpoint.mark_done(index)
+        async with state.checkpoint_lock:
+            # Serialized: concurrent saves would race on the temp file
+            await asyncio.to_thread(state.checkpoint.save)
+        state.remaining -= 1
+        if state.remaining > 0:
+            await state.advance_hash()
+            return
+        try:
+            await self._finalize(state, manifest, merkle, progress)
+        except _PeerDataMismatch as e:
+            logger.warning("{}; fetching it again from {}", e, self.endpoint)
+            progress.bytes_done -= state.remote.size
+            await state.restart()
+            for missing in state.checkpoint.missing():
+                queue.put_nowait((state, missing))
+
+    async def _locate_peers(self, peer_session: aiohttp.ClientSession, pending: list[_FileDownload]) -> None:
+        wanted = {state.remote.blob for state in pending if state.remaining > 0}
+        holders = await self.peers.locate(peer_session, wanted)
+        for state in pending:
+            state.peers = list(holders.get(state.remote.blob, []))
+        if holders:
+            logger.info("{} of {} blobs available from peers", len(holders), len(wanted))
+
+    async def _fetch_from_sources(
+        self,
+        session: aiohttp.ClientSession,
+        peer_session: Optional[aiohttp.ClientSession],
+        repo_id: str,
+        revision: str,
+        state: _FileDownload,
+        index: int,
+        progress: DownloadProgress,
+        throttle: Optional[Throttle],
+    ) -> None:
+        """Fetch a chunk from a peer holding the blob, else from the HF endpoint.
+
+        Chunks rotate over the holders; a peer that fails once is not asked
+        for this blob again.
+        """
+        while state.peers and peer_session is not None:
+            url = state.peers[index % len(state.peers)]
+            try:
+                await self._fetch_chunk(
+                    peer_session, url, state, index, progress, throttle, attempts=1, headers=peer_headers()
+                )
+            except (aiohttp.ClientError, asyncio.TimeoutError) as e:
+                logger.info("Peer fetch of chunk {} of {} failed ({}); skipping that peer", index, state.remote.path, e)
+                if url in state.peers:
+                    state.peers.remove(url)
+                continue
+            start, end = state.checkpoint.chunk_range(index)
+            progress.bytes_from_peers += max(0, end - start + 1)
+            state.used_peers = True
+            return
+        url = self.file_url(repo_id, revision, state.remote.path)
+        await self._fetch_chunk(session, url, state, index, progress, throttle)
+
+    def _session(self) -> aiohttp.ClientSession:
+        connector = aiohttp.TCPConnector(limit=self.connections, limit_per_host=self.connections)
+        timeout = aiohttp.ClientTimeout(total=None, sock_connect=30, sock_read=120)
+        headers = {"Authorization": f"Bearer {self.token}"} if self.token else {}
+        return aiohttp.ClientSession(connector=connector, timeout=timeout, headers=headers)
+
+    async def repair(
+        self,
+        repo_id: str,
+        revision: str,
+        cache_dir: Path,
+        remote: RemoteFile,
+        throttle: Optional[Throttle] = None,
+    ) -> Optional[int]:
+        """Re-fetch the damaged Merkle leaves of one blob.
+
+        Returns the bytes fetched (0 if no leaf is damaged), or None when the
+        blob has no usable Merkle entry.  Raises if a repaired leaf still does
+        not match.  The caller must re-verify the whole blob afterwards.
+
+        A blob with other hardlinks is repaired in a private copy that is then
+        renamed over it; its blob store entry, which holds the damaged bytes,
+        is evicted.
+        """
+        entry = MerkleManifest.load(cache_dir).get(remote.blob)
+        path = Path(cache_dir) / "hub" / f"models--{repo_id.replace('/', '--')}" / "blobs" / remote.blob
+        if entry is None or entry.size != remote.size or not path.exists():
+            return None
+        damaged = await asyncio.to_thread(entry.damaged_leaves, path)
+        st = path.stat()
+        if not damaged and st.st_size == entry.size:
+            return 0
+
+        shared = self.blob_store is not None and self.blob_store.is_shared(path, st)
+        target = path
+        if st.st_nlink > 1:
+            target = path.with_name(f"{remote.blob}{_REPAIR_SUFFIX}")
+            await asyncio.to_thread(shutil.copy, path, target)
+
+        progress = DownloadProgress(files_total=1, bytes_total=len(damaged) * entry.leaf_size)
+        url = self.file_url(repo_id, revision, remote.path)
+        slots = asyncio.Semaphore(self.connections)
+        try:
+            state = _BlobRepair(remote, target, entry)
+            try:
+                async with self._session() as session:
+
+                    async def fetch(index: int) -> None:
+                        async with slots:
+                            await self._fetch_chunk(session, url, state, index, progress, throttle)
+
+                    await asyncio.gather(*(fetch(index) for index in damaged))
+                still_damaged = [
+                    index for index in damaged
+                    if await state.run_io(entry.hash_leaf, state.fd, index) != entry.leaves[index]
+                ]
+            finally:
+                await state.drain()
+                state.close()
+            if still_damaged:
+                raise ValueError(f"Repair failed: {remote.path} leaves {still_damaged[:8]} still do not match")
+            if target != path:
+                os.replace(target, path)
+        finally:
+            if target != path:
+                target.unlink(missing_ok=True)
+        if shared:
+            self.blob_store.evict([self.blob_store.path_for(remote.blob, remote.algorithm)])
+        logger.info(
+            "Repaired {}: {} of {} leaves re-fetched ({} bytes)",
+            remote.path, len(damaged), entry.num_leaves, progress.bytes_done,
+        )
+        return progress.bytes_done
+
+    async def _fetch_chunk(
+        self,
+        session: aiohttp.ClientSession,
+        url: str,
+        state: _BlobIO,
+        index: int,
+        progress: DownloadProgress,
+        throttle: Optional[Throttle],
+        *,
+        attempts: Optional[int] = None,
+        headers: Optional[dict[str, str]] = None,
+    ) -> None:
+        """GET one byte range into place, retrying with backoff; progress is rolled back on retry."""
+        start, end = state.checkpoint.chunk_range(index)
+        if end < start:
+            return
+        attempts = attempts or self.retries
+        for attempt in range(1, attempts + 1):
+            written = 0
+            try:
+                async with session.get(url, headers={**(headers or {}), "Range": f"bytes={start}-{end}"}) as resp:
+                    whole_file = resp.status == 200 and start == 0 and end == state.remote.size - 1
+                    if resp.status != 206 and not whole_file:
+                        raise aiohttp.ClientResponseError(
+                            resp.request_info, resp.history, status=resp.status,
+                            message=f"expected 206 for range {start}-{end}",
+                        )
+                    buf = bytearray()
+                    async for data in resp.content.iter_chunked(1024 * 1024):
+                        if throttle is not None:
+                            await throttle.consume(len(data))
+                        buf += data
+                        if len(buf) >= _WRITE_BUFFER:
+                            await self._write(state, buf, start + written, end)
+                            written += len(buf)
+                            progress.bytes_done += len(buf)
+                            buf = bytearray()
+                    if buf:
+                        await self._write(state, buf, start + written, end)
+                        written += len(buf)
+                        progress.bytes_done += len(buf)
+                if written != end - start + 1:
+                    raise aiohttp.ClientPayloadError(
+                        f"short range {start}-{end}: got {written} bytes"
+                    )
+                await state.run_io(os.fdatasync, state.fd)
+                return
+            except (aiohttp.ClientError, asyncio.TimeoutError) as e:
+                progress.bytes_done -= written
+                if attempt == attempts or (
+                    isinstance(e, aiohttp.ClientResponseError) and e.status in (401, 403, 404)
+                ):
+                    raise
+                delay = min(30.0, 2.0 ** attempt)
+                logger.warning(
+                    "Chunk {} of {} failed (attempt {}/{}): {}; retrying in {:.0f}s",
+                    index, state.remote.path, attempt, attempts, e, delay,
+                )
+                await asyncio.sleep(delay)
+
+    @staticmethod
+    async def _write(state: _BlobIO, buf: bytearray, offset: int, end: int) -> None:
+        if offset + len(buf) - 1 > end:
+            raise aiohttp.ClientPayloadError(f"server sent more than the requested range ending at {end}")
+
+        def pwrite_all() -> None:
+            view = memoryview(buf)
+            pos = 0
+            while pos < len(view):
+                pos += os.pwrite(state.fd, view[pos:], offset + pos)
+
+        await state.run_io(pwrite_all)
+
+    @staticmethod
+    async def _finalize(
+        state: _FileDownload,
+        manifest: VerificationManifest,
+        merkle: Optional[MerkleManifest],
+        progress: DownloadProgress,
+    ) -> None:
+        """Finish the prefix hash, check the digest, then publish the blob."""
+        await state.advance_hash()
+        digest = state.hasher.hexdigest()
+        remote = state.remote
+        if digest != remote.blob:
+            if state.used_peers:
+                raise _PeerDataMismatch(
+                    f"Hash mismatch in peer-assembled {remote.path} (expected={remote.blob[:12]}, actual={digest[:12]})"
+                )
+            state.discard()
+            raise ValueError(f"Hash mismatch: {remote.path} (expected={remote.blob[:12]}, actual={digest[:12]})")
+        os.fchmod(state.fd, CACHE_FILE_MODE)
+        state.close()
+        os.replace(state.incomplete_path, state.final_path)
+        state.checkpoint.path.unlink(missing_ok=True)
+        manifest.record(remote.path, state.final_path.stat(), digest, remote.algorithm)
+        if merkle is not None and state.leaves is not None and remote.size > 0:
+            merkle.record(remote.blob, remote.size, state.leaves.leaf_size, state.leaves.finish())
+        progress.files_done += 1
+
+    @staticmethod
+    def _link_snapshot(snapshot_dir: Path, remote: RemoteFile) -> None:
+        """Relative symlink ``snapshots/<rev>/<path>`` -> ``blobs/<blob>``, as huggingface_hub lays it out."""
+        link = snapshot_dir / remote.path
+        link.parent.mkdir(parents=True, exist_ok=True)
+        depth = len(Path(remote.path).parts) - 1
+        target = Path(*([".."] * (depth + 2)), "blobs", remote.blob)
+        if link.is_symlink() and Path(os.readlink(link)) == target:
+            return
+        link.unlink(missing_ok=True)
+        link.symlink_to(target)
+
+
+def resolve_remote_files(repo_info: Optional[dict]) -> Optional[list[RemoteFile]]:
+    """Files the chunked engine should fetch, or None if it cannot be used.
+
+    The engine needs sizes and digests up front, so it is skipped when it is
+    disabled, the validator manifest is unavailable, or any file lacks a digest.
+    """
+    if not cache_config.download_engine_enabled or not repo_info:
+        return None
+    files = []
+    for item in repo_info.get("files", []):
+        if item.get("path", "").startswith("_"):
+            continue
+        remote = RemoteFile.from_manifest(item)
+        if remote is None:
+            return None
+        files.append(remote)
+    return files
+
+
+async def download_snapshot(
+    repo_id: str,
+    revision: str,
+    cache_dir: Path,
+    files: Optional[list[RemoteFile]],
+    *,
+    progress: Optional[DownloadProgress] = None,
+    throttle: Optional[Throttle] = None,
+) -> None:
+    """Download a snapshot with the chunked engine, or ``snapshot_download`` when ``files`` is None.
+
+    ``snapshot_download`` has no hook for pacing its transfers, so ``throttle``
+    only applies to the chunked engine.
+    """
+    if files is None:
+        if throttle is not None and cache_config.download_max_bandwidth_mbps:
+            logger.warning(
+                "Downloading {}@{} with snapshot_download: bandwidth cap not applied", repo_id, revision[:12]
+            )
+        else:
+            logger.info("Downloading {}@{} with snapshot_download", repo_id, revision[:12])
+        await asyncio.to_thread(
+            snapshot_download,
+            repo_id=repo_id,
+            revision=revision,
+            cache_dir=str(Path(cache_dir) / "hub"),
+            local_dir_use_symlinks=True,
+        )
+        return
+
+    await ChunkedDownloader.from_config().download(
+        repo_id, revision, Path(cache_dir), files, progress, throttle
+    )
+
+
+async def repair_blob(repo_id: str, revision: str, cache_dir: Path, remote: RemoteFile) -> Optional[int]:
+    """Re-fetch only the damaged ranges of one blob (see :meth:`ChunkedDownloader.repair`)."""
+    return await ChunkedDownloader.from_config().repair(repo_id, revision, Path(cache_dir), remote)
@@ -0,0 +1,163 @@
+"""Cache submodule: in-memory event bus behind the server-sent events stream.
+
+One producer samples every chute's status at a fixed interval (only while
+someone is subscribed) and publishes what changed since the previous sample,
+so any number of observers costs one sampling loop instead of one
+``sync_from_disk`` + snapshot pass per poll.
+
+Each subscriber first receives a ``snapshot`` event with the full state,
+then ``update`` events carrying only the changed fields of one chute and
+``removed`` events.  A subscriber that falls behind has its backlog dropped
+and gets a fresh ``snapshot`` instead, so a slow client never holds memory
+or blocks the producer.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import json
+from dataclasses import dataclass, field
+from typing import AsyncIterator, Awaitable, Callable, Optional
+
+from loguru import logger
+
+from .models import ChuteSnapshot
+
+_RESYNC = object()
+
+
+def status_event(snap: ChuteSnapshot) -> dict:
+    """JSON-safe status of one chute as carried by stream events."""
+    verification = snap.verification
+    return {
+        "status": snap.status.value,
+        "repo_id": snap.repo_id or None,
+        "revision": snap.revision,
+        "size_bytes": snap.size_bytes,
+        "percent_complete": snap.percent_complete,
+        "download_rate": snap.download_rate,
+        "eta_seconds": snap.eta_seconds,
+        "error": snap.error,
+        "priority": snap.priority.value if snap.priority else None,
+        "queue_position": snap.queue_position,
+        "verification_percent": verification.percent_complete if verification is not None else None,
+    }
+
+
+@dataclass(eq=False)
+class _Subscriber:
+    chute_id: Optional[str]
+    queue: asyncio.Queue = field(default_factory=asyncio.Queue)
+    resync: bool = False
+
+
+class CacheEventBus:
+    """Diffing producer plus bounded per-subscriber queues of SSE-formatted messages."""
+
+    def __init__(
+        self,
+        source: Callable[[], Awaitable[dict[str, dict]]],
+        interval: float = 1.0,
+        queue_size: int = 256,
+        keepalive: float = 15.0,
+    ):
+        self._source = source
+        self.interval = interval
+        self.queue_size = queue_size
+        self.keepalive = keepalive
+        self._state: dict[str, dict] = {}
+        self._subscribers: set[_Subscriber] = set()
+        self._producer: Optional[asyncio.Task] = None
+        self._start_lock = asyncio.Lock()
+        self._wake = asyncio.Event()
+        self._seq = 0
+
+    @property
+    def subscriber_count(self) -> int:
+        return len(self._subscribers)
+
+    def notify(self) -> None:
+        """Sample now instead of at the next interval (e.g. a download just started)."""
+        self._wake.set()
+
+    async def subscribe(self, chute_id: Optional[str] = None) -> AsyncIterator[str]:
+        """Yield SSE messages for all chutes (or one) until the client goes away."""
+        sub = _Subscriber(chute_id, asyncio.Queue(self.queue_size))
+        async with self._start_lock:
+            if self._producer is None or self._producer.done():
+                self._state = await self._source()
+                self._producer = asyncio.create_task(self._produce())
+            self._subscribers.add(sub)
+        try:
+            yield self._snapshot(chute_id)
+            while True:
+                try:
+                    message = await asyncio.wait_for(sub.queue.get(), self.keepalive)
+                except asyncio.TimeoutError:
+                    yield ": keepalive\n\n"
+                    continue
+                if message is _RESYNC:
+                    sub.resync = False
+                    yield self._snapshot(chute_id)
+                else:
+                    yield message
+        finally:
+            self._subscribers.discard(sub)
+            if not self._subscribers and self._producer is not None:
+                self._producer.cancel()
+                self._producer = None
+
+    async def close(self) -> None:
+        if self._producer is not None:
+            self._producer.cancel()
+            self._producer = None
+
+    def _snapshot(self, chute_id: Optional[str]) -> str:
+        chutes = [
+            {"chute_id": cid, **status}
+            for cid, status in sorted(self._state.items())
+            if chute_id is None or cid == chute_id
+        ]
+        return self._format("snapshot", {"chutes": chutes})
+
+    async def _produce(self) -> None:
+        while True:
+            try:
+                await asyncio.wait_for(self._wake.wait(), self.interval)
+            except asyncio.TimeoutError:
+                pass
+            self._wake.clear()
+            try:
+                current = await self._source()
+            except Exception:
+                logger.exception("Cache event source failed")
+                continue
+            self._publish_changes(current)
+
+    def _publish_changes(self, current: dict[str, dict]) -> None:
+        for cid, status in current.items():
+            previous = self._state.get(cid, {})
+            changes = {k: v for k, v in status.items() if k not in previous or previous[k] != v}
+            if changes:
+                self._publish("update", cid, {"chute_id": cid, **changes})
+        for cid in self._state.keys() - current.keys():
+            self._publish("removed", cid, {"chute_id": cid})
+        self._state = current
+
+    def _publish(self, event: str, chute_id: str, data: dict) -> None:
+        message = self._format(event, data)
+        for sub in self._subscribers:
+            if sub.resync or (sub.chute_id is not None and sub.chute_id != chute_id):
+                continue
+            try:
+                sub.queue.put_nowait(message)
+            except asyncio.QueueFull:
+                # Slow observer: drop its backlog; a fresh snapshot supersedes it
+                while not sub.queue.empty():
+                    sub.queue.get_nowait()
+                sub.queue.put_nowait(_RESYNC)
+                sub.resync = True
+
+    def _format(self, event: str, data: dict) -> str:
+        self._seq += 1
+        return f"id: {self._seq}\nevent: {event}\ndata: {json.dumps(data, separators=(',', ':'))}\n\n"
@@ -0,0 +1,79 @@
+"""Cache submodule: watermark-driven eviction policy.
+
+When the cache filesystem is fuller than the high watermark, the manager
+evicts whole chute entries until usage drops below the low watermark.
+
+Victims are chosen by a frequency-per-byte score: every recorded access
+(an explicit touch from a pod, or a newer blob atime) adds one hit, hits
+decay with a configurable half-life so old popularity fades (LRU), frequent
+use raises the score (LFU), and the score is divided by the entry's size so
+one large cold model goes before several small warm ones.  Entries that are
+downloading, leased by a running pod, or accessed within the minimum idle
+time are never evicted.
+"""
+
+from __future__ import annotations
+
+import os
+from dataclasses import dataclass
+from pathlib import Path
+from typing import Optional
+
+_GIB = 1024 ** 3
+
+
+@dataclass
+class DiskUsage:
+    """Capacity of the filesystem holding the cache (bytes available to unprivileged users)."""
+
+    total: int
+    available: int
+
+    @property
+    def used(self) -> int:
+        return self.total - self.available
+
+    @property
+    def fraction_used(self) -> float:
+        return self.used / self.total if self.total else 0.0
+
+
+def disk_usage(path: Path) -> DiskUsage:
+    st = os.statvfs(path)
+    return DiskUsage(total=st.f_blocks * st.f_frsize, available=st.f_bavail * st.f_frsize)
+
+
+@dataclass
+class AccessStats:
+    """Access history of one chute entry; persisted with the manager state."""
+
+    hits: int = 0
+    last_access: Optional[float] = None
+    lease_until: Optional[float] = None
+
+    def record(self, at: float) -> None:
+        self.hits += 1
+        if self.last_access is None or at > self.last_access:
+            self.last_access = at
+
+    def lease(self, until: float) -> None:
+        if self.lease_until is None or until > self.lease_until:
+            self.lease_until = until
+
+    def leased(self, now: float) -> bool:
+        return self.lease_until is not None and self.lease_until > now
+
+
+def eviction_score(stats: AccessStats, size_bytes: int, now: float, half_life: float) -> float:
+    """Keep-worthiness of an entry; the lowest score is evicted first."""
+    hits = stats.hits
+    if stats.last_access is not None and half_life > 0:
+        hits *= 0.5 ** (max(0.0, now - stats.last_access) / half_life)
+    return (1.0 + hits) / max(size_bytes / _GIB, 1e-3)
+
+
+def eviction_target(usage: DiskUsage, high: float, low: float) -> int:
+    """Bytes to free to get from above ``high`` down to ``low``; 0 below the high watermark."""
+    if usage.fraction_used < high:
+        return 0
+    return max(0, usage.used - int(min(low, high) * usage.total))
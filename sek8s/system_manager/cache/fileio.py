@@ -0,0 +1,24 @@
+"""Cache submodule: opening blobs for the system manager's own reads.
+
+Blob atimes are how eviction and cleanup see model loads by pods that never
+call the touch API, so verification, prewarm, header indexing, Merkle checks,
+repairs and peer serving open blobs with ``O_NOATIME`` to stay invisible.
+"""
+
+from __future__ import annotations
+
+import os
+from pathlib import Path
+from typing import Union
+
+
+def open_noatime(path: Union[str, Path], flags: int = os.O_RDONLY) -> int:
+    """``os.open`` that leaves the file's atime alone where the kernel allows it."""
+    noatime = getattr(os, "O_NOATIME", 0)
+    if noatime:
+        try:
+            return os.open(path, flags | noatime)
+        except PermissionError:
+            # O_NOATIME needs file ownership or CAP_FOWNER
+            pass
+    return os.open(path, flags)
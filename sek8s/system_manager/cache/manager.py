@@ -3,19 +3,39 @@
 from __future__ import annotations
 
 import asyncio
+import contextlib
 import os
 import shutil
+import stat
+import threading
 import time
 from pathlib import Path
 from typing import Optional
 
-from huggingface_hub import scan_cache_dir, snapshot_download
 from loguru import logger
 
 from sek8s.config import cache_config
 
-from .models import CacheChuteStatusEnum, ChuteSnapshot, CleanupResult
-from .util import fetch_hf_info, fetch_repo_total_size, verify_cache
+from .accounting import UsageTracker
+from .blobstore import get_blob_store, iter_chute_blobs, share_snapshot
+from .download import (
+    CACHE_FILE_MODE,
+    INCOMPLETE_SUFFIX,
+    DownloadProgress,
+    download_snapshot,
+    repair_blob,
+    resolve_remote_files,
+)
+from .events import CacheEventBus, status_event
+from .eviction import AccessStats, disk_usage, eviction_score, eviction_target
+from .models import CacheChuteStatusEnum, ChuteSnapshot, CleanupResult, DownloadPriority
+from .prewarm import PrewarmProgress, Prewarmer, SnapshotFile, available_memory, resident_bytes, snapshot_files
+from .reservation import SpaceLedger
+from .scheduler import DownloadScheduler, Throttle
+from .state import EntryState, load_state, save_state
+from .tensor_index import TensorIndex
+from .util import close_validator_session, fetch_hf_info, fetch_repo_info, fetch_repo_total_size, verify_cache
+from .verify import ContentMismatch, VerificationProgress
 
 CACHE_COMPLETE_MARKER = ".cache_complete"
 CACHE_STALE_MARKER = ".cache_stale"
@@ -35,6 +55,7 @@ class HuggingFaceSnapshot:
         repo_id: str = "",
         revision: Optional[str] = None,
         *,
+        tracker: UsageTracker,
         externally_managed: bool = False,
     ):
         self.chute_id = chute_id
@@ -46,8 +67,41 @@ class HuggingFaceSnapshot:
         self._started_at: Optional[float] = None
         self._initial_bytes: Optional[int] = None
         self._reconciled: bool = False
-        self._scan_cache: Optional[tuple[int, Optional[str], Optional[str], Optional[float]]] = None
-        self._scan_cache_at: float = 0.0
+        self.reconciled_at: Optional[float] = None
+        self.access = AccessStats()
+        self._tracker = tracker  # the manager's, so inotify events reach this entry
+        self.verification: Optional[VerificationProgress] = None
+        self.download: Optional[DownloadProgress] = None
+        self.prewarm: Optional[PrewarmProgress] = None
+        self._prewarm_task: Optional[asyncio.Task] = None
+        self.priority: DownloadPriority = DownloadPriority.NORMAL
+        self._scheduler: Optional[DownloadScheduler] = None
+
+    @classmethod
+    def from_state(cls, state: EntryState, *, tracker: UsageTracker) -> "HuggingFaceSnapshot":
+        """Restore a persisted entry; it still needs reconciliation before it is trusted."""
+        snap = cls(
+            chute_id=state.chute_id,
+            repo_id=state.repo_id,
+            revision=state.revision,
+            externally_managed=state.externally_managed,
+            tracker=tracker,
+        )
+        snap.reconciled_at = state.reconciled_at
+        snap.access = AccessStats(state.hits, state.last_access, state.lease_until)
+        return snap
+
+    def to_state(self) -> EntryState:
+        return EntryState(
+            chute_id=self.chute_id,
+            repo_id=self.repo_id,
+            revision=self.revision,
+            externally_managed=self.externally_managed,
+            reconciled_at=self.reconciled_at,
+            hits=self.access.hits,
+            last_access=self.access.last_access,
+            lease_until=self.access.lease_until,
+        )
 
     # ------------------------------------------------------------------
     # Path helpers
@@ -65,6 +119,18 @@ class HuggingFaceSnapshot:
     def is_present_on_disk(self) -> bool:
         return self.hub_path.exists() and any(self.hub_path.glob("models--*"))
 
+    def _snapshot_dir(self) -> Optional[Path]:
+        """On-disk snapshot directory of repo_id/revision (resolving branch refs), if any."""
+        if not self.repo_id or not self.revision:
+            return None
+        repo_dir = self.hub_path / f"models--{self.repo_id.replace('/', '--')}"
+        revision = self.revision
+        ref = repo_dir / "refs" / revision
+        if ref.is_file():
+            revision = ref.read_text(encoding="utf-8").strip()
+        snapshot_dir = repo_dir / "snapshots" / revision
+        return snapshot_dir if snapshot_dir.is_dir() else None
+
     # ------------------------------------------------------------------
     # Status / progress
     # ------------------------------------------------------------------
@@ -73,6 +139,22 @@ class HuggingFaceSnapshot:
     def is_in_progress(self) -> bool:
         return self._task is not None and not self._task.done()
 
+    def in_use(self, now: float) -> bool:
+        """True while a pod holds a lease or the model was loaded within the minimum idle time."""
+        if self.access.leased(now):
+            return True
+        last = self.access.last_access
+        return last is not None and now - last < cache_config.eviction_min_idle_seconds
+
+    def observe_atime(self, atime: Optional[float]) -> None:
+        """Count a blob read (newer atime) as an access; the first observation only sets the baseline."""
+        if atime is None:
+            return
+        if self.access.last_access is None:
+            self.access.last_access = atime
+        elif atime > self.access.last_access:
+            self.access.record(atime)
+
     @property
     def needs_reconciliation(self) -> bool:
         """True when this entry should be (re-)verified against the validator."""
@@ -109,42 +191,56 @@ class HuggingFaceSnapshot:
 
     @property
     def size_bytes(self) -> Optional[int]:
+        """Blob bytes on disk from the incremental tally (last known value; O(1)).
+
+        The manager primes the tally of every entry it finds on disk, so this is
+        not 0 for an entry whose tally was never read asynchronously.
+        """
         if not self.hub_path.exists():
             return None
-        try:
-            info = scan_cache_dir(cache_dir=str(self.hub_path))
-            return info.size_on_disk
-        except Exception:
-            return None
+        return self._tracker.usage(self.chute_id).size_bytes
+
+    @property
+    def bytes_allocated(self) -> int:
+        """Bytes the current download session has allocated on the cache filesystem.
+
+        The chunked engine reports its preallocations; for ``snapshot_download``
+        the blob tally's growth since the download started is used.
+        """
+        if self.download is not None and self.download.bytes_total > 0:
+            return self.download.bytes_allocated
+        return max(0, (self.size_bytes or 0) - (self._initial_bytes or 0))
 
     @property
     def percent_complete(self) -> Optional[float]:
-        if not self.is_in_progress or self._total_bytes is None or self._total_bytes <= 0:
+        if not self.is_in_progress:
             return None
-        size = self.size_bytes
-        if size is not None:
-            return min(100.0, max(0.0, 100.0 * size / self._total_bytes))
-        return None
+        if self.download is not None and self.download.bytes_total > 0:
+            return self.download.percent_complete
+        if self._total_bytes is None or self._total_bytes <= 0:
+            return None
+        return min(100.0, max(0.0, 100.0 * (self.size_bytes or 0) / self._total_bytes))
 
     @property
     def download_rate(self) -> Optional[float]:
         """Average bytes/sec since this download session started."""
-        if not self.is_in_progress or self._started_at is None:
+        if not self.is_in_progress:
             return None
-        elapsed = time.monotonic() - self._started_at
-        if elapsed <= 0:
+        if self.download is not None and self.download.bytes_total > 0:
+            return self.download.throughput
+        if self._started_at is None:
             return None
-        size = self.size_bytes
-        if size is None:
-            return None
-        downloaded = size - (self._initial_bytes or 0)
-        if downloaded <= 0:
+        elapsed = time.monotonic() - self._started_at
+        downloaded = (self.size_bytes or 0) - (self._initial_bytes or 0)
+        if elapsed <= 0 or downloaded <= 0:
             return None
         return downloaded / elapsed
 
     @property
     def eta_seconds(self) -> Optional[float]:
         """Estimated seconds remaining based on current download rate."""
+        if self.is_in_progress and self.download is not None and self.download.bytes_total > 0:
+            return self.download.eta_seconds
         rate = self.download_rate
         if rate is None or rate <= 0 or self._total_bytes is None:
             return None
@@ -154,89 +250,71 @@ class HuggingFaceSnapshot:
         return remaining / rate
 
     # ------------------------------------------------------------------
-    # HF cache scanning
+    # Disk usage
     # ------------------------------------------------------------------
 
-    @property
-    def _scan_ttl(self) -> float:
-        """Shorter TTL while files are changing, longer once stable."""
-        return 30.0 if self.is_in_progress else 60.0
-
-    async def _scan_hub(self) -> tuple[int, Optional[str], Optional[str], Optional[float]]:
-        """Scan HF cache directory off the event loop.
+    async def _read_usage(self) -> tuple[int, Optional[str], Optional[str], Optional[float]]:
+        """Return ``(size_bytes, repo_id, revision, last_accessed)`` from the usage tally.
 
-        Returns ``(size_bytes, repo_id, revision, last_accessed)``
-        derived from a single ``scan_cache_dir`` call run in a thread.
-        Results are cached per-instance; TTL varies by download status.
+        The tally is kept current by inotify; it is only rebuilt (in a thread)
+        when marked dirty or, without inotify, when older than the rescan interval.
         """
-        now = time.monotonic()
-        if self._scan_cache is not None and (now - self._scan_cache_at) < self._scan_ttl:
-            return self._scan_cache
-
         if not self.hub_path.exists():
             return (0, None, None, None)
         try:
-            info = await asyncio.to_thread(scan_cache_dir, cache_dir=str(self.hub_path))
-            size = info.size_on_disk
-            repo_id: Optional[str] = None
-            revision: Optional[str] = None
-            last_acc: Optional[float] = None
-            repos = list(info.repos)
-            if repos:
-                repo_id = repos[0].repo_id
-                revisions = list(repos[0].revisions)
-                if revisions:
-                    revision = revisions[0].commit_hash
-                last_acc = max((r.last_accessed for r in repos), default=None)
-            result = (size, repo_id, revision, last_acc)
-            self._scan_cache = result
-            self._scan_cache_at = time.monotonic()
-            return result
-        except Exception:
+            usage = await self._tracker.read(self.chute_id)
+        except OSError:
             return (0, None, None, None)
+        return (usage.size_bytes, usage.repo_id, usage.revision, usage.last_accessed)
 
     # ------------------------------------------------------------------
     # Snapshot
     # ------------------------------------------------------------------
 
     async def snapshot(self) -> ChuteSnapshot:
-        """Point-in-time snapshot backed by a single ``scan_cache_dir`` call."""
-        size, scan_repo_id, scan_revision, last_acc = await self._scan_hub()
-        status = self.status
-        pct = None
-        rate = None
-        eta = None
-        if self.is_in_progress and self._total_bytes and self._total_bytes > 0 and size:
-            pct = min(100.0, max(0.0, 100.0 * size / self._total_bytes))
-            if self._started_at is not None:
-                elapsed = time.monotonic() - self._started_at
-                downloaded = size - (self._initial_bytes or 0)
-                if elapsed > 0 and downloaded > 0:
-                    rate = downloaded / elapsed
-                    remaining = self._total_bytes - size
-                    eta = remaining / rate if remaining > 0 else 0.0
+        """Point-in-time snapshot read from counters (usage tally and download progress)."""
+        size, scan_repo_id, scan_revision, last_acc = await self._read_usage()
         return ChuteSnapshot(
             chute_id=self.chute_id,
             repo_id=self.repo_id or scan_repo_id or "",
             revision=self.revision or scan_revision,
-            status=status,
+            status=self.status,
             size_bytes=size,
-            percent_complete=pct,
-            download_rate=rate,
-            eta_seconds=eta,
+            # The chunked engine preallocates blobs, so progress comes from its byte counters
+            percent_complete=self.percent_complete,
+            download_rate=self.download_rate,
+            eta_seconds=self.eta_seconds,
             last_accessed=last_acc,
             error=self.error,
+            verification=self.verification,
+            priority=self.priority if self.is_in_progress else None,
+            queue_position=self._scheduler.queue_position(self.chute_id) if self._scheduler else None,
+            access_count=self.access.hits,
+            lease_until=self.access.lease_until,
         )
 
     # ------------------------------------------------------------------
     # Download lifecycle
     # ------------------------------------------------------------------
 
-    async def start_download(self, repo_id: str, revision: str) -> None:
-        """Prepare directories and launch the download task."""
+    async def start_download(
+        self,
+        repo_id: str,
+        revision: str,
+        *,
+        scheduler: Optional[DownloadScheduler] = None,
+        priority: DownloadPriority = DownloadPriority.NORMAL,
+    ) -> None:
+        """Prepare directories and launch the download task.
+
+        With a ``scheduler`` the transfer waits for a slot and shares bandwidth
+        with other chutes; verification runs after the slot is released.
+        """
         self.repo_id = repo_id
         self.revision = revision
-        self._scan_cache = None
+        self.priority = priority
+        self._scheduler = scheduler
+        self.download = None
 
         self.path.mkdir(parents=True, exist_ok=True)
         os.chmod(self.path, 0o2775)
@@ -247,51 +325,67 @@ class HuggingFaceSnapshot:
         if total_bytes > 0:
             self._total_bytes = total_bytes
 
-        self._initial_bytes = self.size_bytes or 0
+        self._initial_bytes = (await self._read_usage())[0]
         self._started_at = time.monotonic()
         self._task = asyncio.create_task(self._run_download())
         self._task.add_done_callback(self._on_task_done)
 
     def _on_task_done(self, task: asyncio.Task) -> None:
-        """Invalidate scan cache so the next snapshot reflects final state."""
-        self._scan_cache = None
+        """Invalidate the usage tally so the next snapshot reflects final state."""
+        self._tracker.invalidate(self.chute_id)
         if not task.cancelled():
             task.exception()
 
     @staticmethod
     def _chmod_tree(path: Path, mode: int) -> None:
-        """Recursively chmod path and its contents so group can write."""
+        """Recursively chmod path and its contents so group can write.
+
+        Paths that already have ``mode`` are left alone: chmod bumps ctime, which
+        would invalidate the verification manifests of every chute sharing a blob.
+        """
         try:
-            for p in path.rglob("*"):
+            for p in [*path.rglob("*"), path]:
                 try:
-                    os.chmod(p, mode)
+                    if stat.S_IMODE(os.stat(p).st_mode) != mode:
+                        os.chmod(p, mode)
                 except OSError:
                     pass
-            os.chmod(path, mode)
         except OSError:
             pass
 
     async def _run_download(self) -> None:
-        """Execute snapshot_download, verify, chmod, and write markers."""
-        hub_cache_dir = str(self.hub_path)
+        """Download, chmod, verify, and write markers.
+
+        Download failures keep partial blobs and chunk checkpoints so a retry
+        resumes; only a verification failure that repair cannot fix removes
+        the chute directory.
+        """
         try:
-            def do_download() -> str:
-                return snapshot_download(
-                    repo_id=self.repo_id,
-                    revision=self.revision,
-                    cache_dir=hub_cache_dir,
-                    local_dir_use_symlinks=True,
+            files = resolve_remote_files(await fetch_repo_info(self.repo_id, self.revision))
+
+            async def fetch(throttle: Optional[Throttle] = None) -> None:
+                self.download = DownloadProgress()
+                await download_snapshot(
+                    self.repo_id, self.revision, self.path, files, progress=self.download, throttle=throttle
                 )
 
-            await asyncio.to_thread(do_download)
+            if self._scheduler is None:
+                await fetch()
+            else:
+                # snapshot_download runs in a thread that cannot be stopped, so only
+                # the resumable chunked engine may be preempted
+                await self._scheduler.run(self.chute_id, self.priority, fetch, preemptible=files is not None)
+        except Exception:
+            logger.exception("Download failed for chute_id={} (partial data kept for resume)", self.chute_id)
+            raise
 
-            await verify_cache(
-                repo_id=self.repo_id,
-                revision=self.revision,
-                cache_dir=str(self.path),
-            )
+        try:
+            # Fix permissions first so the verification manifest records the final file state
+            await asyncio.to_thread(self._chmod_tree, self.path, CACHE_FILE_MODE)
 
-            self._chmod_tree(self.path, 0o2775)
+            await self._verify(self.repo_id, self.revision)
+            await self._share_blobs()
+            await self._index_tensors(self.repo_id, self.revision)
 
             (self.path / CACHE_COMPLETE_MARKER).write_text(
                 f"{self.repo_id}\n{self.revision or 'main'}", encoding="utf-8"
@@ -300,10 +394,15 @@ class HuggingFaceSnapshot:
             if stale_marker.exists():
                 stale_marker.unlink()
         except Exception:
-            logger.exception("Download failed for chute_id={}", self.chute_id)
+            logger.exception("Verification failed for chute_id={}", self.chute_id)
             try:
                 if self.path.exists():
+                    store = get_blob_store()
+                    shared = store.shared_entries(self.path) if store else []
                     shutil.rmtree(self.path)
+                    if shared:
+                        # Bytes linked from the store failed verification; never hand them out again
+                        store.evict(shared)
                     logger.info("Cleaned up cache dir for chute_id={} after failure", self.chute_id)
             except OSError as cleanup_err:
                 logger.warning(
@@ -311,10 +410,119 @@ class HuggingFaceSnapshot:
                 )
             raise
 
+        if self.priority == DownloadPriority.URGENT and cache_config.prewarm_after_urgent_download:
+            # A pod is waiting for this model; have it in memory before it starts loading
+            try:
+                await self.start_prewarm()
+            except (ValueError, OSError) as e:
+                logger.warning("Could not prewarm {} after download: {}", self.chute_id, e)
+
+    async def _share_blobs(self) -> None:
+        """Deduplicate this (verified) snapshot's blobs through the node-wide blob store.
+
+        Only content-verified snapshots are shared; with name/size-only
+        verification a blob's name is not proof of its content.
+        """
+        store = get_blob_store()
+        if store is None or not cache_config.verify_content or not self.repo_id or not self.revision:
+            return
+        try:
+            adopted, saved = await asyncio.to_thread(
+                share_snapshot, store, self.path, self.repo_id, self.revision
+            )
+        except OSError as e:
+            logger.warning("Could not share blobs of {}: {}", self.chute_id, e)
+            return
+        if saved:
+            logger.info("Shared {} blobs of {} via blob store, {} bytes deduplicated", adopted, self.chute_id, saved)
+
     def cancel_download(self) -> None:
         if self._task is not None and not self._task.done():
             self._task.cancel()
 
+    # ------------------------------------------------------------------
+    # Page cache
+    # ------------------------------------------------------------------
+
+    @property
+    def is_prewarming(self) -> bool:
+        return self._prewarm_task is not None and not self._prewarm_task.done()
+
+    async def start_prewarm(self, budget: Optional[int] = None) -> PrewarmProgress:
+        """Start reading the snapshot into the page cache; returns the running prewarm if any.
+
+        Raises ValueError when there is no snapshot on disk.
+        """
+        if self.is_prewarming:
+            return self.prewarm
+        snapshot_dir = self._snapshot_dir()
+        if snapshot_dir is None:
+            raise ValueError("No snapshot on disk to prewarm")
+        if budget is None:
+            budget = int(cache_config.prewarm_budget_gb * 1024 ** 3) or available_memory() // 2
+        files = await asyncio.to_thread(snapshot_files, snapshot_dir)
+        progress = self.prewarm = PrewarmProgress()
+        self._prewarm_task = asyncio.create_task(self._run_prewarm(files, budget, progress))
+        self._prewarm_task.add_done_callback(lambda task: self._on_prewarm_done(task, progress))
+        return progress
+
+    @staticmethod
+    def _on_prewarm_done(task: asyncio.Task, progress: PrewarmProgress) -> None:
+        # A task cancelled before it started never reached the prewarmer
+        if task.cancelled():
+            progress.cancelled = True
+            if progress.finished_at is None:
+                progress.finished_at = time.monotonic()
+
+    async def _run_prewarm(self, files: list[SnapshotFile], budget: int, progress: PrewarmProgress) -> None:
+        cancel = threading.Event()
+        prewarmer = Prewarmer(workers=cache_config.prewarm_workers)
+        try:
+            await asyncio.to_thread(prewarmer.prewarm, files, budget, progress, cancel)
+        except asyncio.CancelledError:
+            # to_thread cannot stop the readers on its own
+            cancel.set()
+            raise
+        except OSError as e:
+            progress.error = str(e)
+            logger.warning("Prewarm of {} failed: {}", self.chute_id, e)
+
+    def cancel_prewarm(self) -> bool:
+        if not self.is_prewarming:
+            return False
+        self._prewarm_task.cancel()
+        return True
+
+    async def residency(self) -> list[tuple[SnapshotFile, int]]:
+        """Snapshot files with the bytes of each currently in the page cache.
+
+        Paths that resolve to the same blob report the same bytes; each blob is
+        measured once.
+        """
+        snapshot_dir = self._snapshot_dir()
+        if snapshot_dir is None:
+            return []
+
+        def _scan() -> list[tuple[SnapshotFile, int]]:
+            measured: dict[Path, int] = {}
+            result = []
+            for f in snapshot_files(snapshot_dir):
+                if f.path not in measured:
+                    try:
+                        measured[f.path] = resident_bytes(f.path)
+                    except OSError:
+                        measured[f.path] = 0
+                result.append((f, measured[f.path]))
+            return result
+
+        return await asyncio.to_thread(_scan)
+
+    async def tensor_index(self) -> Optional[TensorIndex]:
+        """Tensor index of the current snapshot, or None until one has been built."""
+        if not self.repo_id or not self.revision:
+            return None
+        return await asyncio.to_thread(TensorIndex.load, self.path, self.repo_id, self.revision)
+
     # ------------------------------------------------------------------
     # Identity & reconciliation
     # ------------------------------------------------------------------
@@ -335,21 +543,36 @@ class HuggingFaceSnapshot:
             self.repo_id = info.repo_id
             self.revision = info.revision or "main"
 
+    def _set_marker(self, marker: Optional[str], content: str = "") -> None:
+        """Make ``marker`` the only status marker present (None removes both)."""
+        for name in (CACHE_COMPLETE_MARKER, CACHE_STALE_MARKER):
+            path = self.path / name
+            if name == marker:
+                path.write_text(content, encoding="utf-8")
+            elif path.exists():
+                path.unlink()
+
+    def _mark_reconciled(self) -> None:
+        self._reconciled = True
+        self.reconciled_at = time.time()
+
     async def reconcile(self) -> None:
         """Verify cache against the validator's current revision and set markers.
 
+        Existing markers are kept while verifying, so an entry restored at
+        startup keeps reporting its last known status until the outcome is in.
         Outcome determines both disk markers and the ``_reconciled`` flag:
 
         * **PRESENT** — all files verified.  ``_reconciled = True``.
-        * **STALE** — hash or size mismatch (wrong revision on disk).
-          ``_reconciled = True`` (definitive).
+        * **STALE** — hash or size mismatch that range repair could not fix
+          (e.g. wrong revision on disk).  ``_reconciled = True`` (definitive).
         * **INCOMPLETE** — files are missing (download may still be in
           flight from another process).  ``_reconciled`` stays ``False``
           so the next :meth:`CacheManager.sync_from_disk` re-checks.
         * **Validator unreachable** — ``_reconciled`` stays ``False``.
         """
         if not self.is_present_on_disk:
-            self._reconciled = True
+            self._mark_reconciled()
             logger.debug("Reconcile {}: nothing on disk, marking reconciled", self.chute_id)
             return
 
@@ -370,34 +593,33 @@ class HuggingFaceSnapshot:
             self.chute_id, repo_id, revision[:12],
             self.repo_id or "<unset>", (self.revision or "<unset>")[:12],
         )
+        if (repo_id, revision) != (self.repo_id, self.revision):
+            # Markers describe another snapshot; do not report them while verifying this one
+            self._set_marker(None)
         self.repo_id = repo_id
         self.revision = revision
 
-        complete_marker = self.path / CACHE_COMPLETE_MARKER
-        stale_marker = self.path / CACHE_STALE_MARKER
-
-        # Clear any previous markers so we always start from a clean state.
-        if complete_marker.exists():
-            complete_marker.unlink()
-        if stale_marker.exists():
-            stale_marker.unlink()
-
         logger.info(
             "Verifying cache for {}: repo={}, rev={}, path={}",
             self.chute_id, repo_id, revision[:12], self.path,
         )
         try:
-            result = await verify_cache(repo_id=repo_id, revision=revision, cache_dir=str(self.path))
-            complete_marker.write_text(f"{repo_id}\n{revision}", encoding="utf-8")
-            self._reconciled = True
+            result = await self._verify(repo_id, revision)
+            await self._share_blobs()
+            if await asyncio.to_thread(TensorIndex.load, self.path, repo_id, revision) is None:
+                await self._index_tensors(repo_id, revision)
+            self._set_marker(CACHE_COMPLETE_MARKER, f"{repo_id}\n{revision}")
+            self._mark_reconciled()
             logger.info(
-                "Reconciled {}: PRESENT (repo={}, rev={}, verified={}, skipped={})",
+                "Reconciled {}: PRESENT (repo={}, rev={}, verified={}, skipped={}, hashed={}, unchanged={})",
                 self.chute_id, repo_id, revision[:12],
                 result.get("verified", 0), result.get("skipped", 0),
+                result.get("hashed", 0), result.get("unchanged", 0),
             )
         except ValueError as e:
             error_msg = str(e)
             if "Missing file" in error_msg or "not found" in error_msg:
+                self._set_marker(None)
                 logger.info(
                     "Reconciled {}: INCOMPLETE — repo={}, rev={}, reason={}",
                     self.chute_id, repo_id, revision[:12], error_msg,
@@ -408,8 +630,8 @@ class HuggingFaceSnapshot:
                     self.chute_id, repo_id, revision[:12], error_msg,
                 )
             else:
-                stale_marker.write_text(f"{repo_id}\n{revision}\n{error_msg}", encoding="utf-8")
-                self._reconciled = True
+                self._set_marker(CACHE_STALE_MARKER, f"{repo_id}\n{revision}\n{error_msg}")
+                self._mark_reconciled()
                 logger.warning(
                     "Reconciled {}: STALE — repo={}, rev={}, reason={}",
                     self.chute_id, repo_id, revision[:12], error_msg,
@@ -420,10 +642,90 @@ class HuggingFaceSnapshot:
                 self.chute_id, repo_id, revision[:12], e,
             )
 
-    async def delete(self) -> None:
+    async def _index_tensors(self, repo_id: str, revision: str) -> None:
+        """Write the safetensors tensor index of the verified snapshot; failures are logged, not raised."""
+        if not cache_config.tensor_index_enabled:
+            return
+        snapshot_dir = self._snapshot_dir()
+        if snapshot_dir is None:
+            return
+
+        def _build() -> TensorIndex:
+            index = TensorIndex.build(snapshot_dir, repo_id, revision)
+            index.save(self.path)
+            return index
+
+        try:
+            index = await asyncio.to_thread(_build)
+        except (OSError, ValueError, KeyError, TypeError) as e:
+            logger.warning("Could not index tensors of {}: {}", self.chute_id, e)
+            return
+        logger.info("Indexed {} tensors in {} files for {}", len(index.tensors), len(index.files), self.chute_id)
+
+    async def _verify(self, repo_id: str, revision: str) -> dict:
+        """``verify_cache``, repairing damaged blobs in place and re-verifying.
+
+        Each mismatching file gets one repair attempt (re-fetching only its
+        damaged Merkle leaves); a file that still mismatches afterwards, or
+        has no Merkle data, fails verification as before.
+        """
+        repaired: set[str] = set()
+        while True:
+            self.verification = VerificationProgress()
+            try:
+                return await verify_cache(
+                    repo_id=repo_id, revision=revision, cache_dir=str(self.path), progress=self.verification
+                )
+            except ContentMismatch as e:
+                if e.rel_path in repaired or not await self._repair(repo_id, revision, e.rel_path):
+                    raise
+                repaired.add(e.rel_path)
+
+    async def _repair(self, repo_id: str, revision: str, rel_path: str) -> bool:
+        if not cache_config.repair_enabled:
+            return False
+        files = resolve_remote_files(await fetch_repo_info(repo_id, revision)) or []
+        remote = next((f for f in files if f.path == rel_path), None)
+        if remote is None:
+            return False
+        try:
+            fetched = await repair_blob(repo_id, revision, self.path, remote)
+        except Exception as e:
+            logger.warning("Repair of {} in {} failed: {}", rel_path, self.chute_id, e)
+            return False
+        if fetched is None:
+            return False
+        self._tracker.invalidate(self.chute_id)
+        logger.info("Repaired {} in {} ({} bytes re-fetched), re-verifying", rel_path, self.chute_id, fetched)
+        return True
+
+    async def delete(self) -> int:
+        """Remove the chute directory; returns the bytes actually freed.
+
+        Blobs still linked by other chutes stay on disk, so only the bytes this
+        chute held exclusively are freed (plus store entries it was the last user of).
+        """
         self.cancel_download()
-        if self.path.exists():
+        self.cancel_prewarm()
+        if not self.path.exists():
+            return 0
+        store = get_blob_store()
+        if store is None:
+            size = (await self._read_usage())[0]
+            await asyncio.to_thread(shutil.rmtree, self.path, ignore_errors=True)
+            self._tracker.forget(self.chute_id)
+            return size
+
+        def _delete() -> int:
+            freed = store.exclusive_bytes(self.path)
+            shared = store.shared_entries(self.path)
             shutil.rmtree(self.path, ignore_errors=True)
+            store.release(shared)
+            return freed
+
+        freed = await asyncio.to_thread(_delete)
+        self._tracker.forget(self.chute_id)
+        return freed
 
 
 # ======================================================================
@@ -435,41 +737,97 @@ class CacheManager:
     """Manages all cached HuggingFace snapshots in memory.
 
     Created once during the application lifespan.  On startup, it scans the
-    cache directory, creates a ``HuggingFaceSnapshot`` per UUID directory found,
-    and runs reconciliation against the validator for each.
+    cache directory, creates a ``HuggingFaceSnapshot`` per UUID directory found
+    (restoring identities from the persisted state file), and reconciles them
+    against the validator in the background with bounded concurrency.
     """
 
     def __init__(self) -> None:
         self._chutes: dict[str, HuggingFaceSnapshot] = {}
         self._lock = asyncio.Lock()
+        self.scheduler = DownloadScheduler.from_config()
         self._last_sync: float = 0.0
         self._sync_cooldown: float = 5.0
+        self.usage = UsageTracker(Path(cache_config.cache_base).resolve())
+        self._reconcile_slots = asyncio.Semaphore(cache_config.reconcile_concurrency)
+        # Entries being reconciled or having a download started; set when released
+        self._busy: dict[str, asyncio.Event] = {}
+        self._background: set[asyncio.Task] = set()
+        self.events = CacheEventBus(self._event_source, interval=cache_config.events_interval)
+        self.reservations = SpaceLedger(headroom=int(cache_config.space_headroom_gb * 1024 ** 3))
+        self._admission = asyncio.Lock()
 
     async def initialize(self) -> None:
-        """Scan disk and reconcile all chute cache directories."""
+        """Load tracked entries from disk and start reconciling them in the background.
+
+        Returns as soon as the chute directories are listed, so queries are
+        answered (from persisted identities and on-disk markers) while the
+        validator round trips and verifications are still running.
+        """
         cache_base = Path(cache_config.cache_base).resolve()
         if not cache_base.exists():
             logger.info("Cache base {} does not exist, skipping initialization", cache_base)
             return
+        self.usage.start()
 
+        saved = load_state(cache_base)
         chute_dirs = [
             item for item in cache_base.iterdir()
             if item.is_dir() and len(item.name) == 36
         ]
-        if not chute_dirs:
-            logger.info("No chute cache directories found")
-            return
-
-        logger.info("Initializing cache manager with {} directories...", len(chute_dirs))
         for item in chute_dirs:
             hub = item / "hub"
             if not hub.exists() or not any(hub.glob("models--*")):
                 continue
-            chute = HuggingFaceSnapshot(chute_id=item.name)
-            await chute.reconcile()
+            state = saved.get(item.name)
+            if state is not None:
+                chute = HuggingFaceSnapshot.from_state(state, tracker=self.usage)
+            else:
+                chute = HuggingFaceSnapshot(chute_id=item.name, tracker=self.usage)
             self._chutes[item.name] = chute
+        await self.usage.prime(self._chutes)
 
-        logger.info("Cache manager initialized: {} chutes loaded", len(self._chutes))
+        logger.info(
+            "Cache manager initialized: {} chutes loaded ({} from saved state), reconciling in background",
+            len(self._chutes), sum(1 for c in self._chutes if c in saved),
+        )
+        self._spawn(self._startup_reconcile(list(self._chutes.values())))
+        if cache_config.eviction_enabled:
+            self._spawn(self._eviction_loop())
+
+    async def _startup_reconcile(self, chutes: list[HuggingFaceSnapshot]) -> None:
+        store = get_blob_store()
+        if store is not None:
+            # Drop entries whose last chute went away while we were not running
+            await asyncio.to_thread(store.gc)
+        started = time.monotonic()
+        await self._reconcile_many(chutes)
+        logger.info("Startup reconciliation of {} chutes took {:.1f}s", len(chutes), time.monotonic() - started)
+
+    async def shutdown(self) -> None:
+        """Stop background work, persist state and release inotify watches and HTTP connections."""
+        for task in list(self._background):
+            task.cancel()
+        await asyncio.gather(*self._background, return_exceptions=True)
+        await self.events.close()
+        await self.save_state()
+        self.usage.stop()
+        await close_validator_session()
+
+    def _spawn(self, coro) -> asyncio.Task:
+        """Run ``coro`` in the background, keeping a reference until it finishes."""
+        task = asyncio.create_task(coro)
+        self._background.add(task)
+        task.add_done_callback(self._background.discard)
+        return task
+
+    async def save_state(self) -> None:
+        cache_base = Path(cache_config.cache_base).resolve()
+        if not cache_base.exists():
+            return
+        async with self._lock:
+            entries = [c.to_state() for c in self._chutes.values()]
+        await asyncio.to_thread(save_state, cache_base, entries)
 
     async def sync_from_disk(self) -> None:
         """Discover new on-disk directories and reconcile pending entries.
@@ -487,14 +845,19 @@ class CacheManager:
         cache_base = Path(cache_config.cache_base).resolve()
         if not cache_base.exists():
             return
+        # No-op once started; covers a cache base created after initialize()
+        self.usage.start()
 
-        for snap in self._discover_new_entries(cache_base):
+        new_snaps = self._discover_new_entries(cache_base)
+        await self.usage.prime(snap.chute_id for snap in new_snaps)
+        for snap in new_snaps:
             await snap.fetch_identity()
             async with self._lock:
                 if snap.chute_id not in self._chutes:
                     self._chutes[snap.chute_id] = snap
 
-        await self._reconcile_pending()
+        # Verification can take minutes; queries report last known status meanwhile
+        self._spawn(self._reconcile_pending())
 
     def _discover_new_entries(self, cache_base: Path) -> list[HuggingFaceSnapshot]:
         """Return new on-disk chute directories not yet tracked by the manager."""
@@ -508,7 +871,9 @@ class CacheManager:
             hub = item / "hub"
             if not hub.exists() or not any(hub.glob("models--*")):
                 continue
-            new_snaps.append(HuggingFaceSnapshot(chute_id=item.name, externally_managed=True))
+            new_snaps.append(
+                HuggingFaceSnapshot(chute_id=item.name, externally_managed=True, tracker=self.usage)
+            )
         return new_snaps
 
     async def _reconcile_pending(self) -> None:
@@ -520,11 +885,208 @@ class CacheManager:
         pending: list[HuggingFaceSnapshot] = []
         async with self._lock:
             for snap in self._chutes.values():
-                if snap.needs_reconciliation:
+                if snap.needs_reconciliation and snap.chute_id not in self._busy:
                     pending.append(snap)
 
-        for snap in pending:
-            await snap.reconcile()
+        await self._reconcile_many(pending)
+
+    async def _reconcile_many(self, snaps: list[HuggingFaceSnapshot]) -> None:
+        """Reconcile ``snaps`` at most ``reconcile_concurrency`` at a time, each under a deadline.
+
+        An entry that misses its deadline keeps its markers and stays
+        unreconciled, so the next :meth:`sync_from_disk` tries it again.
+        """
+
+        async def _one(snap: HuggingFaceSnapshot) -> None:
+            if snap.chute_id in self._busy:
+                return
+            try:
+                async with self._claim(snap.chute_id), self._reconcile_slots:
+                    # A download may have started while this entry was queued
+                    if not snap.needs_reconciliation:
+                        return
+                    await asyncio.wait_for(snap.reconcile(), cache_config.reconcile_timeout)
+            except asyncio.TimeoutError:
+                logger.warning(
+                    "Reconciliation of {} exceeded {}s; deferred to next sync",
+                    snap.chute_id, cache_config.reconcile_timeout,
+                )
+
+        if not snaps:
+            return
+        await asyncio.gather(*(_one(s) for s in snaps))
+        await self.save_state()
+
+    @contextlib.asynccontextmanager
+    async def _claim(self, chute_id: str):
+        """Exclusive use of one entry by a reconciliation or a starting download."""
+        while (busy := self._busy.get(chute_id)) is not None:
+            await busy.wait()
+        done = self._busy[chute_id] = asyncio.Event()
+        try:
+            yield
+        finally:
+            del self._busy[chute_id]
+            done.set()
+
+    async def start_download(
+        self,
+        chute: HuggingFaceSnapshot,
+        repo_id: str,
+        revision: str,
+        priority: DownloadPriority = DownloadPriority.NORMAL,
+    ) -> None:
+        """Start a download for ``chute`` through the global scheduler.
+
+        The bytes the download still has to write are reserved first; if free
+        space minus outstanding reservations does not cover them, idle entries
+        are evicted to make room, and InsufficientSpace is raised if that is
+        not enough.  The reservation is released when the download task ends.
+        A reconciliation running on ``chute`` is waited for, and none starts
+        until the download task exists.
+        """
+        async with self._claim(chute.chute_id):
+            if cache_config.space_reservation_enabled:
+                await self._reserve(chute, repo_id, revision)
+            try:
+                await chute.start_download(repo_id, revision, scheduler=self.scheduler, priority=priority)
+            except BaseException:
+                self.reservations.release(chute.chute_id)
+                raise
+        if chute.chute_id in self.reservations:
+            chute._task.add_done_callback(lambda _: self.reservations.release(chute.chute_id))
+        self.events.notify()
+        await self.save_state()
+
+    async def _space_needed(self, chute: HuggingFaceSnapshot, repo_id: str, revision: str) -> int:
+        """Bytes a download into ``chute`` still has to allocate.
+
+        Blobs already in the chute's hub tree and blobs that can be hardlinked
+        from the blob store need nothing; partial blobs of an earlier attempt
+        are already preallocated up to their current size.  If the repo info
+        cannot be fetched, nothing is reserved and the download proceeds as it
+        would without reservations (it fetches the info again itself).
+        """
+        try:
+            repo_info = await fetch_repo_info(repo_id, revision)
+        except Exception as e:
+            logger.warning("Could not size the download for {} ({}); reserving nothing", chute.chute_id, e)
+            return 0
+        files = resolve_remote_files(repo_info)
+        if not files:
+            return await fetch_repo_total_size(repo_id, revision) if repo_info else 0
+        blobs_dir = chute.hub_path / f"models--{repo_id.replace('/', '--')}" / "blobs"
+        store = get_blob_store()
+
+        def _needed() -> int:
+            needed = 0
+            seen: set[str] = set()
+            for f in files:
+                if f.blob in seen or (blobs_dir / f.blob).exists():
+                    continue
+                seen.add(f.blob)
+                if store is not None and store.refcount(f.blob, f.algorithm) > 0:
+                    continue
+                try:
+                    partial = (blobs_dir / f"{f.blob}{INCOMPLETE_SUFFIX}").stat().st_size
+                except FileNotFoundError:
+                    partial = 0
+                needed += max(0, f.size - partial)
+            return needed
+
+        return await asyncio.to_thread(_needed)
+
+    def _allocated(self, chute_id: str) -> int:
+        chute = self._chutes.get(chute_id)
+        return chute.bytes_allocated if chute is not None else 0
+
+    async def _reserve(self, chute: HuggingFaceSnapshot, repo_id: str, revision: str) -> None:
+        needed = await self._space_needed(chute, repo_id, revision)
+        cache_base = Path(cache_config.cache_base).resolve()
+        async with self._admission:
+            free = (await asyncio.to_thread(disk_usage, cache_base)).available
+            shortfall = needed - self.reservations.available(free, self._allocated)
+            if shortfall > 0 and cache_config.eviction_enabled:
+                logger.info("Evicting {} bytes to make room for {}", shortfall, chute.chute_id)
+                await self.evict(shortfall, exclude=frozenset({chute.chute_id}))
+                free = (await asyncio.to_thread(disk_usage, cache_base)).available
+            self.reservations.reserve(chute.chute_id, needed, free, self._allocated)
+        logger.debug("Reserved {} bytes for {}", needed, chute.chute_id)
+
+    def escalate(self, chute: HuggingFaceSnapshot, priority: DownloadPriority) -> None:
+        """Raise the priority of an in-flight download (e.g. a pod now needs it)."""
+        if priority.rank > chute.priority.rank and self.scheduler.escalate(chute.chute_id, priority):
+            chute.priority = priority
+            logger.info("Escalated download {} to {}", chute.chute_id, priority.value)
+
+    async def touch(self, chute: HuggingFaceSnapshot, lease_seconds: int = 0) -> None:
+        """Record a model load by a pod and optionally lease the entry against eviction."""
+        now = time.time()
+        chute.access.record(now)
+        if lease_seconds:
+            chute.access.lease(now + lease_seconds)
+        await self.save_state()
+
+    async def _eviction_loop(self) -> None:
+        while True:
+            await asyncio.sleep(cache_config.eviction_interval)
+            try:
+                await self.evict_to_watermark()
+            except Exception:
+                logger.exception("Cache eviction pass failed")
+
+    async def evict_to_watermark(self) -> CleanupResult:
+        """Evict the lowest-scoring idle entries until usage is below the low watermark.
+
+        Does nothing while the cache filesystem is below the high watermark.
+        """
+        cache_base = Path(cache_config.cache_base).resolve()
+        usage = await asyncio.to_thread(disk_usage, cache_base)
+        to_free = eviction_target(
+            usage, cache_config.eviction_high_watermark, cache_config.eviction_low_watermark
+        )
+        if not to_free:
+            return CleanupResult(freed_bytes=0, removed_chutes=[])
+        logger.info("Cache at {:.1%} of {} bytes: evicting {} bytes", usage.fraction_used, usage.total, to_free)
+        return await self.evict(to_free)
+
+    async def evict(self, to_free: int, exclude: frozenset[str] = frozenset()) -> CleanupResult:
+        """Evict the lowest-scoring idle entries (never ``exclude``) until ``to_free`` bytes are freed."""
+        now = time.time()
+        half_life = cache_config.eviction_access_half_life_hours * 3600
+        async with self._lock:
+            chutes = [
+                c for c in self._chutes.values()
+                if not c.is_in_progress and c.chute_id not in self._busy and c.chute_id not in exclude
+            ]
+        candidates: list[tuple[float, HuggingFaceSnapshot]] = []
+        for chute in chutes:
+            # Fresh atimes catch loads by pods that never called the touch API
+            self.usage.invalidate(chute.chute_id)
+            size, _, _, last_acc = await chute._read_usage()
+            chute.observe_atime(last_acc)
+            if size == 0 or chute.in_use(now):
+                continue
+            candidates.append((eviction_score(chute.access, size, now, half_life), chute))
+        candidates.sort(key=lambda x: x[0])
+
+        freed = 0
+        removed: list[str] = []
+        for _, chute in candidates:
+            if freed >= to_free:
+                break
+            async with self._lock:
+                if chute.is_in_progress or self._chutes.get(chute.chute_id) is not chute:
+                    continue
+                self._chutes.pop(chute.chute_id)
+            freed += await chute.delete()
+            removed.append(chute.chute_id)
+
+        logger.info("Evicted {} chutes, freed {} of {} bytes", len(removed), freed, to_free)
+        if freed < to_free:
+            logger.warning("Could not free {} bytes; remaining entries are in use", to_free - freed)
+        await self.save_state()
+        return CleanupResult(freed_bytes=freed, removed_chutes=removed)
 
     async def get(self, chute_id: str) -> Optional[HuggingFaceSnapshot]:
         async with self._lock:
@@ -533,7 +1095,7 @@ class CacheManager:
     async def get_or_create(self, chute_id: str) -> HuggingFaceSnapshot:
         async with self._lock:
             if chute_id not in self._chutes:
-                self._chutes[chute_id] = HuggingFaceSnapshot(chute_id=chute_id)
+                self._chutes[chute_id] = HuggingFaceSnapshot(chute_id=chute_id, tracker=self.usage)
             return self._chutes[chute_id]
 
     async def all(self) -> list[HuggingFaceSnapshot]:
@@ -546,11 +1108,50 @@ class CacheManager:
             chutes = list(self._chutes.values())
         return list(await asyncio.gather(*(c.snapshot() for c in chutes)))
 
+    async def verified_blobs(self) -> dict[str, Path]:
+        """Blobs of every verified (present) snapshot by name, as advertised to peers."""
+        async with self._lock:
+            chutes = list(self._chutes.values())
+
+        def _scan() -> dict[str, Path]:
+            blobs: dict[str, Path] = {}
+            for chute in chutes:
+                if chute.status == CacheChuteStatusEnum.PRESENT:
+                    for path in iter_chute_blobs(chute.path):
+                        blobs.setdefault(path.name, path)
+            return blobs
+
+        return await asyncio.to_thread(_scan)
+
+    async def verified_blob(self, blob: str) -> Optional[Path]:
+        """Path of ``blob`` in a verified snapshot, or None; one stat per repo rather than a full scan."""
+        async with self._lock:
+            chutes = list(self._chutes.values())
+
+        def _find() -> Optional[Path]:
+            for chute in chutes:
+                if chute.status != CacheChuteStatusEnum.PRESENT:
+                    continue
+                for blobs_dir in chute.hub_path.glob("models--*/blobs"):
+                    path = blobs_dir / blob
+                    if path.is_file():
+                        return path
+            return None
+
+        return await asyncio.to_thread(_find)
+
+    async def _event_source(self) -> dict[str, dict]:
+        """Status of every chute for the event bus (one sample serves all subscribers)."""
+        await self.sync_from_disk()
+        return {s.chute_id: status_event(s) for s in await self.all_snapshots()}
+
     async def remove(self, chute_id: str) -> bool:
         async with self._lock:
             chute = self._chutes.pop(chute_id, None)
         if chute is not None:
             await chute.delete()
+            self.events.notify()
+            await self.save_state()
             return True
         return False
 
@@ -560,17 +1161,24 @@ class CacheManager:
         max_size_gb: int,
         exclude_pattern: Optional[str] = None,
     ) -> CleanupResult:
-        """Remove cache entries by age and enforce max size; skip in-progress downloads."""
+        """Remove cache entries by age and enforce max size; skip in-progress downloads and leased entries."""
         freed = 0
         removed_list: list[str] = []
         max_size_bytes = max_size_gb * 1024 * 1024 * 1024
         cutoff_time = time.time() - (max_age_days * 24 * 3600)
 
         async with self._lock:
-            eligible = [c for c in self._chutes.values() if not c.is_in_progress]
+            now = time.time()
+            eligible = [
+                c for c in self._chutes.values() if not c.is_in_progress and not c.access.leased(now)
+            ]
 
         async def _scan(chute: HuggingFaceSnapshot):
-            size, scan_repo_id, _, last_acc = await chute._scan_hub()
+            # Fresh atimes catch loads by pods that never called the touch API
+            self.usage.invalidate(chute.chute_id)
+            size, scan_repo_id, _, last_acc = await chute._read_usage()
+            # Age is the latest of a blob atime and a model load recorded by touch()
+            last_acc = max(last_acc or 0.0, chute.access.last_access or 0.0)
             return (chute, size, scan_repo_id, last_acc)
 
         scanned = await asyncio.gather(*(_scan(c) for c in eligible))
@@ -587,14 +1195,18 @@ class CacheManager:
             if last_acc < cutoff_time:
                 async with self._lock:
                     self._chutes.pop(chute.chute_id, None)
-                await chute.delete()
+                freed += await chute.delete()
                 removed_list.append(chute.chute_id)
-                freed += size
 
         removed_set = set(removed_list)
         candidates = [(c, s, la) for c, s, la in candidates if c.chute_id not in removed_set]
 
-        total_now = sum(s for _, s, _ in candidates)
+        store = get_blob_store()
+        if store is not None:
+            # Apparent sizes count blobs shared between chutes once per chute
+            total_now = await asyncio.to_thread(store.unique_bytes, [c.path for c, _, _ in candidates])
+        else:
+            total_now = sum(s for _, s, _ in candidates)
         if total_now > max_size_bytes:
             candidates.sort(key=lambda x: x[1], reverse=True)
             for chute, size, _ in candidates:
@@ -602,9 +1214,11 @@ class CacheManager:
                     break
                 async with self._lock:
                     self._chutes.pop(chute.chute_id, None)
-                await chute.delete()
+                chute_freed = await chute.delete()
                 removed_list.append(chute.chute_id)
-                freed += size
-                total_now -= size
+                freed += chute_freed
+                total_now -= chute_freed
 
+        if removed_list:
+            await self.save_state()
         return CleanupResult(freed_bytes=freed, removed_chutes=removed_list)
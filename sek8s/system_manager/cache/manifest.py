@@ -0,0 +1,125 @@
+"""Cache submodule: persisted per-snapshot verification manifests.
+
+After a successful content verification, every hashed file is recorded with
+its stat tuple (size, inode, mtime, ctime) and verified digest in a sidecar next
+to the chute's marker files.  Later verifications of the same repo/revision
+only re-hash files whose stat tuple changed; expected digests
+still come from the validator, so the sidecar can only let a file skip
+re-hashing, never change what it must hash to.
+"""
+
+from __future__ import annotations
+
+import json
+import os
+import time
+from dataclasses import asdict, dataclass, field
+from pathlib import Path
+
+from loguru import logger
+
+VERIFY_MANIFEST_FILE = ".verify_manifest.json"
+_MANIFEST_VERSION = 1
+
+
+@dataclass
+class ManifestEntry:
+    """Verified state of one snapshot file (stat of the resolved blob)."""
+
+    size: int
+    inode: int
+    mtime_ns: int
+    ctime_ns: int
+    digest: str
+    algorithm: str
+    verified_at: float
+
+    def matches(self, st: os.stat_result, digest: str, algorithm: str) -> bool:
+        # ctime catches in-place writes that restore mtime with utime. Linking a
+        # blob into another chute (see blobstore) also changes it, which costs
+        # a re-hash; share_snapshot re-records the links it makes itself
+        return (
+            self.size == st.st_size
+            and self.inode == st.st_ino
+            and self.mtime_ns == st.st_mtime_ns
+            and self.ctime_ns == st.st_ctime_ns
+            and self.digest == digest
+            and self.algorithm == algorithm
+        )
+
+
+@dataclass
+class VerificationManifest:
+    """All verified files of one (repo_id, revision) snapshot in a chute cache dir."""
+
+    repo_id: str
+    revision: str
+    entries: dict[str, ManifestEntry] = field(default_factory=dict)
+
+    @staticmethod
+    def path_for(cache_dir: Path) -> Path:
+        return Path(cache_dir) / VERIFY_MANIFEST_FILE
+
+    @classmethod
+    def load(cls, cache_dir: Path, repo_id: str, revision: str) -> "VerificationManifest":
+        """Load the sidecar; returns an empty manifest if missing, unreadable, or for another revision."""
+        path = cls.path_for(cache_dir)
+        try:
+            data = json.loads(path.read_text(encoding="utf-8"))
+            if (
+                data.get("version") == _MANIFEST_VERSION
+                and data.get("repo_id") == repo_id
+                and data.get("revision") == revision
+            ):
+                entries = {p: ManifestEntry(**e) for p, e in data.get("entries", {}).items()}
+                return cls(repo_id=repo_id, revision=revision, entries=entries)
+        except FileNotFoundError:
+            pass
+        except (OSError, ValueError, TypeError) as e:
+            logger.warning("Ignoring unreadable verification manifest {}: {}", path, e)
+        return cls(repo_id=repo_id, revision=revision)
+
+    def save(self, cache_dir: Path) -> None:
+        """Atomically write the sidecar (write temp file, then rename)."""
+        path = self.path_for(cache_dir)
+        tmp = path.with_name(f"{path.name}.tmp.{os.getpid()}")
+        data = {
+            "version": _MANIFEST_VERSION,
+            "repo_id": self.repo_id,
+            "revision": self.revision,
+            "entries": {p: asdict(e) for p, e in sorted(self.entries.items())},
+        }
+        try:
+            tmp.write_text(json.dumps(data, separators=(",", ":")), encoding="utf-8")
+            os.replace(tmp, path)
+        except OSError as e:
+            logger.warning("Could not write verification manifest {}: {}", path, e)
+            tmp.unlink(missing_ok=True)
+
+    def is_verified(self, rel_path: str, st: os.stat_result, digest: str, algorithm: str) -> bool:
+        """True if rel_path was verified against digest and is unchanged on disk since."""
+        entry = self.entries.get(rel_path)
+        return entry is not None and entry.matches(st, digest, algorithm)
+
+    def record(self, rel_path: str, st: os.stat_result, digest: str, algorithm: str) -> None:
+        self.entries[rel_path] = ManifestEntry(
+            size=st.st_size,
+            inode=st.st_ino,
+            mtime_ns=st.st_mtime_ns,
+            ctime_ns=st.st_ctime_ns,
+            digest=digest,
+            algorithm=algorithm,
+            verified_at=time.time(),
+        )
+
+    def prune(self, keep: set[str]) -> int:
+        """Drop entries for files no longer in the remote manifest; returns how many."""
+        stale = [rel_path for rel_path in self.entries if rel_path not in keep]
+        for rel_path in stale:
+            del self.entries[rel_path]
+        return len(stale)
+
+    @classmethod
+    def invalidate(cls, cache_dir: Path) -> None:
+        """Remove the sidecar so the next verification re-hashes everything."""
+        cls.path_for(cache_dir).unlink(missing_ok=True)
@@ -0,0 +1,181 @@
+"""Cache submodule: per-blob Merkle manifests for partial repair.
+
+Every blob whose whole-file digest is verified (by the chunked downloader's
+prefix hash or by content verification) also gets the sha256 of each
+fixed-size leaf (64 MiB by default) recorded in a sidecar next to the chute's
+marker files, with the Merkle root over those leaves.  When a blob later
+fails verification, hashing its leaves against the sidecar pinpoints the
+damaged ranges, so only those are fetched again instead of the whole file.
+
+The sidecar only localises damage: a repaired blob is still re-hashed
+against the validator's digest before it counts as verified, so a tampered
+sidecar can at worst make a repair fail.
+"""
+
+from __future__ import annotations
+
+import hashlib
+import json
+import os
+from dataclasses import asdict, dataclass, field
+from pathlib import Path
+from typing import Optional
+
+from loguru import logger
+
+from .fileio import open_noatime
+
+MERKLE_MANIFEST_FILE = ".merkle_manifest.json"
+_MANIFEST_VERSION = 1
+_READ_SIZE = 16 * 1024 * 1024
+
+
+def merkle_root(leaves: list[str]) -> str:
+    """Root of a binary sha256 tree over leaf digests (an odd node is promoted as is)."""
+    level = [bytes.fromhex(leaf) for leaf in leaves] or [hashlib.sha256().digest()]
+    while len(level) > 1:
+        nxt = [hashlib.sha256(level[i] + level[i + 1]).digest() for i in range(0, len(level) - 1, 2)]
+        if len(level) % 2:
+            nxt.append(level[-1])
+        level = nxt
+    return level[0].hex()
+
+
+class LeafHasher:
+    """Incremental sha256 of consecutive ``leaf_size`` ranges of a stream."""
+
+    def __init__(self, leaf_size: int):
+        self.leaf_size = leaf_size
+        self.leaves: list[str] = []
+        self._hasher = hashlib.sha256()
+        self._filled = 0
+
+    def update(self, data) -> None:
+        view = memoryview(data)
+        while view:
+            n = min(len(view), self.leaf_size - self._filled)
+            self._hasher.update(view[:n])
+            self._filled += n
+            view = view[n:]
+            if self._filled == self.leaf_size:
+                self.leaves.append(self._hasher.hexdigest())
+                self._hasher = hashlib.sha256()
+                self._filled = 0
+
+    def finish(self) -> list[str]:
+        """Leaf digests including the trailing partial leaf."""
+        if self._filled:
+            self.leaves.append(self._hasher.hexdigest())
+            self._hasher = hashlib.sha256()
+            self._filled = 0
+        return self.leaves
+
+
+@dataclass
+class MerkleEntry:
+    """Leaf digests of one blob."""
+
+    size: int
+    leaf_size: int
+    leaves: list[str]
+    root: str
+
+    @classmethod
+    def from_leaves(cls, size: int, leaf_size: int, leaves: list[str]) -> "MerkleEntry":
+        return cls(size=size, leaf_size=leaf_size, leaves=leaves, root=merkle_root(leaves))
+
+    @property
+    def num_leaves(self) -> int:
+        return max(1, -(-self.size // self.leaf_size))
+
+    def is_consistent(self) -> bool:
+        return len(self.leaves) == self.num_leaves and merkle_root(self.leaves) == self.root
+
+    def leaf_range(self, index: int) -> tuple[int, int]:
+        """Inclusive byte range of leaf ``index``."""
+        start = index * self.leaf_size
+        return start, min(self.size, start + self.leaf_size) - 1
+
+    def damaged_leaves(self, path: Path) -> list[int]:
+        """Indices of leaves of ``path`` that do not hash to the recorded digests (blocking).
+
+        The file is only read (it may be a hardlink shared with other chutes);
+        a short blob shows up as damaged leaves at its end.
+        """
+        damaged = []
+        fd = open_noatime(path)
+        try:
+            if hasattr(os, "posix_fadvise"):
+                os.posix_fadvise(fd, 0, 0, os.POSIX_FADV_SEQUENTIAL)
+            for index, expected in enumerate(self.leaves):
+                if self.hash_leaf(fd, index) != expected:
+                    damaged.append(index)
+        finally:
+            os.close(fd)
+        return damaged
+
+    def hash_leaf(self, fd: int, index: int) -> str:
+        start, end = self.leaf_range(index)
+        hasher = hashlib.sha256()
+        offset = start
+        while offset <= end:
+            data = os.pread(fd, min(_READ_SIZE, end - offset + 1), offset)
+            if not data:
+                break
+            hasher.update(data)
+            offset += len(data)
+        return hasher.hexdigest()
+
+
+@dataclass
+class MerkleManifest:
+    """Merkle entries of a chute's blobs, keyed by blob name (content-addressed)."""
+
+    entries: dict[str, MerkleEntry] = field(default_factory=dict)
+
+    @staticmethod
+    def path_for(cache_dir: Path) -> Path:
+        return Path(cache_dir) / MERKLE_MANIFEST_FILE
+
+    @classmethod
+    def load(cls, cache_dir: Path) -> "MerkleManifest":
+        """Load the sidecar; entries whose leaves do not match their root are dropped."""
+        path = cls.path_for(cache_dir)
+        try:
+            data = json.loads(path.read_text(encoding="utf-8"))
+            if data.get("version") == _MANIFEST_VERSION:
+                entries = {blob: MerkleEntry(**e) for blob, e in data.get("entries", {}).items()}
+                return cls({blob: e for blob, e in entries.items() if e.is_consistent()})
+        except FileNotFoundError:
+            pass
+        except (OSError, ValueError, TypeError) as e:
+            logger.warning("Ignoring unreadable Merkle manifest {}: {}", path, e)
+        return cls()
+
+    def save(self, cache_dir: Path) -> None:
+        """Atomically write the sidecar (write temp file, then rename)."""
+        path = self.path_for(cache_dir)
+        tmp = path.with_name(f"{path.name}.tmp.{os.getpid()}")
+        data = {
+            "version": _MANIFEST_VERSION,
+            "entries": {blob: asdict(e) for blob, e in sorted(self.entries.items())},
+        }
+        try:
+            tmp.write_text(json.dumps(data, separators=(",", ":")), encoding="utf-8")
+            os.replace(tmp, path)
+        except OSError as e:
+            logger.warning("Could not write Merkle manifest {}: {}", path, e)
+            tmp.unlink(missing_ok=True)
+
+    def get(self, blob: str) -> Optional[MerkleEntry]:
+        return self.entries.get(blob)
+
+    def record(self, blob: str, size: int, leaf_size: int, leaves: list[str]) -> None:
+        self.entries[blob] = MerkleEntry.from_leaves(size, leaf_size, leaves)
+
+    def prune(self, keep: set[str]) -> int:
+        """Drop entries for blobs no longer in the snapshot; returns how many."""
+        stale = [blob for blob in self.entries if blob not in keep]
+        for blob in stale:
+            del self.entries[blob]
+        return len(stale)
@@ -4,10 +4,13 @@ from __future__ import annotations
 
 from dataclasses import dataclass
 from enum import Enum
-from typing import Optional
+from typing import TYPE_CHECKING, Optional
 
 from pydantic import BaseModel, Field
 
+if TYPE_CHECKING:
+    from .verify import VerificationProgress
+
 
 class CacheChuteStatusEnum(str, Enum):
     """Status for a chute in the download status (GET) and overview."""
@@ -20,6 +23,27 @@ class CacheChuteStatusEnum(str, Enum):
     STALE = "stale"
 
 
+class DownloadPriority(str, Enum):
+    """Scheduling priority of a download request."""
+
+    URGENT = "urgent"  # a pod on this node is waiting for the model
+    NORMAL = "normal"
+    BACKGROUND = "background"  # prefetch; first to yield bandwidth and slots
+
+    @property
+    def rank(self) -> int:
+        return _PRIORITY_RANK[self]
+
+    @property
+    def weight(self) -> int:
+        """Relative bandwidth share while running."""
+        return _PRIORITY_WEIGHT[self]
+
+
+_PRIORITY_RANK = {DownloadPriority.URGENT: 2, DownloadPriority.NORMAL: 1, DownloadPriority.BACKGROUND: 0}
+_PRIORITY_WEIGHT = {DownloadPriority.URGENT: 8, DownloadPriority.NORMAL: 4, DownloadPriority.BACKGROUND: 1}
+
+
 class HfInfoResponse(BaseModel):
     """Response from validator hf_info endpoint."""
 
@@ -31,6 +55,25 @@ class HfInfoResponse(BaseModel):
 
 class DownloadRequest(BaseModel):
     chute_id: str = Field(..., description="Chute ID to download model for")
+    priority: DownloadPriority = Field(
+        DownloadPriority.NORMAL,
+        description="urgent (a pod on this node needs the model), normal, or background (prefetch)",
+    )
+
+
+class TouchRequest(BaseModel):
+    lease_seconds: int = Field(
+        0,
+        ge=0,
+        le=86400,
+        description="Protect the entry from eviction for this many seconds (renew while the model is in use)",
+    )
+
+
+class PrewarmRequest(BaseModel):
+    budget_gb: Optional[float] = Field(
+        None, gt=0, description="Max GB to pull into the page cache (default: CACHE_PREWARM_BUDGET_GB)"
+    )
 
 
 class CleanupRequest(BaseModel):
@@ -41,7 +84,7 @@ class CleanupRequest(BaseModel):
 
 @dataclass
 class ChuteSnapshot:
-    """Point-in-time read of a HuggingFaceSnapshot's state (one scan_cache_dir call)."""
+    """Point-in-time read of a HuggingFaceSnapshot's state (from usage and progress counters)."""
 
     chute_id: str
     repo_id: str
@@ -53,6 +96,11 @@ class ChuteSnapshot:
     eta_seconds: Optional[float]
     last_accessed: Optional[float]
     error: Optional[str]
+    verification: Optional["VerificationProgress"] = None
+    priority: Optional[DownloadPriority] = None
+    queue_position: Optional[int] = None
+    access_count: int = 0
+    lease_until: Optional[float] = None
 
 
 @dataclass
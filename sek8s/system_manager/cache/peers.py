@@ -0,0 +1,128 @@
+"""Cache submodule: fetching blobs from peer nodes.
+
+Nodes of one fleet list each other's system-manager URLs in ``CACHE_PEERS``.
+Every node advertises the blobs of its verified snapshots at
+``GET /cache/peer/blobs`` and serves byte ranges of them at
+``GET /cache/peer/blobs/{blob}``.  The chunked downloader asks each peer for
+its list once per download and fetches chunks of the blobs peers hold from
+them, spreading chunks over all holders.  A chunk that fails on every peer,
+and every blob no peer holds, comes from the HF endpoint.
+
+Peers are not trusted: a blob assembled from peer chunks goes through the
+same digest check as any other, and a mismatch restarts that blob from the
+HF endpoint alone.  Requests are signed with the miner key, which every node
+of the fleet shares.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import os
+from pathlib import Path
+from typing import Optional
+
+import aiohttp
+from loguru import logger
+
+from sek8s.config import MinerConfig, cache_config
+from sek8s.services.util import sign_request
+
+from .blobstore import blob_algorithm
+from .fileio import open_noatime
+
+_READ_SIZE = 1024 * 1024
+
+
+def peer_headers() -> dict[str, str]:
+    """Signed request headers, or none when miner credentials are not configured."""
+    miner = MinerConfig()
+    if not (miner.miner_ss58 and miner.miner_seed):
+        return {}
+    headers, _ = sign_request(purpose="cache")
+    return headers
+
+
+class PeerDirectory:
+    """The configured peers and which blobs each of them holds."""
+
+    def __init__(self, urls: list[str], timeout: float = 10.0, connections: int = 16):
+        self.urls = [url.strip().rstrip("/") for url in urls if url.strip()]
+        self.timeout = timeout
+        self.connections = connections
+
+    @classmethod
+    def from_config(cls) -> Optional["PeerDirectory"]:
+        """Peers from ``CACHE_PEERS``, or None when no peers are configured."""
+        directory = cls(
+            (cache_config.peer_urls or "").split(","),
+            timeout=cache_config.peer_timeout,
+            connections=cache_config.download_connections,
+        )
+        return directory if directory.urls else None
+
+    def session(self) -> aiohttp.ClientSession:
+        """Session for peer requests: short timeouts, and never the HF token."""
+        connector = aiohttp.TCPConnector(limit=self.connections)
+        timeout = aiohttp.ClientTimeout(total=None, sock_connect=self.timeout, sock_read=self.timeout)
+        return aiohttp.ClientSession(connector=connector, timeout=timeout)
+
+    @staticmethod
+    def blob_url(peer: str, blob: str) -> str:
+        return f"{peer}/cache/peer/blobs/{blob}"
+
+    async def _advertised(self, session: aiohttp.ClientSession, peer: str) -> set[str]:
+        try:
+            async with session.get(f"{peer}/cache/peer/blobs", headers=peer_headers()) as resp:
+                if resp.status != 200:
+                    logger.debug("Peer {} blob list: HTTP {}", peer, resp.status)
+                    return set()
+                data = await resp.json()
+        except (aiohttp.ClientError, asyncio.TimeoutError, ValueError) as e:
+            logger.debug("Peer {} unreachable: {}", peer, e)
+            return set()
+        return {item["blob"] for item in data.get("blobs", []) if blob_algorithm(str(item.get("blob", "")))}
+
+    async def locate(self, session: aiohttp.ClientSession, blobs: set[str]) -> dict[str, list[str]]:
+        """URLs of the peers holding each of ``blobs``; blobs no peer holds are left out."""
+        advertised = await asyncio.gather(*(self._advertised(session, peer) for peer in self.urls))
+        holders: dict[str, list[str]] = {}
+        for peer, held in zip(self.urls, advertised):
+            for blob in blobs & held:
+                holders.setdefault(blob, []).append(self.blob_url(peer, blob))
+        return holders
+
+
+def parse_range(header: Optional[str], size: int) -> Optional[tuple[int, int]]:
+    """Inclusive byte range of a single-range ``Range`` header; None for the whole blob.
+
+    Raises ValueError for a malformed or unsatisfiable range.
+    """
+    if not header:
+        return None
+    unit, _, spec = header.partition("=")
+    if unit.strip() != "bytes" or "," in spec:
+        raise ValueError(f"unsupported range {header!r}")
+    first, _, last = spec.strip().partition("-")
+    if first:
+        start = int(first)
+        end = min(int(last), size - 1) if last else size - 1
+    else:
+        start, end = max(0, size - int(last)), size - 1
+    if start > end or start >= size:
+        raise ValueError(f"range {header!r} not satisfiable for {size} bytes")
+    return start, end
+
+
+async def read_range(path: Path, start: int, end: int):
+    """Async generator of the bytes ``start``..``end`` of ``path``, read in threads."""
+    fd = await asyncio.to_thread(open_noatime, path)
+    try:
+        offset = start
+        while offset <= end:
+            data = await asyncio.to_thread(os.pread, fd, min(_READ_SIZE, end - offset + 1), offset)
+            if not data:
+                return
+            offset += len(data)
+            yield data
+    finally:
+        os.close(fd)
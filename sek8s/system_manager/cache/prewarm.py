@@ -0,0 +1,229 @@
+"""Cache submodule: page-cache prewarming and residency of snapshot files.
+
+Prewarming streams a snapshot's blobs into the page cache before the chute
+pod starts, so model loading reads from memory instead of the cache volume.
+Files are split into segments that a thread pool reads in load order; each
+worker issues ``posix_fadvise(WILLNEED)`` one window ahead of its reads so the
+device always has readahead queued.  Prewarming stops at a memory budget
+(by default half of ``MemAvailable``) and can be cancelled at any time.
+
+Residency is reported with ``mincore(2)`` on a read-only mapping of each blob.
+Since Linux 5.2 ``mincore`` only reports page-cache state for files the caller
+owns or may write; cache blobs are group-writable, so this holds for the
+system manager.
+"""
+
+from __future__ import annotations
+
+import ctypes
+import ctypes.util
+import mmap
+import os
+import threading
+import time
+from concurrent.futures import ThreadPoolExecutor
+from dataclasses import dataclass
+from pathlib import Path
+from typing import Optional
+
+from loguru import logger
+
+from .fileio import open_noatime
+from .verify import VerificationProgress
+
+_PROT_READ = 0x1
+_MAP_SHARED = 0x01
+_MAP_FAILED = ctypes.c_void_p(-1).value
+# mincore vectors are one byte per page; map at most this much at once
+_RESIDENCY_WINDOW = 1024 ** 3
+
+
+@dataclass
+class SnapshotFile:
+    """A snapshot entry resolved to its blob."""
+
+    rel_path: str
+    path: Path
+    size: int
+
+
+@dataclass
+class PrewarmProgress(VerificationProgress):
+    """Progress of one prewarm run; ``bytes_total`` is what fits in the memory budget."""
+
+    budget: int = 0
+    cancelled: bool = False
+    error: Optional[str] = None
+
+    def _segment_done(self, path: str) -> None:
+        """Mark ``path`` finished once all of its segments have been read."""
+        with self._lock:
+            fp = self.files[path]
+            if fp.finished_at is None and fp.bytes_done >= fp.size:
+                fp.finished_at = time.monotonic()
+                self.files_done += 1
+
+
+def snapshot_files(snapshot_dir: Path) -> list[SnapshotFile]:
+    """Files of a snapshot in load order (sorted by path; shards are numbered)."""
+    files = []
+    for link in sorted(Path(snapshot_dir).rglob("*")):
+        if link.is_dir():
+            continue
+        try:
+            blob = link.resolve(strict=True)
+            size = blob.stat().st_size
+        except (OSError, RuntimeError):
+            continue
+        files.append(SnapshotFile(str(link.relative_to(snapshot_dir)), blob, size))
+    return files
+
+
+def available_memory() -> int:
+    """``MemAvailable`` from /proc/meminfo in bytes (0 if unknown)."""
+    try:
+        with open("/proc/meminfo", encoding="ascii") as f:
+            for line in f:
+                if line.startswith("MemAvailable:"):
+                    return int(line.split()[1]) * 1024
+    except (OSError, ValueError, IndexError):
+        pass
+    return 0
+
+
+class _Libc:
+    """ctypes bindings for mmap/mincore/munmap (Python's mmap cannot expose a read-only mapping's address)."""
+
+    def __init__(self):
+        libc = ctypes.CDLL(ctypes.util.find_library("c") or None, use_errno=True)
+        self.mmap = libc.mmap
+        self.mmap.restype = ctypes.c_void_p
+        self.mmap.argtypes = [
+            ctypes.c_void_p, ctypes.c_size_t, ctypes.c_int, ctypes.c_int, ctypes.c_int, ctypes.c_long,
+        ]
+        self.munmap = libc.munmap
+        self.munmap.argtypes = [ctypes.c_void_p, ctypes.c_size_t]
+        self.mincore = libc.mincore
+        self.mincore.argtypes = [ctypes.c_void_p, ctypes.c_size_t, ctypes.POINTER(ctypes.c_ubyte)]
+
+
+_libc: Optional[_Libc] = None
+
+
+def resident_bytes(path: Path) -> int:
+    """Bytes of ``path`` currently in the page cache."""
+    global _libc
+    if _libc is None:
+        _libc = _Libc()
+    size = os.stat(path).st_size
+    if size == 0:
+        return 0
+    page = mmap.PAGESIZE
+    resident = 0
+    fd = open_noatime(path)
+    try:
+        for offset in range(0, size, _RESIDENCY_WINDOW):
+            length = min(_RESIDENCY_WINDOW, size - offset)
+            addr = _libc.mmap(None, length, _PROT_READ, _MAP_SHARED, fd, offset)
+            if addr is None or addr == _MAP_FAILED:
+                err = ctypes.get_errno()
+                raise OSError(err, os.strerror(err), str(path))
+            try:
+                pages = (length + page - 1) // page
+                vec = (ctypes.c_ubyte * pages)()
+                if _libc.mincore(addr, length, vec) != 0:
+                    err = ctypes.get_errno()
+                    raise OSError(err, os.strerror(err), str(path))
+                resident_pages = sum(b & 1 for b in bytes(vec))
+            finally:
+                _libc.munmap(addr, length)
+            # The last page of a file is counted in full; clamp to the file size
+            resident += min(resident_pages * page, length)
+    finally:
+        os.close(fd)
+    return resident
+
+
+class Prewarmer:
+    """Read files into the page cache with parallel, fadvise-led sequential reads."""
+
+    def __init__(self, workers: int = 4, segment_size: int = 256 * 1024 * 1024, window: int = 16 * 1024 * 1024):
+        self.workers = max(1, workers)
+        self.segment_size = segment_size
+        self.window = window
+
+    def prewarm(
+        self,
+        files: list[SnapshotFile],
+        budget: int,
+        progress: Optional[PrewarmProgress] = None,
+        cancel: Optional[threading.Event] = None,
+    ) -> PrewarmProgress:
+        """Warm files in order until ``budget`` bytes are covered (blocking)."""
+        progress = progress if progress is not None else PrewarmProgress()
+        cancel = cancel if cancel is not None else threading.Event()
+        progress.budget = budget
+
+        segments: list[tuple[SnapshotFile, int, int]] = []
+        remaining = budget
+        seen: set[Path] = set()
+        for f in files:
+            if remaining <= 0:
+                break
+            if f.size == 0 or f.path in seen:
+                # Another path of the same blob is already being read
+                continue
+            seen.add(f.path)
+            length = min(f.size, remaining)
+            remaining -= length
+            progress.add_file(f.rel_path, length)
+            for offset in range(0, length, self.segment_size):
+                segments.append((f, offset, min(self.segment_size, length - offset)))
+
+        try:
+            with ThreadPoolExecutor(max_workers=self.workers, thread_name_prefix="prewarm") as pool:
+                futures = [pool.submit(self._warm_segment, s, progress, cancel) for s in segments]
+                try:
+                    for future in futures:
+                        future.result()
+                finally:
+                    # On error, stop the remaining segments instead of waiting for them
+                    cancel.set()
+        except InterruptedError:
+            progress.cancelled = True
+        finally:
+            progress.finished_at = time.monotonic()
+
+        logger.info(
+            "Prewarm: files={}, bytes={}/{}, throughput={:.1f} MB/s{}",
+            progress.files_total, progress.bytes_done, progress.bytes_total,
+            (progress.throughput or 0) / 1e6, " (cancelled)" if progress.cancelled else "",
+        )
+        return progress
+
+    def _warm_segment(
+        self, segment: tuple[SnapshotFile, int, int], progress: PrewarmProgress, cancel: threading.Event
+    ) -> None:
+        f, start, length = segment
+        end = start + length
+        fd = open_noatime(f.path)
+        buf = mmap.mmap(-1, self.window)
+        try:
+            os.posix_fadvise(fd, start, min(length, 2 * self.window), os.POSIX_FADV_WILLNEED)
+            offset = start
+            while offset < end:
+                if cancel.is_set():
+                    raise InterruptedError(f"Prewarm of {f.rel_path} cancelled")
+                n = min(self.window, end - offset)
+                # Keep readahead one window ahead of the reads
+                if offset + n < end:
+                    os.posix_fadvise(fd, offset + n, min(self.window, end - offset - n), os.POSIX_FADV_WILLNEED)
+                n = os.preadv(fd, [memoryview(buf)[:n]], offset)
+                if n <= 0:
+                    break
+                offset += n
+                progress._advance(f.rel_path, n)
+        finally:
+            os.close(fd)
+            buf.close()
+        progress._segment_done(f.rel_path)
@@ -0,0 +1,55 @@
+"""Cache submodule: disk-space reservations for downloads.
+
+Admitting a download reserves the bytes it still has to write.  As the
+download allocates space (the chunked engine preallocates every blob when it
+starts; ``snapshot_download`` files count once they land in ``blobs/``), the
+outstanding part of its reservation shrinks by the same amount, so free
+space and reservations never count the same bytes twice.  A download is
+admitted only if free space minus everything still outstanding covers it;
+otherwise it fails before fetching a single byte.
+"""
+
+from __future__ import annotations
+
+from typing import Callable
+
+
+class InsufficientSpace(Exception):
+    """Not enough free space on the cache filesystem for a download."""
+
+    def __init__(self, needed: int, available: int):
+        super().__init__(
+            f"Insufficient cache space: download needs {needed} bytes, {max(0, available)} available"
+        )
+        self.needed = needed
+        self.available = available
+
+
+class SpaceLedger:
+    """Reserved bytes of all admitted downloads, keyed by chute."""
+
+    def __init__(self, headroom: int = 0):
+        self.headroom = headroom  # bytes always left free (markers, manifests, logs)
+        self._reserved: dict[str, int] = {}
+
+    def __contains__(self, chute_id: str) -> bool:
+        return chute_id in self._reserved
+
+    def outstanding(self, allocated: Callable[[str], int]) -> int:
+        """Reserved bytes not yet allocated; ``allocated(chute_id)`` is what a download has allocated so far."""
+        return sum(max(0, nbytes - allocated(cid)) for cid, nbytes in self._reserved.items())
+
+    def available(self, free: int, allocated: Callable[[str], int]) -> int:
+        """Free bytes that a new reservation may claim."""
+        return free - self.headroom - self.outstanding(allocated)
+
+    def reserve(self, chute_id: str, nbytes: int, free: int, allocated: Callable[[str], int]) -> None:
+        """Reserve ``nbytes`` for ``chute_id`` or raise InsufficientSpace."""
+        self._reserved.pop(chute_id, None)
+        available = self.available(free, allocated)
+        if nbytes > available:
+            raise InsufficientSpace(nbytes, available)
+        self._reserved[chute_id] = nbytes
+
+    def release(self, chute_id: str) -> None:
+        self._reserved.pop(chute_id, None)
@@ -7,7 +7,7 @@ from typing import List, Optional
 
 from pydantic import BaseModel, Field
 
-from .models import CacheChuteStatusEnum
+from .models import CacheChuteStatusEnum, DownloadPriority
 
 
 class CacheDownloadStatus(str, Enum):
@@ -27,6 +27,26 @@ class CacheDownloadResponse(BaseModel):
     )
 
 
+class CacheVerificationFile(BaseModel):
+    path: str = Field(..., description="File path within the snapshot")
+    size: int = Field(..., description="File size in bytes")
+    bytes_done: int = Field(..., description="Bytes hashed so far")
+    throughput: Optional[float] = Field(None, description="Hashing speed for this file in bytes/sec")
+
+
+class CacheVerificationProgress(BaseModel):
+    files_total: int = Field(..., description="Files being content-verified")
+    files_done: int = Field(..., description="Files fully hashed")
+    bytes_total: int = Field(..., description="Total bytes to hash")
+    bytes_done: int = Field(..., description="Bytes hashed so far")
+    percent_complete: Optional[float] = Field(None, description="Hashing progress 0-100")
+    throughput: Optional[float] = Field(None, description="Aggregate hashing speed in bytes/sec")
+    finished: bool = Field(..., description="True once the verification run has ended")
+    in_flight: List[CacheVerificationFile] = Field(
+        default_factory=list, description="Files currently being hashed"
+    )
+
+
 class CacheChuteStatus(BaseModel):
     chute_id: str = Field(..., description="Chute ID")
     status: CacheChuteStatusEnum = Field(
@@ -49,6 +69,13 @@ class CacheChuteStatus(BaseModel):
     revision: Optional[str] = Field(None, description="Revision when present or in_progress")
     size_bytes: Optional[int] = Field(None, description="Size in bytes when present")
     error: Optional[str] = Field(None, description="Error message when status is failed")
+    verification: Optional[CacheVerificationProgress] = Field(
+        None, description="Content verification progress of the most recent verification run"
+    )
+    priority: Optional[DownloadPriority] = Field(None, description="Scheduling priority when in_progress")
+    queue_position: Optional[int] = Field(
+        None, description="1-based position in the download queue while waiting for a slot; omitted once running"
+    )
 
 
 class CacheDownloadStatusResponse(BaseModel):
@@ -65,6 +92,70 @@ class CacheOverviewEntry(BaseModel):
         CacheChuteStatusEnum.PRESENT,
         description="Status: present, in_progress, incomplete, stale, failed, etc.",
     )
+    access_count: int = Field(0, description="Recorded model loads (touches and observed blob reads)")
+    lease_expires_at: Optional[float] = Field(
+        None, description="Unix time until which the entry is protected from eviction"
+    )
+
+
+class CachePrewarmProgress(BaseModel):
+    files_total: int = Field(..., description="Files (or leading parts of files) within the memory budget")
+    files_done: int = Field(..., description="Files fully read into the page cache")
+    bytes_total: int = Field(..., description="Bytes to read, capped at the budget")
+    bytes_done: int = Field(..., description="Bytes read so far")
+    budget_bytes: int = Field(..., description="Memory budget of this run")
+    percent_complete: Optional[float] = Field(None, description="Prewarm progress 0-100")
+    throughput: Optional[float] = Field(None, description="Read speed in bytes/sec")
+    finished: bool = Field(..., description="True once the run has ended")
+    cancelled: bool = Field(False, description="True if the run was cancelled")
+    error: Optional[str] = Field(None, description="Error that stopped the run")
+
+
+class CachePrewarmResponse(BaseModel):
+    chute_id: str = Field(..., description="Chute ID")
+    status: str = Field(..., description="started, or in_progress if a prewarm was already running")
+    prewarm: CachePrewarmProgress = Field(..., description="Progress of the prewarm run")
+
+
+class CacheResidencyFile(BaseModel):
+    path: str = Field(..., description="File path within the snapshot")
+    size: int = Field(..., description="File size in bytes")
+    resident_bytes: int = Field(..., description="Bytes currently in the page cache")
+
+
+class CacheResidencyResponse(BaseModel):
+    chute_id: str = Field(..., description="Chute ID")
+    bytes_total: int = Field(..., description="Snapshot size in bytes, counting each blob once")
+    bytes_resident: int = Field(..., description="Snapshot bytes currently in the page cache, counting each blob once")
+    percent_resident: Optional[float] = Field(None, description="Resident share 0-100")
+    files: List[CacheResidencyFile] = Field(default_factory=list, description="Residency per file")
+    prewarm: Optional[CachePrewarmProgress] = Field(None, description="Most recent prewarm run")
+
+
+class CacheTensorInfo(BaseModel):
+    name: str = Field(..., description="Tensor name")
+    file: str = Field(..., description="File path within the snapshot")
+    dtype: str = Field(..., description="safetensors dtype, e.g. BF16")
+    shape: List[int] = Field(..., description="Tensor shape")
+    offset: int = Field(..., description="Byte offset of the tensor data in the file")
+    size: int = Field(..., description="Tensor data size in bytes")
+
+
+class CacheTensorIndexResponse(BaseModel):
+    chute_id: str = Field(..., description="Chute ID")
+    repo_id: str = Field(..., description="Hugging Face repo ID")
+    revision: str = Field(..., description="Snapshot revision")
+    files: List[str] = Field(default_factory=list, description="Indexed safetensors files")
+    tensors: List[CacheTensorInfo] = Field(default_factory=list, description="Tensors, optionally filtered")
+
+
+class CacheTouchResponse(BaseModel):
+    chute_id: str = Field(..., description="Chute ID")
+    access_count: int = Field(..., description="Recorded model loads")
+    last_access: Optional[float] = Field(None, description="Last recorded access (Unix)")
+    lease_expires_at: Optional[float] = Field(
+        None, description="Unix time until which the entry is protected from eviction"
+    )
 
 
 class CacheOverviewResponse(BaseModel):
@@ -76,3 +167,12 @@ class CacheCleanupResponse(BaseModel):
     status: str = Field(..., description="Cleanup status", example="completed")
     freed_bytes: int = Field(0, description="Bytes freed")
     removed_chutes: List[str] = Field(default_factory=list, description="Chute IDs removed")
+
+
+class CachePeerBlob(BaseModel):
+    blob: str = Field(..., description="Blob name (sha256 for LFS files, git blob id otherwise)")
+    size: int = Field(..., description="Blob size in bytes")
+
+
+class CachePeerBlobsResponse(BaseModel):
+    blobs: List[CachePeerBlob] = Field(default_factory=list, description="Verified blobs this node serves")
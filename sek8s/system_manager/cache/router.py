@@ -6,15 +6,28 @@ Every endpoint delegates to CacheManager / ChuteModel via
 
 from __future__ import annotations
 
+import asyncio
 import os
 from typing import Optional
 
 from fastapi import APIRouter, Depends, HTTPException, Query, Request
+from fastapi.responses import StreamingResponse
 
 from sek8s.services.util import authorize
 
+from .blobstore import blob_algorithm
 from .manager import CacheManager
-from .models import CacheChuteStatusEnum, CleanupRequest, ChuteSnapshot, DownloadRequest
+from .models import (
+    CacheChuteStatusEnum,
+    CleanupRequest,
+    ChuteSnapshot,
+    DownloadRequest,
+    PrewarmRequest,
+    TouchRequest,
+)
+from .peers import parse_range, read_range
+from .prewarm import PrewarmProgress
+from .reservation import InsufficientSpace
 from .responses import (
     CacheChuteStatus,
     CacheCleanupResponse,
@@ -23,21 +36,77 @@ from .responses import (
     CacheDownloadStatusResponse,
     CacheOverviewEntry,
     CacheOverviewResponse,
+    CachePeerBlob,
+    CachePeerBlobsResponse,
+    CachePrewarmProgress,
+    CachePrewarmResponse,
+    CacheResidencyFile,
+    CacheResidencyResponse,
+    CacheTensorIndexResponse,
+    CacheTensorInfo,
+    CacheTouchResponse,
+    CacheVerificationFile,
+    CacheVerificationProgress,
 )
 from .util import fetch_hf_info
+from .verify import VerificationProgress
 
 router = APIRouter()
 
 
+def _verification_to_response(
+    progress: Optional[VerificationProgress],
+) -> Optional[CacheVerificationProgress]:
+    if progress is None or progress.files_total == 0:
+        return None
+    return CacheVerificationProgress(
+        files_total=progress.files_total,
+        files_done=progress.files_done,
+        bytes_total=progress.bytes_total,
+        bytes_done=progress.bytes_done,
+        percent_complete=progress.percent_complete,
+        throughput=progress.throughput,
+        finished=progress.finished_at is not None,
+        in_flight=[
+            CacheVerificationFile(
+                path=f.path, size=f.size, bytes_done=f.bytes_done, throughput=f.throughput
+            )
+            for f in progress.in_flight()
+        ],
+    )
+
+
+def _prewarm_to_response(progress: Optional[PrewarmProgress]) -> Optional[CachePrewarmProgress]:
+    if progress is None:
+        return None
+    return CachePrewarmProgress(
+        files_total=progress.files_total,
+        files_done=progress.files_done,
+        bytes_total=progress.bytes_total,
+        bytes_done=progress.bytes_done,
+        budget_bytes=progress.budget,
+        percent_complete=progress.percent_complete,
+        throughput=progress.throughput,
+        finished=progress.finished_at is not None,
+        cancelled=progress.cancelled,
+        error=progress.error,
+    )
+
+
 def _snap_to_status(snap: ChuteSnapshot) -> CacheChuteStatus:
     return CacheChuteStatus(
         chute_id=snap.chute_id,
         status=snap.status,
         percent_complete=snap.percent_complete,
+        download_rate=snap.download_rate,
+        eta_seconds=snap.eta_seconds,
         repo_id=snap.repo_id or None,
         revision=snap.revision,
         size_bytes=snap.size_bytes or None,
         error=snap.error,
+        verification=_verification_to_response(snap.verification),
+        priority=snap.priority,
+        queue_position=snap.queue_position,
     )
 
 
@@ -49,6 +118,8 @@ def _snap_to_overview(snap: ChuteSnapshot) -> CacheOverviewEntry:
         size_bytes=snap.size_bytes,
         last_accessed=snap.last_accessed,
         status=snap.status,
+        access_count=snap.access_count,
+        lease_expires_at=snap.lease_until,
     )
 
 
@@ -76,6 +147,7 @@ async def download(
     chute = await mgr.get_or_create(chute_id)
 
     if chute.is_in_progress:
+        mgr.escalate(chute, request.priority)
         return CacheDownloadResponse(chute_id=chute_id, status=CacheDownloadStatus.IN_PROGRESS)
 
     if chute.status == CacheChuteStatusEnum.PRESENT and not force:
@@ -90,7 +162,10 @@ async def download(
         raise HTTPException(status_code=502, detail="Validator did not return repo_id")
     revision = info.revision or "main"
 
-    await chute.start_download(repo_id, revision)
+    try:
+        await mgr.start_download(chute, repo_id, revision, request.priority)
+    except InsufficientSpace as e:
+        raise HTTPException(status_code=507, detail=str(e))
     return CacheDownloadResponse(chute_id=chute_id, status=CacheDownloadStatus.STARTED)
 
 
@@ -117,6 +192,38 @@ async def download_status(
     return CacheDownloadStatusResponse(chutes=[_snap_to_status(s) for s in snapshots])
 
 
+@router.get(
+    "/events",
+    summary="Stream cache status changes",
+    description=(
+        "Server-sent events: a `snapshot` event with every chute's status, then `update` events with "
+        "only the changed fields (status, progress, rate, ETA, ...) and `removed` events as they happen"
+    ),
+)
+async def events(
+    chute_id: Optional[str] = Query(None, description="Optional chute_id to filter"),
+    mgr: CacheManager = Depends(get_cache_manager),
+    _auth: bool = Depends(authorize(allow_miner=True, purpose="cache")),
+):
+    return StreamingResponse(
+        _stream_events(mgr, chute_id),
+        media_type="text/event-stream",
+        headers={"Cache-Control": "no-cache", "X-Accel-Buffering": "no"},
+    )
+
+
+async def _stream_events(mgr: CacheManager, chute_id: Optional[str]):
+    """Async generator relaying event bus messages until the client disconnects."""
+    stream = mgr.events.subscribe(chute_id)
+    try:
+        async for message in stream:
+            yield message
+    except (asyncio.CancelledError, GeneratorExit):
+        pass
+    finally:
+        await stream.aclose()
+
+
 @router.delete(
     "/{chute_id}",
     summary="Remove cache for a chute",
@@ -141,6 +248,153 @@ async def delete_chute(
     return {"status": "ok", "message": "deleted"}
 
 
+@router.post(
+    "/{chute_id}/touch",
+    response_model=CacheTouchResponse,
+    summary="Record a model load and optionally lease the entry against eviction",
+)
+async def touch(
+    chute_id: str,
+    body: Optional[TouchRequest] = None,
+    mgr: CacheManager = Depends(get_cache_manager),
+    _auth: bool = Depends(authorize(allow_miner=True, purpose="cache")),
+) -> CacheTouchResponse:
+    if len(chute_id) != 36:
+        raise HTTPException(status_code=400, detail="chute_id must be a 36-char UUID")
+
+    await mgr.sync_from_disk()
+    chute = await mgr.get(chute_id)
+    if chute is None:
+        raise HTTPException(status_code=404, detail="Chute is not cached")
+
+    await mgr.touch(chute, body.lease_seconds if body else 0)
+    return CacheTouchResponse(
+        chute_id=chute_id,
+        access_count=chute.access.hits,
+        last_access=chute.access.last_access,
+        lease_expires_at=chute.access.lease_until,
+    )
+
+
+@router.post(
+    "/{chute_id}/prewarm",
+    response_model=CachePrewarmResponse,
+    summary="Read a cached snapshot into the page cache ahead of pod start",
+)
+async def prewarm(
+    chute_id: str,
+    body: Optional[PrewarmRequest] = None,
+    mgr: CacheManager = Depends(get_cache_manager),
+    _auth: bool = Depends(authorize(allow_miner=True, purpose="cache")),
+) -> CachePrewarmResponse:
+    if len(chute_id) != 36:
+        raise HTTPException(status_code=400, detail="chute_id must be a 36-char UUID")
+
+    await mgr.sync_from_disk()
+    chute = await mgr.get(chute_id)
+    if chute is None:
+        raise HTTPException(status_code=404, detail="Chute is not cached")
+    if chute.status != CacheChuteStatusEnum.PRESENT:
+        raise HTTPException(status_code=409, detail=f"Cache is {chute.status.value}, not present")
+
+    running = chute.is_prewarming
+    budget = int(body.budget_gb * 1024 ** 3) if body and body.budget_gb else None
+    try:
+        progress = await chute.start_prewarm(budget)
+    except ValueError as e:
+        raise HTTPException(status_code=409, detail=str(e))
+    return CachePrewarmResponse(
+        chute_id=chute_id,
+        status="in_progress" if running else "started",
+        prewarm=_prewarm_to_response(progress),
+    )
+
+
+@router.delete(
+    "/{chute_id}/prewarm",
+    summary="Cancel a running prewarm",
+)
+async def cancel_prewarm(
+    chute_id: str,
+    mgr: CacheManager = Depends(get_cache_manager),
+    _auth: bool = Depends(authorize(allow_miner=True, purpose="cache")),
+) -> dict:
+    chute = await mgr.get(chute_id)
+    if chute is None or not chute.cancel_prewarm():
+        return {"status": "ok", "message": "not running"}
+    return {"status": "ok", "message": "cancelled"}
+
+
+@router.get(
+    "/{chute_id}/residency",
+    response_model=CacheResidencyResponse,
+    summary="Report which snapshot files are in the page cache",
+)
+async def residency(
+    chute_id: str,
+    mgr: CacheManager = Depends(get_cache_manager),
+    _auth: bool = Depends(authorize(allow_miner=True, purpose="cache")),
+) -> CacheResidencyResponse:
+    if len(chute_id) != 36:
+        raise HTTPException(status_code=400, detail="chute_id must be a 36-char UUID")
+
+    await mgr.sync_from_disk()
+    chute = await mgr.get(chute_id)
+    if chute is None:
+        raise HTTPException(status_code=404, detail="Chute is not cached")
+
+    files = await chute.residency()
+    # Paths sharing a blob share its pages; count each blob once
+    blobs = {f.path: (f.size, r) for f, r in files}
+    total = sum(size for size, _ in blobs.values())
+    resident = sum(r for _, r in blobs.values())
+    return CacheResidencyResponse(
+        chute_id=chute_id,
+        bytes_total=total,
+        bytes_resident=resident,
+        percent_resident=100.0 * resident / total if total else None,
+        files=[CacheResidencyFile(path=f.rel_path, size=f.size, resident_bytes=r) for f, r in files],
+        prewarm=_prewarm_to_response(chute.prewarm),
+    )
+
+
+@router.get(
+    "/{chute_id}/tensors",
+    response_model=CacheTensorIndexResponse,
+    summary="Tensor index of a cached snapshot (file, dtype, shape, byte range per tensor)",
+)
+async def tensors(
+    chute_id: str,
+    prefix: Optional[str] = Query(None, description="Only tensors whose name starts with this prefix"),
+    mgr: CacheManager = Depends(get_cache_manager),
+    _auth: bool = Depends(authorize(allow_miner=True, purpose="cache")),
+) -> CacheTensorIndexResponse:
+    if len(chute_id) != 36:
+        raise HTTPException(status_code=400, detail="chute_id must be a 36-char UUID")
+
+    await mgr.sync_from_disk()
+    chute = await mgr.get(chute_id)
+    if chute is None:
+        raise HTTPException(status_code=404, detail="Chute is not cached")
+    index = await chute.tensor_index()
+    if index is None:
+        raise HTTPException(status_code=404, detail="No tensor index for this chute (not yet verified)")
+
+    return CacheTensorIndexResponse(
+        chute_id=chute_id,
+        repo_id=index.repo_id,
+        revision=index.revision,
+        files=index.files,
+        tensors=[
+            CacheTensorInfo(
+                name=name, file=index.files[e.file], dtype=e.dtype, shape=e.shape, offset=e.offset, size=e.size
+            )
+            for name, e in index.tensors.items()
+            if not prefix or name.startswith(prefix)
+        ],
+    )
+
+
 @router.post(
     "/cleanup",
     response_model=CacheCleanupResponse,
@@ -180,3 +434,51 @@ async def overview(
     entries = [_snap_to_overview(s) for s in snapshots]
     total = sum(e.size_bytes for e in entries)
     return CacheOverviewResponse(total_size_bytes=total, chutes=entries)
+
+
+@router.get(
+    "/peer/blobs",
+    response_model=CachePeerBlobsResponse,
+    summary="List verified blobs this node serves to peers",
+)
+async def peer_blobs(
+    mgr: CacheManager = Depends(get_cache_manager),
+    _auth: bool = Depends(authorize(allow_miner=True, purpose="cache")),
+) -> CachePeerBlobsResponse:
+    await mgr.sync_from_disk()
+    blobs = await mgr.verified_blobs()
+    sizes = await asyncio.to_thread(lambda: {name: path.stat().st_size for name, path in blobs.items()})
+    return CachePeerBlobsResponse(blobs=[CachePeerBlob(blob=name, size=size) for name, size in sorted(sizes.items())])
+
+
+@router.get(
+    "/peer/blobs/{blob}",
+    summary="Read a verified blob for a peer (single-range requests supported)",
+)
+async def peer_blob(
+    blob: str,
+    request: Request,
+    mgr: CacheManager = Depends(get_cache_manager),
+    _auth: bool = Depends(authorize(allow_miner=True, purpose="cache")),
+):
+    if not blob_algorithm(blob):
+        raise HTTPException(status_code=400, detail="blob must be a sha256 or git blob id")
+    path = await mgr.verified_blob(blob)
+    if path is None:
+        raise HTTPException(status_code=404, detail="Blob is not in a verified snapshot")
+
+    size = (await asyncio.to_thread(path.stat)).st_size
+    try:
+        byte_range = parse_range(request.headers.get("range"), size)
+    except ValueError as e:
+        raise HTTPException(status_code=416, detail=str(e), headers={"Content-Range": f"bytes */{size}"})
+    start, end = byte_range or (0, size - 1)
+    headers = {"Accept-Ranges": "bytes", "Content-Length": str(end - start + 1)}
+    if byte_range is not None:
+        headers["Content-Range"] = f"bytes {start}-{end}/{size}"
+    return StreamingResponse(
+        read_range(path, start, end),
+        status_code=206 if byte_range is not None else 200,
+        media_type="application/octet-stream",
+        headers=headers,
+    )
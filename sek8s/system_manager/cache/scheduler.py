@@ -0,0 +1,209 @@
+"""Cache submodule: global download scheduler.
+
+Downloads from every chute go through one ``DownloadScheduler``:
+
+* at most ``max_concurrent`` downloads run at once; the rest wait in a
+  priority queue (FIFO within a priority),
+* running downloads split the configured bandwidth by priority weight,
+* a queued download may preempt a running one of strictly lower priority.
+  The preempted download is cancelled and requeued ahead of its peers; the
+  chunked engine's checkpoints make the restart cheap, so only resumable
+  downloads are ever preempted.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import heapq
+import itertools
+import time
+from dataclasses import dataclass, field
+from typing import Awaitable, Callable, Optional, TypeVar
+
+from loguru import logger
+
+from sek8s.config import cache_config
+
+from .models import DownloadPriority
+
+T = TypeVar("T")
+
+
+class Throttle:
+    """Token bucket for one running download; its rate is its weighted share of the global limit."""
+
+    def __init__(self, scheduler: "DownloadScheduler", key: str):
+        self._scheduler = scheduler
+        self._key = key
+        self._tokens = 0.0
+        self._last = time.monotonic()
+
+    async def consume(self, nbytes: int) -> None:
+        """Account for nbytes received; sleeps while this download is over its share."""
+        rate = self._scheduler.share(self._key)
+        if not rate:
+            return
+        now = time.monotonic()
+        # Allow at most one second of burst
+        self._tokens = min(rate, self._tokens + (now - self._last) * rate) - nbytes
+        self._last = now
+        if self._tokens < 0:
+            await asyncio.sleep(-self._tokens / rate)
+
+
+@dataclass(order=True)
+class _Ticket:
+    sort_key: tuple[int, int]
+    key: str = field(compare=False)
+    priority: DownloadPriority = field(compare=False)
+    preemptible: bool = field(compare=False)
+    ready: asyncio.Event = field(compare=False, default_factory=asyncio.Event)
+    task: Optional[asyncio.Task] = field(compare=False, default=None)
+    preempted: bool = field(compare=False, default=False)
+    started_at: float = field(compare=False, default=0.0)
+    cancelled: bool = field(compare=False, default=False)
+
+
+class DownloadScheduler:
+    """Admission, priority, bandwidth sharing and preemption for cache downloads."""
+
+    def __init__(self, max_concurrent: int = 2, max_bandwidth: float = 0.0, preemption: bool = True):
+        self.max_concurrent = max(1, max_concurrent)
+        self.max_bandwidth = max_bandwidth  # bytes/sec across all downloads; 0 = unlimited
+        self.preemption = preemption
+        self._queue: list[_Ticket] = []
+        self._running: dict[str, _Ticket] = {}
+        self._seq = itertools.count()
+
+    @classmethod
+    def from_config(cls) -> "DownloadScheduler":
+        return cls(
+            max_concurrent=cache_config.download_max_concurrent,
+            max_bandwidth=cache_config.download_max_bandwidth_mbps * 1e6 / 8,
+            preemption=cache_config.download_preemption,
+        )
+
+    # ------------------------------------------------------------------
+    # Introspection
+    # ------------------------------------------------------------------
+
+    def queue_position(self, key: str) -> Optional[int]:
+        """1-based position among queued downloads, or None if not queued."""
+        for position, ticket in enumerate(sorted(t for t in self._queue if not t.cancelled), start=1):
+            if ticket.key == key:
+                return position
+        return None
+
+    def is_running(self, key: str) -> bool:
+        return key in self._running
+
+    def share(self, key: str) -> Optional[float]:
+        """Bytes/sec currently allotted to a running download; None when unlimited."""
+        if not self.max_bandwidth or key not in self._running:
+            return None
+        total = sum(t.priority.weight for t in self._running.values())
+        return self.max_bandwidth * self._running[key].priority.weight / total
+
+    # ------------------------------------------------------------------
+    # Scheduling
+    # ------------------------------------------------------------------
+
+    async def run(
+        self,
+        key: str,
+        priority: DownloadPriority,
+        fn: Callable[[Throttle], Awaitable[T]],
+        *,
+        preemptible: bool = True,
+    ) -> T:
+        """Run ``fn(throttle)`` once a slot is granted; requeue and retry if preempted."""
+        seq = next(self._seq)
+        while True:
+            ticket = _Ticket((-priority.rank, seq), key, priority, preemptible)
+            heapq.heappush(self._queue, ticket)
+            self._dispatch()
+            try:
+                await ticket.ready.wait()
+            except asyncio.CancelledError:
+                ticket.cancelled = True
+                if self._running.get(key) is ticket:
+                    del self._running[key]
+                self._dispatch()
+                raise
+            ticket.task = asyncio.ensure_future(fn(Throttle(self, key)))
+            try:
+                return await ticket.task
+            except asyncio.CancelledError:
+                if not ticket.preempted:
+                    ticket.task.cancel()
+                    raise
+                logger.info("Download {} ({}) preempted; requeued", key, priority.value)
+                priority = ticket.priority
+            finally:
+                if self._running.get(key) is ticket:
+                    del self._running[key]
+                self._dispatch()
+
+    def escalate(self, key: str, priority: DownloadPriority) -> bool:
+        """Raise the priority of a queued or running download; returns True if it changed."""
+        for ticket in self._queue:
+            if ticket.key == key and not ticket.cancelled and priority.rank > ticket.priority.rank:
+                ticket.priority = priority
+                ticket.sort_key = (-priority.rank, ticket.sort_key[1])
+                heapq.heapify(self._queue)
+                self._dispatch()
+                return True
+        ticket = self._running.get(key)
+        if ticket is not None and priority.rank > ticket.priority.rank:
+            ticket.priority = priority
+            return True
+        return False
+
+    def _pop_next(self) -> Optional[_Ticket]:
+        while self._queue:
+            ticket = heapq.heappop(self._queue)
+            if not ticket.cancelled:
+                return ticket
+        return None
+
+    def _peek_next(self) -> Optional[_Ticket]:
+        while self._queue and self._queue[0].cancelled:
+            heapq.heappop(self._queue)
+        return self._queue[0] if self._queue else None
+
+    def _start(self, ticket: _Ticket) -> None:
+        ticket.started_at = time.monotonic()
+        self._running[ticket.key] = ticket
+        ticket.ready.set()
+
+    def _dispatch(self) -> None:
+        while len(self._running) < self.max_concurrent:
+            ticket = self._pop_next()
+            if ticket is None:
+                return
+            self._start(ticket)
+
+        if not self.preemption:
+            return
+        while (head := self._peek_next()) is not None:
+            victim = self._preemption_victim(head.priority)
+            if victim is None:
+                return
+            logger.info(
+                "Preempting download {} ({}) for {} ({})",
+                victim.key, victim.priority.value, head.key, head.priority.value,
+            )
+            victim.preempted = True
+            del self._running[victim.key]
+            victim.task.cancel()
+            self._start(self._pop_next())
+
+    def _preemption_victim(self, priority: DownloadPriority) -> Optional[_Ticket]:
+        """Lowest-priority, most recently started preemptible download below ``priority``."""
+        candidates = [
+            t for t in self._running.values()
+            if t.preemptible and t.task is not None and t.priority.rank < priority.rank
+        ]
+        if not candidates:
+            return None
+        return min(candidates, key=lambda t: (t.priority.rank, -t.started_at))
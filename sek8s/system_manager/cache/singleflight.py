@@ -0,0 +1,97 @@
+"""Cache submodule: bounded TTL cache with per-key singleflight loading.
+
+Concurrent lookups of the same missing key share one load; lookups of
+different keys never wait on each other.  Loads run as their own task, so a
+caller that is cancelled while waiting does not abort the load for the
+others.  Failed loads (exceptions or ``None``) are not cached.  Entries
+expire after ``ttl`` seconds and the least recently used ones are dropped
+to stay within ``max_entries`` and ``max_bytes`` (as measured by ``weigh``).
+"""
+
+from __future__ import annotations
+
+import asyncio
+import time
+from collections import OrderedDict
+from typing import Awaitable, Callable, Generic, Hashable, Optional, TypeVar
+
+K = TypeVar("K", bound=Hashable)
+V = TypeVar("V")
+
+
+class SingleflightCache(Generic[K, V]):
+    def __init__(
+        self,
+        ttl: float,
+        max_entries: int,
+        max_bytes: int = 0,
+        weigh: Optional[Callable[[V], int]] = None,
+    ):
+        self.ttl = ttl
+        self.max_entries = max(1, max_entries)
+        self.max_bytes = max_bytes  # 0 = no byte bound
+        self._weigh = weigh or (lambda _: 0)
+        self._entries: OrderedDict[K, tuple[float, int, V]] = OrderedDict()
+        self._inflight: dict[K, asyncio.Future] = {}
+        self._bytes = 0
+
+    def __len__(self) -> int:
+        return len(self._entries)
+
+    @property
+    def size_bytes(self) -> int:
+        return self._bytes
+
+    def peek(self, key: K) -> Optional[V]:
+        """Cached value if present and fresh (marks it recently used)."""
+        entry = self._entries.get(key)
+        if entry is None:
+            return None
+        expires, _, value = entry
+        if expires <= time.monotonic():
+            self.invalidate(key)
+            return None
+        self._entries.move_to_end(key)
+        return value
+
+    async def get(self, key: K, loader: Callable[[], Awaitable[Optional[V]]]) -> Optional[V]:
+        """Cached value, or the result of ``loader()`` shared with concurrent callers."""
+        value = self.peek(key)
+        if value is not None:
+            return value
+        load = self._inflight.get(key)
+        if load is None:
+            load = asyncio.ensure_future(loader())
+            self._inflight[key] = load
+            load.add_done_callback(lambda f: self._settle(key, f))
+        return await asyncio.shield(load)
+
+    def put(self, key: K, value: V) -> None:
+        self.invalidate(key)
+        weight = self._weigh(value)
+        if self.max_bytes and weight > self.max_bytes:
+            return
+        self._entries[key] = (time.monotonic() + self.ttl, weight, value)
+        self._bytes += weight
+        while len(self._entries) > self.max_entries or (self.max_bytes and self._bytes > self.max_bytes):
+            _, (_, dropped, _) = self._entries.popitem(last=False)
+            self._bytes -= dropped
+
+    def invalidate(self, key: K) -> None:
+        entry = self._entries.pop(key, None)
+        if entry is not None:
+            self._bytes -= entry[1]
+
+    def clear(self) -> None:
+        self._entries.clear()
+        self._bytes = 0
+
+    def _settle(self, key: K, load: asyncio.Future) -> None:
+        if self._inflight.get(key) is load:
+            del self._inflight[key]
+        # Retrieving the exception also keeps asyncio from logging it when every waiter was cancelled
+        if load.cancelled() or load.exception() is not None:
+            return
+        value = load.result()
+        if value is not None:
+            self.put(key, value)
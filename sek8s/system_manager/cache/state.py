@@ -0,0 +1,68 @@
+"""Cache submodule: persisted CacheManager state for fast startup.
+
+The manager's tracked entries (chute id, identity, last reconciliation and
+access statistics for eviction) are written to ``{cache_base}/.cache_state.json``.
+On startup the file is loaded before anything else, so every known chute is
+served with its last known identity and on-disk markers immediately, while
+reconciliation against the validator runs in the background.  The state is a
+hint only: a missing or unreadable file just means identities are fetched
+again and access history starts over.
+"""
+
+from __future__ import annotations
+
+import json
+import os
+from dataclasses import asdict, dataclass
+from pathlib import Path
+from typing import Iterable, Optional
+
+from loguru import logger
+
+CACHE_STATE_FILE = ".cache_state.json"
+_STATE_VERSION = 1
+
+
+@dataclass
+class EntryState:
+    """Persisted identity and access history of one tracked chute cache directory."""
+
+    chute_id: str
+    repo_id: str = ""
+    revision: Optional[str] = None
+    externally_managed: bool = False
+    reconciled_at: Optional[float] = None
+    hits: int = 0
+    last_access: Optional[float] = None
+    lease_until: Optional[float] = None
+
+
+def load_state(cache_base: Path) -> dict[str, EntryState]:
+    """Entries from the state file keyed by chute id; empty if missing or unreadable."""
+    path = Path(cache_base) / CACHE_STATE_FILE
+    try:
+        data = json.loads(path.read_text(encoding="utf-8"))
+        if data.get("version") == _STATE_VERSION:
+            entries = (EntryState(**e) for e in data.get("entries", []))
+            return {e.chute_id: e for e in entries}
+    except FileNotFoundError:
+        pass
+    except (OSError, ValueError, TypeError) as e:
+        logger.warning("Ignoring unreadable cache state {}: {}", path, e)
+    return {}
+
+
+def save_state(cache_base: Path, entries: Iterable[EntryState]) -> None:
+    """Atomically write the state file (write temp file, then rename)."""
+    path = Path(cache_base) / CACHE_STATE_FILE
+    tmp = path.with_name(f"{path.name}.tmp.{os.getpid()}")
+    data = {
+        "version": _STATE_VERSION,
+        "entries": [asdict(e) for e in sorted(entries, key=lambda e: e.chute_id)],
+    }
+    try:
+        tmp.write_text(json.dumps(data, separators=(",", ":")), encoding="utf-8")
+        os.replace(tmp, path)
+    except OSError as e:
+        logger.warning("Could not write cache state {}: {}", path, e)
+        tmp.unlink(missing_ok=True)
@@ -0,0 +1,147 @@
+"""Cache submodule: safetensors tensor index sidecars.
+
+Once a snapshot is verified, the header of every ``.safetensors`` file in it
+is parsed and the tensors of the whole snapshot are written to one sidecar
+next to the chute's marker files: tensor name -> file, dtype, shape, and the
+absolute byte range in that file.  Runtimes read the index (directly or via
+``GET /cache/{chute_id}/tensors``) and mmap only the ranges a shard needs,
+instead of opening every file and parsing its header at startup.
+
+A safetensors file is an 8-byte little-endian header length, a JSON header
+mapping tensor names to ``{"dtype", "shape", "data_offsets": [begin, end]}``
+(offsets relative to the end of the header), then the tensor data.
+"""
+
+from __future__ import annotations
+
+import json
+import os
+import struct
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Optional
+
+from loguru import logger
+
+from .fileio import open_noatime
+
+TENSOR_INDEX_FILE = ".tensor_index.json"
+_INDEX_VERSION = 1
+# The safetensors format caps headers at 100 MB
+_MAX_HEADER_SIZE = 100 * 1024 * 1024
+
+
+@dataclass
+class TensorEntry:
+    """One tensor: its file (index into ``TensorIndex.files``), dtype, shape, and byte range."""
+
+    file: int
+    dtype: str
+    shape: list[int]
+    offset: int  # absolute offset in the file
+    size: int
+
+
+def read_header(path: Path) -> tuple[int, dict]:
+    """Data start offset and parsed header of a safetensors file (blocking); raises ValueError if malformed."""
+    with os.fdopen(open_noatime(path), "rb") as f:
+        prefix = f.read(8)
+        if len(prefix) != 8:
+            raise ValueError(f"{path.name}: too short for a safetensors header")
+        (length,) = struct.unpack("<Q", prefix)
+        if length > _MAX_HEADER_SIZE:
+            raise ValueError(f"{path.name}: header length {length} exceeds {_MAX_HEADER_SIZE}")
+        raw = f.read(length)
+        file_size = os.fstat(f.fileno()).st_size
+    if len(raw) != length:
+        raise ValueError(f"{path.name}: truncated header")
+    header = json.loads(raw)
+    if not isinstance(header, dict):
+        raise ValueError(f"{path.name}: header is not a JSON object")
+    data_start = 8 + length
+    for name, info in header.items():
+        if name == "__metadata__":
+            continue
+        begin, end = info["data_offsets"]
+        if not 0 <= begin <= end or data_start + end > file_size:
+            raise ValueError(f"{path.name}: tensor {name} has invalid offsets {begin}-{end}")
+    return data_start, header
+
+
+@dataclass
+class TensorIndex:
+    """Tensors of every safetensors file of one (repo_id, revision) snapshot."""
+
+    repo_id: str
+    revision: str
+    files: list[str] = field(default_factory=list)  # snapshot-relative paths
+    tensors: dict[str, TensorEntry] = field(default_factory=dict)
+
+    @classmethod
+    def build(cls, snapshot_dir: Path, repo_id: str, revision: str) -> "TensorIndex":
+        """Parse the header of every ``.safetensors`` file under ``snapshot_dir`` (blocking)."""
+        index = cls(repo_id=repo_id, revision=revision)
+        for path in sorted(Path(snapshot_dir).rglob("*.safetensors")):
+            rel_path = path.relative_to(snapshot_dir).as_posix()
+            data_start, header = read_header(path)
+            file_index = len(index.files)
+            index.files.append(rel_path)
+            for name, info in header.items():
+                if name == "__metadata__":
+                    continue
+                if name in index.tensors:
+                    previous = index.files[index.tensors[name].file]
+                    logger.warning("Tensor {} appears in {} and {}", name, previous, rel_path)
+                begin, end = info["data_offsets"]
+                index.tensors[name] = TensorEntry(
+                    file=file_index,
+                    dtype=str(info["dtype"]),
+                    shape=[int(d) for d in info["shape"]],
+                    offset=data_start + begin,
+                    size=end - begin,
+                )
+        return index
+
+    @staticmethod
+    def path_for(cache_dir: Path) -> Path:
+        return Path(cache_dir) / TENSOR_INDEX_FILE
+
+    @classmethod
+    def load(cls, cache_dir: Path, repo_id: str, revision: str) -> Optional["TensorIndex"]:
+        """Load the sidecar; None if missing, unreadable, or for another revision."""
+        path = cls.path_for(cache_dir)
+        try:
+            data = json.loads(path.read_text(encoding="utf-8"))
+            if (
+                data.get("version") == _INDEX_VERSION
+                and data.get("repo_id") == repo_id
+                and data.get("revision") == revision
+            ):
+                # Compact on disk: name -> [file, dtype, shape, offset, size]
+                tensors = {name: TensorEntry(*row) for name, row in data.get("tensors", {}).items()}
+                return cls(repo_id=repo_id, revision=revision, files=list(data.get("files", [])), tensors=tensors)
+        except FileNotFoundError:
+            pass
+        except (OSError, ValueError, TypeError) as e:
+            logger.warning("Ignoring unreadable tensor index {}: {}", path, e)
+        return None
+
+    def save(self, cache_dir: Path) -> None:
+        """Atomically write the sidecar (write temp file, then rename)."""
+        path = self.path_for(cache_dir)
+        tmp = path.with_name(f"{path.name}.tmp.{os.getpid()}")
+        data = {
+            "version": _INDEX_VERSION,
+            "repo_id": self.repo_id,
+            "revision": self.revision,
+            "files": self.files,
+            "tensors": {
+                name: [e.file, e.dtype, e.shape, e.offset, e.size] for name, e in self.tensors.items()
+            },
+        }
+        try:
+            tmp.write_text(json.dumps(data, separators=(",", ":")), encoding="utf-8")
+            os.replace(tmp, path)
+        except OSError as e:
+            logger.warning("Could not write tensor index {}: {}", path, e)
+            tmp.unlink(missing_ok=True)
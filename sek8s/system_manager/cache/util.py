@@ -3,7 +3,9 @@
 from __future__ import annotations
 
 import asyncio
+import json
 import os
+import threading
 from pathlib import Path
 from typing import Optional
 
@@ -14,38 +16,69 @@ from loguru import logger
 from sek8s.config import cache_config
 from sek8s.services.util import sign_request
 
+from .manifest import VerificationManifest
+from .merkle import MerkleManifest
 from .models import HfInfoResponse
+from .singleflight import SingleflightCache
+from .verify import HASH_GIT_BLOB, HASH_SHA256, ContentMismatch, ContentVerifier, HashTask, VerificationProgress
 
-# In-memory cache for /misc/hf_repo_info responses keyed by (repo_id, revision).
-_repo_info_cache: dict[tuple[str, str], dict] = {}
-_repo_info_cache_lock = asyncio.Lock()
+# /misc/hf_repo_info responses keyed by (repo_id, revision); one in-flight request per key.
+_repo_info_cache: SingleflightCache[tuple[str, str], dict] = SingleflightCache(
+    ttl=cache_config.repo_info_cache_ttl,
+    max_entries=cache_config.repo_info_cache_max_entries,
+    max_bytes=cache_config.repo_info_cache_max_mb * 1024 * 1024,
+    weigh=lambda info: len(json.dumps(info)),
+)
+
+_session: Optional[aiohttp.ClientSession] = None
+_session_loop: Optional[asyncio.AbstractEventLoop] = None
+
+
+def get_validator_session() -> aiohttp.ClientSession:
+    """Pooled HTTP session for validator requests, shared by all callers on the running loop."""
+    global _session, _session_loop
+    loop = asyncio.get_running_loop()
+    if _session is None or _session.closed or _session_loop is not loop:
+        _session = aiohttp.ClientSession(
+            connector=aiohttp.TCPConnector(limit=cache_config.validator_max_connections, ttl_dns_cache=300),
+            timeout=aiohttp.ClientTimeout(total=30),
+        )
+        _session_loop = loop
+    return _session
+
+
+async def close_validator_session() -> None:
+    global _session
+    if _session is not None and not _session.closed and _session_loop is asyncio.get_running_loop():
+        await _session.close()
+    _session = None
+
+
+async def _load_repo_info(repo_id: str, rev: str) -> Optional[dict]:
+    params = {"repo_id": repo_id, "repo_type": "model", "revision": rev}
+    hf_token = os.environ.get("HF_TOKEN") or os.environ.get("HUGGING_FACE_HUB_TOKEN")
+    if hf_token:
+        params["hf_token"] = hf_token
+    base = (cache_config.validator_base_url or "").strip().rstrip("/")
+    repo_info_url = f"{base}/misc/hf_repo_info"
+    try:
+        async with get_validator_session().get(repo_info_url, params=params) as resp:
+            if resp.status != 200:
+                return None
+            return await resp.json()
+    except (aiohttp.ClientError, asyncio.TimeoutError):
+        return None
 
 
 async def fetch_repo_info(repo_id: str, revision: str) -> Optional[dict]:
-    """Fetch repo file list from validator /misc/hf_repo_info. Result is cached per (repo_id, revision)."""
+    """Fetch repo file list from validator /misc/hf_repo_info.
+
+    Results are cached per (repo_id, revision) with a TTL and memory bound;
+    concurrent fetches of the same key share one request, and fetches of
+    different keys run in parallel.  Failures are not cached.
+    """
     rev = revision or "main"
-    key = (repo_id, rev)
-    async with _repo_info_cache_lock:
-        if key in _repo_info_cache:
-            return _repo_info_cache[key]
-        params = {"repo_id": repo_id, "repo_type": "model", "revision": rev}
-        hf_token = os.environ.get("HF_TOKEN") or os.environ.get("HUGGING_FACE_HUB_TOKEN")
-        if hf_token:
-            params["hf_token"] = hf_token
-        base = (cache_config.validator_base_url or "").strip().rstrip("/")
-        repo_info_url = f"{base}/misc/hf_repo_info"
-        try:
-            async with aiohttp.ClientSession() as session:
-                async with session.get(
-                    repo_info_url, params=params, timeout=aiohttp.ClientTimeout(total=30)
-                ) as resp:
-                    if resp.status != 200:
-                        return None
-                    repo_info = await resp.json()
-        except (aiohttp.ClientError, asyncio.TimeoutError):
-            return None
-        _repo_info_cache[key] = repo_info
-        return repo_info
+    return await _repo_info_cache.get((repo_id, rev), lambda: _load_repo_info(repo_id, rev))
 
 
 async def fetch_hf_info(chute_id: str) -> HfInfoResponse:
@@ -62,20 +95,15 @@ async def fetch_hf_info(chute_id: str) -> HfInfoResponse:
     url = f"{base}/chutes/{chute_id}/hf_info"
     headers, _ = sign_request(purpose="cache")
     try:
-        async with aiohttp.ClientSession() as session:
-            async with session.get(
-                url,
-                headers=headers,
-                timeout=aiohttp.ClientTimeout(total=30),
-            ) as resp:
-                if resp.status != 200:
-                    text = await resp.text()
-                    raise HTTPException(
-                        status_code=502,
-                        detail={"error": "validator_error", "status": resp.status, "body": text},
-                    )
-                data = await resp.json()
-                return HfInfoResponse.model_validate(data)
+        async with get_validator_session().get(url, headers=headers) as resp:
+            if resp.status != 200:
+                text = await resp.text()
+                raise HTTPException(
+                    status_code=502,
+                    detail={"error": "validator_error", "status": resp.status, "body": text},
+                )
+            data = await resp.json()
+            return HfInfoResponse.model_validate(data)
     except aiohttp.ClientError as e:
         logger.warning("Validator request failed: {}", e)
         raise HTTPException(status_code=502, detail="Validator request failed") from e
@@ -104,12 +132,39 @@ def get_symlink_hash(file_path: Path) -> Optional[str]:
     return None
 
 
+def get_content_verifier() -> ContentVerifier:
+    """ContentVerifier configured from cache_config."""
+    return ContentVerifier(
+        workers=cache_config.verify_workers,
+        read_size=cache_config.verify_read_size_mb * 1024 * 1024,
+        direct_io=cache_config.verify_direct_io,
+    )
+
+
 async def verify_cache(
     repo_id: str,
     revision: str,
     cache_dir: str,
+    *,
+    verify_content: Optional[bool] = None,
+    progress: Optional[VerificationProgress] = None,
+    use_manifest: bool = True,
 ) -> dict:
-    """Verify cached HF model files against the validator manifest; raises on failure."""
+    """Verify cached HF model files against the validator manifest; raises on failure.
+
+    Sizes and blob names are always checked. With ``verify_content`` (default
+    ``cache_config.verify_content``) file contents are hashed as well: sha256 for
+    LFS files, the git blob id for regular files. ``progress`` receives per-file
+    hashing progress and throughput.
+
+    With ``use_manifest``, files recorded in the chute's verification manifest
+    whose stat tuple is unchanged are not re-hashed, and newly hashed files are
+    recorded for the next run.  Hashed files without Merkle leaves get them
+    recorded in the same pass (see ``merkle``), so later damage can be repaired
+    range by range.  Size and content mismatches raise ``ContentMismatch``.
+    """
+    if verify_content is None:
+        verify_content = cache_config.verify_content
     cache_dir_path = Path(cache_dir)
     repo_info = await fetch_repo_info(repo_id, revision)
     if not repo_info:
@@ -147,8 +202,48 @@ async def verify_cache(
         repo_id, revision[:12], len(remote_files), len(local_files),
     )
 
+    manifest: Optional[VerificationManifest] = None
+    if verify_content and use_manifest:
+        manifest = VerificationManifest.load(cache_dir_path, repo_id, revision)
+    merkle: Optional[MerkleManifest] = None
+    leaf_size = cache_config.merkle_leaf_size_mb * 1024 * 1024
+    if verify_content and cache_config.repair_enabled:
+        merkle = MerkleManifest.load(cache_dir_path)
+
     verified = 0
     skipped = 0
+    unchanged = 0
+    hash_tasks: list[HashTask] = []
+    task_stats: dict[str, os.stat_result] = {}
+
+    def _queue_hash(rel_path: str, resolved: Path, expected: str, algorithm: str) -> None:
+        nonlocal unchanged
+        st = resolved.stat()
+        if manifest is not None and manifest.is_verified(rel_path, st, expected, algorithm):
+            unchanged += 1
+            return
+        task_stats[rel_path] = st
+        needs_leaves = merkle is not None and st.st_size > 0 and merkle.get(expected) is None
+        hash_tasks.append(
+            HashTask(rel_path, resolved, expected, st.st_size, algorithm, leaf_size=leaf_size if needs_leaves else 0)
+        )
+
+    async def _record(verified_paths: set[str]) -> None:
+        tasks = [task for task in hash_tasks if task.rel_path in verified_paths]
+        if manifest is not None:
+            for task in tasks:
+                manifest.record(task.rel_path, task_stats[task.rel_path], task.expected, task.algorithm)
+            pruned = manifest.prune(set(remote_files))
+            if tasks or pruned:
+                await asyncio.to_thread(manifest.save, cache_dir_path)
+        if merkle is not None:
+            leaves = [task for task in tasks if task.leaves]
+            for task in leaves:
+                merkle.record(task.expected, task.size, task.leaf_size, task.leaves)
+            pruned = merkle.prune({str(digest) for digest, _ in remote_files.values() if digest})
+            if leaves or pruned:
+                await asyncio.to_thread(merkle.save, cache_dir_path)
+
     for remote_path, (remote_hash, remote_size) in remote_files.items():
         local_path = local_files.get(remote_path)
         if not local_path or (not local_path.exists() and not local_path.is_symlink()):
@@ -157,16 +252,26 @@ async def verify_cache(
                 repo_id, revision[:12], remote_path,
             )
             raise ValueError(f"Missing file: {remote_path}")
-        if remote_hash is None or len(str(remote_hash)) == 40:
+        if remote_hash is None:
             skipped += 1
             continue
         resolved = local_path.resolve()
+        if len(str(remote_hash)) == 40:
+            # Regular (non-LFS) file identified by git blob id; only checkable by content
+            if verify_content:
+                _queue_hash(remote_path, resolved, str(remote_hash), HASH_GIT_BLOB)
+                verified += 1
+            else:
+                skipped += 1
+            continue
         if remote_size is not None and resolved.stat().st_size != remote_size:
             logger.warning(
                 "verify_cache: size mismatch — repo={}, rev={}, file={}, expected={}, actual={}",
                 repo_id, revision[:12], remote_path, remote_size, resolved.stat().st_size,
             )
-            raise ValueError(f"Size mismatch: {remote_path} (expected={remote_size}, actual={resolved.stat().st_size})")
+            raise ContentMismatch(
+                remote_path, f"Size mismatch: {remote_path} (expected={remote_size}, actual={resolved.stat().st_size})"
+            )
         symlink_hash = get_symlink_hash(local_path)
         if symlink_hash and symlink_hash != remote_hash:
             logger.warning(
@@ -174,6 +279,35 @@ async def verify_cache(
                 repo_id, revision[:12], remote_path, remote_hash[:12], symlink_hash[:12],
             )
             raise ValueError(f"Hash mismatch: {remote_path} (expected={remote_hash[:12]}, actual={symlink_hash[:12]})")
+        if verify_content:
+            _queue_hash(remote_path, resolved, str(remote_hash), HASH_SHA256)
         verified += 1
 
-    return {"verified": verified, "skipped": skipped, "total": len(remote_files), "skipped_api_error": False}
+    bytes_hashed = 0
+    if hash_tasks:
+        progress = progress if progress is not None else VerificationProgress()
+        cancel = threading.Event()
+        try:
+            await asyncio.to_thread(get_content_verifier().verify, hash_tasks, progress, cancel)
+        except asyncio.CancelledError:
+            # Stop the hashing threads too; to_thread cannot interrupt them on its own
+            cancel.set()
+            raise
+        except ContentMismatch as e:
+            logger.warning("verify_cache: content mismatch — repo={}, rev={}: {}", repo_id, revision[:12], e)
+            # Keep what did verify, so a re-check after repair only hashes the rest
+            await _record(set(e.verified))
+            raise
+        bytes_hashed = progress.bytes_done
+
+    await _record({task.rel_path for task in hash_tasks})
+
+    return {
+        "verified": verified,
+        "skipped": skipped,
+        "total": len(remote_files),
+        "skipped_api_error": False,
+        "hashed": len(hash_tasks),
+        "unchanged": unchanged,
+        "bytes_hashed": bytes_hashed,
+    }
@@ -0,0 +1,297 @@
+"""Cache submodule: streaming content-hash verification engine.
+
+Hashes cached blobs against the validator manifest with large, page-aligned
+reads (``O_DIRECT`` when the filesystem supports it, so verification does not
+evict hot model weights from the page cache).  Files are spread across a thread
+pool, largest first; within a large file the next chunk is read while the
+current one is hashed.  ``hashlib`` and ``preadv`` both release the GIL, so
+throughput is bounded by the device rather than a single Python thread.
+"""
+
+from __future__ import annotations
+
+import hashlib
+import mmap
+import os
+import threading
+import time
+from concurrent.futures import ThreadPoolExecutor, as_completed
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Callable, Optional
+
+from loguru import logger
+
+from .fileio import open_noatime
+from .merkle import LeafHasher
+
+# O_DIRECT requires buffer, offset and length alignment; 4 KiB covers common block sizes.
+_ALIGNMENT = 4096
+
+HASH_SHA256 = "sha256"
+HASH_GIT_BLOB = "git-sha1"
+
+
+@dataclass
+class FileProgress:
+    """Hashing progress of a single file."""
+
+    path: str
+    size: int
+    bytes_done: int = 0
+    started_at: Optional[float] = None
+    finished_at: Optional[float] = None
+
+    @property
+    def throughput(self) -> Optional[float]:
+        """Bytes/sec for this file (so far, or overall once finished)."""
+        if self.started_at is None:
+            return None
+        elapsed = (self.finished_at or time.monotonic()) - self.started_at
+        return self.bytes_done / elapsed if elapsed > 0 else None
+
+
+@dataclass
+class VerificationProgress:
+    """Aggregate progress of one verification run; safe to read from the event loop."""
+
+    files_total: int = 0
+    bytes_total: int = 0
+    files_done: int = 0
+    bytes_done: int = 0
+    started_at: float = field(default_factory=time.monotonic)
+    finished_at: Optional[float] = None
+    files: dict[str, FileProgress] = field(default_factory=dict)
+    _lock: threading.Lock = field(default_factory=threading.Lock, repr=False)
+
+    def add_file(self, path: str, size: int) -> None:
+        self.files[path] = FileProgress(path=path, size=size)
+        self.files_total += 1
+        self.bytes_total += size
+
+    def _advance(self, path: str, nbytes: int) -> None:
+        with self._lock:
+            fp = self.files[path]
+            if fp.started_at is None:
+                fp.started_at = time.monotonic()
+            fp.bytes_done += nbytes
+            self.bytes_done += nbytes
+
+    def _finish(self, path: str) -> None:
+        with self._lock:
+            self.files[path].finished_at = time.monotonic()
+            self.files_done += 1
+
+    @property
+    def throughput(self) -> Optional[float]:
+        """Aggregate bytes/sec across all workers."""
+        elapsed = (self.finished_at or time.monotonic()) - self.started_at
+        return self.bytes_done / elapsed if elapsed > 0 else None
+
+    @property
+    def percent_complete(self) -> Optional[float]:
+        if self.bytes_total <= 0:
+            return None
+        return min(100.0, 100.0 * self.bytes_done / self.bytes_total)
+
+    def in_flight(self) -> list[FileProgress]:
+        """Files currently being hashed."""
+        with self._lock:
+            return [f for f in self.files.values() if f.started_at and not f.finished_at]
+
+
+class ContentMismatch(ValueError):
+    """A file does not match its expected size or digest; ``verified`` holds files that did."""
+
+    def __init__(self, rel_path: str, message: str, verified: Optional[dict[str, str]] = None):
+        super().__init__(message)
+        self.rel_path = rel_path
+        self.verified = verified or {}
+
+
+@dataclass
+class HashTask:
+    """One file to hash: relative manifest path, resolved blob path, expected digest.
+
+    With ``leaf_size`` set, the Merkle leaf digests of the file are collected
+    into ``leaves`` during the same pass.
+    """
+
+    rel_path: str
+    path: Path
+    expected: str
+    size: int
+    algorithm: str = HASH_SHA256
+    leaf_size: int = 0
+    leaves: Optional[list[str]] = None
+
+
+def _aligned_buffer(size: int) -> mmap.mmap:
+    """Anonymous mmap: page-aligned, as O_DIRECT requires."""
+    return mmap.mmap(-1, size)
+
+
+def _open_for_hashing(path: Path, direct_io: bool) -> tuple[int, bool]:
+    """Open path read-only, preferring O_DIRECT; returns (fd, is_direct)."""
+    if direct_io and hasattr(os, "O_DIRECT"):
+        try:
+            return open_noatime(path, os.O_RDONLY | os.O_DIRECT), True
+        except OSError:
+            # tmpfs, overlayfs and some FUSE filesystems reject O_DIRECT
+            pass
+    fd = open_noatime(path)
+    if hasattr(os, "posix_fadvise"):
+        try:
+            os.posix_fadvise(fd, 0, 0, os.POSIX_FADV_SEQUENTIAL)
+        except OSError:
+            pass
+    return fd, False
+
+
+def new_hasher(algorithm: str, size: int):
+    if algorithm == HASH_GIT_BLOB:
+        # Non-LFS files are identified by their git blob id: sha1("blob <size>\0" + content)
+        hasher = hashlib.sha1()
+        hasher.update(b"blob %d\0" % size)
+        return hasher
+    return hashlib.sha256()
+
+
+def hash_file(
+    path: Path,
+    *,
+    algorithm: str = HASH_SHA256,
+    read_size: int = 16 * 1024 * 1024,
+    direct_io: bool = True,
+    on_bytes: Optional[Callable[[int], None]] = None,
+    cancel: Optional[threading.Event] = None,
+    leaves: Optional[LeafHasher] = None,
+) -> str:
+    """Return the hex digest of path, streaming with double-buffered aligned reads.
+
+    The next chunk is read on a helper thread while the current one is hashed, so
+    a single large file keeps both the device and one core busy.  ``leaves``
+    is fed the same bytes.
+    """
+    read_size = max(_ALIGNMENT, read_size - read_size % _ALIGNMENT)
+    size = os.stat(path).st_size
+    hasher = new_hasher(algorithm, size)
+    fd, _ = _open_for_hashing(path, direct_io)
+    buffers = [_aligned_buffer(read_size), _aligned_buffer(read_size)]
+    try:
+        if size <= read_size:
+            n = os.preadv(fd, [buffers[0]], 0)
+            hasher.update(memoryview(buffers[0])[:n])
+            if leaves is not None:
+                leaves.update(memoryview(buffers[0])[:n])
+            if on_bytes and n:
+                on_bytes(n)
+            return hasher.hexdigest()
+
+        with ThreadPoolExecutor(max_workers=1, thread_name_prefix="hash-read") as reader:
+            offset = 0
+            current = 0
+            pending = reader.submit(os.preadv, fd, [buffers[current]], offset)
+            while True:
+                n = pending.result()
+                if n <= 0:
+                    break
+                if cancel is not None and cancel.is_set():
+                    raise InterruptedError(f"Verification of {path} cancelled")
+                offset += n
+                # Kick off the next read into the other buffer before hashing this one
+                if n == read_size:
+                    pending = reader.submit(os.preadv, fd, [buffers[1 - current]], offset)
+                hasher.update(memoryview(buffers[current])[:n])
+                if leaves is not None:
+                    leaves.update(memoryview(buffers[current])[:n])
+                if on_bytes:
+                    on_bytes(n)
+                if n < read_size:
+                    break
+                current = 1 - current
+        return hasher.hexdigest()
+    finally:
+        os.close(fd)
+        for buf in buffers:
+            buf.close()
+
+
+class ContentVerifier:
+    """Hash many files in parallel and compare against expected digests."""
+
+    def __init__(self, workers: int = 8, read_size: int = 16 * 1024 * 1024, direct_io: bool = True):
+        self.workers = max(1, workers)
+        self.read_size = read_size
+        self.direct_io = direct_io
+
+    def verify(
+        self,
+        tasks: list[HashTask],
+        progress: Optional[VerificationProgress] = None,
+        cancel: Optional[threading.Event] = None,
+    ) -> dict[str, str]:
+        """Hash every task (blocking); return ``{rel_path: digest}``.
+
+        Raises ContentMismatch on the first digest mismatch, after cancelling
+        the remaining work; it carries the digests of files that did match.
+        """
+        progress = progress if progress is not None else VerificationProgress()
+        cancel = cancel if cancel is not None else threading.Event()
+        for task in tasks:
+            progress.add_file(task.rel_path, task.size)
+
+        # Largest files first so one huge shard does not start last and dominate wall time
+        ordered = sorted(tasks, key=lambda t: t.size, reverse=True)
+        results: dict[str, str] = {}
+        try:
+            with ThreadPoolExecutor(max_workers=self.workers, thread_name_prefix="hash") as pool:
+                futures = {
+                    pool.submit(self._hash_one, task, progress, cancel): task for task in ordered
+                }
+                for future in as_completed(futures):
+                    task = futures[future]
+                    digest = future.result()
+                    if digest != task.expected:
+                        cancel.set()
+                        raise ContentMismatch(
+                            task.rel_path,
+                            f"Hash mismatch: {task.rel_path} "
+                            f"(expected={task.expected[:12]}, actual={digest[:12]})",
+                            verified=results,
+                        )
+                    results[task.rel_path] = digest
+        finally:
+            cancel.set()
+            progress.finished_at = time.monotonic()
+
+        rate = progress.throughput
+        logger.info(
+            "Content verification: files={}, bytes={}, throughput={:.1f} MB/s",
+            len(results), progress.bytes_done, (rate or 0) / 1e6,
+        )
+        return results
+
+    def _hash_one(
+        self, task: HashTask, progress: VerificationProgress, cancel: threading.Event
+    ) -> str:
+        if cancel.is_set():
+            raise InterruptedError("Verification cancelled")
+        leaves = LeafHasher(task.leaf_size) if task.leaf_size > 0 else None
+        digest = hash_file(
+            task.path,
+            algorithm=task.algorithm,
+            read_size=self.read_size,
+            direct_io=self.direct_io,
+            on_bytes=lambda n: progress._advance(task.rel_path, n),
+            cancel=cancel,
+            leaves=leaves,
+        )
+        if leaves is not None:
+            task.leaves = leaves.finish()
+        progress._finish(task.rel_path)
+        fp = progress.files[task.rel_path]
+        logger.debug(
+            "Hashed {} ({} bytes, {:.1f} MB/s)", task.rel_path, fp.bytes_done, (fp.throughput or 0) / 1e6
+        )
+        return digest
@@ -0,0 +1,221 @@
+"""Status submodule: independently refreshed sources behind the overview.
+
+Each part of the overview (every unit, the GPUs, the filesystems, the model
+cache) is a ``Source`` with its own refresh interval.  A background loop
+refreshes whichever sources are due, each in its own task, so a slow
+``nvidia-smi`` or ``systemctl`` delays only its own value; the overview
+merges the latest values and reports every source's age and staleness.
+
+Collection starts with the first overview request and stops after
+``_IDLE_SECONDS`` without one.  A request waits (at most ``max_wait``) only
+for sources that have never produced a value; otherwise it returns at once.
+Sources with an in-memory view (units tracked over D-Bus) are read live.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import time
+from collections import Counter
+from datetime import datetime, timezone
+from pathlib import Path
+from typing import Any, Awaitable, Callable, Dict, Iterable, List, Optional
+
+from loguru import logger
+
+from sek8s.config import SystemStatusConfig
+
+from .models import SERVICE_ALLOWLIST
+from .responses import OverviewCacheSummary, OverviewSourceInfo
+from .units import UnitStateTracker
+from .util import collect_service_status, get_filesystems, nvidia_smi_impl, tracked_service_status
+
+SERVICE_REFRESH_SECONDS = 10.0
+GPU_REFRESH_SECONDS = 60.0
+DISK_REFRESH_SECONDS = 60.0
+CACHE_REFRESH_SECONDS = 30.0
+
+_TICK_SECONDS = 1.0
+_IDLE_SECONDS = 600.0
+# A source is stale once it missed this many refreshes
+_STALE_INTERVALS = 2.0
+
+
+class Source:
+    """One overview component: the last value of ``fetch`` and when it was obtained."""
+
+    def __init__(
+        self,
+        name: str,
+        fetch: Callable[[], Awaitable[Any]],
+        interval: float,
+        peek: Optional[Callable[[], Any]] = None,
+    ):
+        self.name = name
+        self.interval = interval
+        self._fetch = fetch
+        self._peek = peek  # cheap synchronous read; its value (when not None) is current
+        self.value: Any = None
+        self.error: Optional[str] = None
+        self.updated_at: Optional[float] = None  # wall clock of the last successful refresh
+        self._updated_mono: Optional[float] = None
+        self._attempted_mono: Optional[float] = None
+        self._inflight: Optional[asyncio.Task] = None
+
+    @property
+    def refreshing(self) -> bool:
+        return self._inflight is not None and not self._inflight.done()
+
+    def due(self, now: float) -> bool:
+        return self._attempted_mono is None or now - self._attempted_mono >= self.interval
+
+    def age(self, now: float) -> Optional[float]:
+        return None if self._updated_mono is None else now - self._updated_mono
+
+    def stale(self, now: float) -> bool:
+        age = self.age(now)
+        return age is None or self.error is not None or age > _STALE_INTERVALS * self.interval
+
+    def refresh(self) -> asyncio.Task:
+        """Start a refresh unless one is already running."""
+        if not self.refreshing:
+            self._attempted_mono = time.monotonic()
+            self._inflight = asyncio.create_task(self._refresh())
+        return self._inflight
+
+    async def _refresh(self) -> None:
+        try:
+            value = await self._fetch()
+        except asyncio.CancelledError:
+            raise
+        except Exception as e:
+            # Keep serving the previous value; the error marks it stale
+            self.error = str(getattr(e, "detail", None) or e) or type(e).__name__
+            logger.warning("Overview source {} failed: {}", self.name, self.error)
+            return
+        self._store(value)
+
+    def _store(self, value: Any) -> None:
+        self.value = value
+        self.error = None
+        self.updated_at = time.time()
+        self._updated_mono = time.monotonic()
+
+    def peek(self) -> None:
+        if self._peek is not None:
+            value = self._peek()
+            if value is not None:
+                self._store(value)
+
+    def cancel(self) -> None:
+        if self._inflight is not None:
+            self._inflight.cancel()
+            self._inflight = None
+
+    def info(self, now: float) -> OverviewSourceInfo:
+        age = self.age(now)
+        return OverviewSourceInfo(
+            updated_at=(
+                datetime.fromtimestamp(self.updated_at, tz=timezone.utc).isoformat()
+                if self.updated_at is not None
+                else None
+            ),
+            age_seconds=round(age, 3) if age is not None else None,
+            refresh_interval_seconds=self.interval,
+            stale=self.stale(now),
+            refreshing=self.refreshing,
+            error=self.error,
+        )
+
+
+class SourceCollector:
+    """Refreshes a set of sources on their own schedules while they are being read."""
+
+    def __init__(self, sources: Iterable[Source], max_wait: float):
+        self.sources: Dict[str, Source] = {source.name: source for source in sources}
+        self.max_wait = max_wait
+        self._task: Optional[asyncio.Task] = None
+        self._last_read = 0.0
+
+    @property
+    def running(self) -> bool:
+        return self._task is not None and not self._task.done()
+
+    async def read(self) -> Dict[str, Source]:
+        """Sources with their latest values; waits at most ``max_wait`` for ones never collected."""
+        self._last_read = time.monotonic()
+        if not self.running:
+            self._task = asyncio.create_task(self._loop())
+        for source in self.sources.values():
+            source.peek()
+        self._refresh_due()
+        cold = [s.refresh() for s in self.sources.values() if s.updated_at is None and s.error is None]
+        if cold:
+            await asyncio.wait(cold, timeout=self.max_wait)
+        return self.sources
+
+    async def stop(self) -> None:
+        if self._task is not None:
+            self._task.cancel()
+            try:
+                await self._task
+            except asyncio.CancelledError:
+                pass
+            self._task = None
+        for source in self.sources.values():
+            source.cancel()
+
+    def _refresh_due(self) -> None:
+        now = time.monotonic()
+        for source in self.sources.values():
+            if source.due(now):
+                source.refresh()
+
+    async def _loop(self) -> None:
+        while time.monotonic() - self._last_read < _IDLE_SECONDS:
+            self._refresh_due()
+            await asyncio.sleep(_TICK_SECONDS)
+        logger.debug("Overview collection idle; stopping background refresh")
+
+
+def _cache_summary(snapshots: List[Any]) -> OverviewCacheSummary:
+    return OverviewCacheSummary(
+        total_size_bytes=sum(s.size_bytes for s in snapshots),
+        chutes=len(snapshots),
+        by_status=dict(Counter(getattr(s.status, "value", str(s.status)) for s in snapshots)),
+    )
+
+
+def build_overview_collector(
+    config: SystemStatusConfig,
+    tracker: Optional[UnitStateTracker] = None,
+    cache_manager: Optional[Any] = None,
+) -> SourceCollector:
+    """Overview sources: one per allow-listed unit, plus GPUs, filesystems and the model cache."""
+    sources = [
+        Source(
+            f"service:{service.service_id}",
+            lambda service=service: collect_service_status(service, config, tolerate_errors=True, tracker=tracker),
+            SERVICE_REFRESH_SECONDS,
+            peek=lambda service=service: tracked_service_status(service, tracker),
+        )
+        for service in SERVICE_ALLOWLIST.values()
+    ]
+    sources.append(Source("gpu", lambda: nvidia_smi_impl(False, "all", lambda: config), GPU_REFRESH_SECONDS))
+
+    async def filesystems():
+        result = await get_filesystems(Path("/"))
+        if result is None:
+            raise RuntimeError("reading filesystem capacity failed")
+        return result
+
+    sources.append(Source("disk", filesystems, DISK_REFRESH_SECONDS))
+
+    if cache_manager is not None:
+        async def cache():
+            await cache_manager.sync_from_disk()
+            return _cache_summary(await cache_manager.all_snapshots())
+
+        sources.append(Source("cache", cache, CACHE_REFRESH_SECONDS))
+
+    return SourceCollector(sources, config.overview_max_wait_seconds)
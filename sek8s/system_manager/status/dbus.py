@@ -0,0 +1,383 @@
+"""Status submodule: minimal asyncio D-Bus client used to follow systemd unit state.
+
+Implements the part of the D-Bus wire protocol the unit tracker needs over
+one unix socket connection: EXTERNAL authentication, method calls with
+replies, and signal delivery.  Values of any signature are (un)marshalled;
+variants are written as ``(signature, value)`` and read back as the plain
+value, dict-entry arrays become dicts and structs become tuples.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import itertools
+import os
+import struct
+from dataclasses import dataclass, field
+from typing import Any, Callable, Dict, List, Optional, Sequence
+
+from loguru import logger
+
+SYSTEM_BUS_ADDRESS = "unix:path=/run/dbus/system_bus_socket"
+BUS_NAME = "org.freedesktop.DBus"
+BUS_PATH = "/org/freedesktop/DBus"
+
+METHOD_CALL = 1
+METHOD_RETURN = 2
+ERROR = 3
+SIGNAL = 4
+
+_HEADER_PATH = 1
+_HEADER_INTERFACE = 2
+_HEADER_MEMBER = 3
+_HEADER_ERROR_NAME = 4
+_HEADER_REPLY_SERIAL = 5
+_HEADER_DESTINATION = 6
+_HEADER_SENDER = 7
+_HEADER_SIGNATURE = 8
+
+_MAX_MESSAGE_SIZE = 128 * 1024 * 1024
+
+_ALIGNMENT = {
+    "y": 1, "b": 4, "n": 2, "q": 2, "i": 4, "u": 4, "x": 8, "t": 8, "d": 8, "h": 4,
+    "s": 4, "o": 4, "g": 1, "a": 4, "(": 8, "{": 8, "v": 1,
+}
+_FIXED_FORMATS = {
+    "y": "B", "b": "I", "n": "h", "q": "H", "i": "i", "u": "I", "x": "q", "t": "Q", "d": "d", "h": "I",
+}
+
+
+class DBusError(Exception):
+    """An error reply (or a protocol failure) with its D-Bus error name."""
+
+    def __init__(self, name: str, message: str = ""):
+        super().__init__(f"{name}: {message}" if message else name)
+        self.name = name
+
+
+def _type_end(signature: str, start: int) -> int:
+    """Index just past the single complete type starting at ``start``."""
+    code = signature[start]
+    if code == "a":
+        return _type_end(signature, start + 1)
+    if code in "({":
+        close = ")" if code == "(" else "}"
+        i = start + 1
+        while signature[i] != close:
+            i = _type_end(signature, i)
+        return i + 1
+    return start + 1
+
+
+def split_signature(signature: str) -> List[str]:
+    """Split a signature into its complete types, e.g. ``"sa{sv}as"`` -> ``["s", "a{sv}", "as"]``."""
+    types, i = [], 0
+    while i < len(signature):
+        end = _type_end(signature, i)
+        types.append(signature[i:end])
+        i = end
+    return types
+
+
+class _Writer:
+    def __init__(self) -> None:
+        self.buf = bytearray()
+
+    def align(self, n: int) -> None:
+        self.buf.extend(b"\0" * (-len(self.buf) % n))
+
+    def write(self, type_: str, value: Any) -> None:
+        code = type_[0]
+        if code in _FIXED_FORMATS:
+            self.align(_ALIGNMENT[code])
+            self.buf += struct.pack("<" + _FIXED_FORMATS[code], int(value) if code == "b" else value)
+        elif code in "so":
+            data = value.encode()
+            self.align(4)
+            self.buf += struct.pack("<I", len(data)) + data + b"\0"
+        elif code == "g":
+            data = value.encode()
+            self.buf += bytes([len(data)]) + data + b"\0"
+        elif code == "v":
+            signature, inner = value
+            self.write("g", signature)
+            self.write(signature, inner)
+        elif code == "a":
+            self.align(4)
+            length_at = len(self.buf)
+            self.buf += b"\0\0\0\0"
+            element = type_[1:]
+            self.align(_ALIGNMENT[element[0]])
+            start = len(self.buf)
+            for item in value.items() if element[0] == "{" else value:
+                self.write(element, item)
+            struct.pack_into("<I", self.buf, length_at, len(self.buf) - start)
+        elif code in "({":
+            self.align(8)
+            for member, item in zip(split_signature(type_[1:-1]), value):
+                self.write(member, item)
+        else:
+            raise DBusError("org.freedesktop.DBus.Error.InvalidSignature", f"cannot marshal {type_!r}")
+
+
+class _Reader:
+    def __init__(self, data: bytes, endian: str):
+        self.data = data
+        self.endian = endian
+        self.pos = 0
+
+    def align(self, n: int) -> None:
+        self.pos += -self.pos % n
+
+    def read(self, type_: str) -> Any:
+        code = type_[0]
+        if code in _FIXED_FORMATS:
+            self.align(_ALIGNMENT[code])
+            fmt = self.endian + _FIXED_FORMATS[code]
+            (value,) = struct.unpack_from(fmt, self.data, self.pos)
+            self.pos += struct.calcsize(fmt)
+            return bool(value) if code == "b" else value
+        if code in "so":
+            self.align(4)
+            (length,) = struct.unpack_from(self.endian + "I", self.data, self.pos)
+            start = self.pos + 4
+            self.pos = start + length + 1
+            return self.data[start:start + length].decode("utf-8", errors="replace")
+        if code == "g":
+            length = self.data[self.pos]
+            start = self.pos + 1
+            self.pos = start + length + 1
+            return self.data[start:start + length].decode("ascii")
+        if code == "v":
+            return self.read(self.read("g"))
+        if code == "a":
+            self.align(4)
+            (length,) = struct.unpack_from(self.endian + "I", self.data, self.pos)
+            self.pos += 4
+            element = type_[1:]
+            self.align(_ALIGNMENT[element[0]])
+            end = self.pos + length
+            if element[0] == "{":
+                entries = {}
+                while self.pos < end:
+                    key, value = self.read(element)
+                    entries[key] = value
+                return entries
+            items = []
+            while self.pos < end:
+                items.append(self.read(element))
+            return items
+        if code in "({":
+            self.align(8)
+            return tuple(self.read(member) for member in split_signature(type_[1:-1]))
+        raise DBusError("org.freedesktop.DBus.Error.InvalidSignature", f"cannot unmarshal {type_!r}")
+
+
+@dataclass
+class Message:
+    type: int
+    serial: int
+    flags: int = 0
+    path: Optional[str] = None
+    interface: Optional[str] = None
+    member: Optional[str] = None
+    error_name: Optional[str] = None
+    reply_serial: Optional[int] = None
+    destination: Optional[str] = None
+    sender: Optional[str] = None
+    signature: str = ""
+    body: List[Any] = field(default_factory=list)
+
+    def encode(self) -> bytes:
+        body = _Writer()
+        for type_, value in zip(split_signature(self.signature), self.body):
+            body.write(type_, value)
+
+        fields = []
+        for code, type_, value in (
+            (_HEADER_PATH, "o", self.path),
+            (_HEADER_INTERFACE, "s", self.interface),
+            (_HEADER_MEMBER, "s", self.member),
+            (_HEADER_ERROR_NAME, "s", self.error_name),
+            (_HEADER_REPLY_SERIAL, "u", self.reply_serial),
+            (_HEADER_DESTINATION, "s", self.destination),
+            (_HEADER_SENDER, "s", self.sender),
+            (_HEADER_SIGNATURE, "g", self.signature or None),
+        ):
+            if value is not None:
+                fields.append((code, (type_, value)))
+
+        header = _Writer()
+        header.buf += struct.pack("<cBBBII", b"l", self.type, self.flags, 1, len(body.buf), self.serial)
+        header.write("a(yv)", fields)
+        header.align(8)
+        return bytes(header.buf + body.buf)
+
+    @classmethod
+    def decode(cls, header: bytes, body: bytes) -> "Message":
+        endian = "<" if header[0:1] == b"l" else ">"
+        msg_type, flags = header[1], header[2]
+        (serial,) = struct.unpack_from(endian + "I", header, 8)
+        reader = _Reader(header, endian)
+        reader.pos = 12
+        fields = dict(reader.read("a(yv)"))
+        signature = fields.get(_HEADER_SIGNATURE, "")
+        body_reader = _Reader(body, endian)
+        return cls(
+            type=msg_type,
+            serial=serial,
+            flags=flags,
+            path=fields.get(_HEADER_PATH),
+            interface=fields.get(_HEADER_INTERFACE),
+            member=fields.get(_HEADER_MEMBER),
+            error_name=fields.get(_HEADER_ERROR_NAME),
+            reply_serial=fields.get(_HEADER_REPLY_SERIAL),
+            destination=fields.get(_HEADER_DESTINATION),
+            sender=fields.get(_HEADER_SENDER),
+            signature=signature,
+            body=[body_reader.read(t) for t in split_signature(signature)],
+        )
+
+
+async def read_message(reader: asyncio.StreamReader) -> Message:
+    """Read one message off the stream; raises IncompleteReadError at EOF."""
+    fixed = await reader.readexactly(16)
+    endian = "<" if fixed[0:1] == b"l" else ">"
+    body_length, _serial, fields_length = struct.unpack_from(endian + "III", fixed, 4)
+    header_length = 16 + fields_length + (-(16 + fields_length) % 8)
+    if header_length + body_length > _MAX_MESSAGE_SIZE:
+        raise DBusError("org.freedesktop.DBus.Error.LimitsExceeded", "message too large")
+    rest = await reader.readexactly(header_length - 16 + body_length)
+    return Message.decode(fixed + rest[: header_length - 16], rest[header_length - 16:])
+
+
+def _socket_path(address: str) -> str:
+    """First unix socket of a D-Bus address string (``unix:path=...`` or ``unix:abstract=...``)."""
+    for entry in address.split(";"):
+        transport, _, params = entry.partition(":")
+        if transport != "unix":
+            continue
+        options = dict(p.split("=", 1) for p in params.split(",") if "=" in p)
+        if "path" in options:
+            return options["path"]
+        if "abstract" in options:
+            return "\0" + options["abstract"]
+    raise DBusError("org.freedesktop.DBus.Error.BadAddress", f"no unix socket in {address!r}")
+
+
+class DBusConnection:
+    """One authenticated bus connection: method calls plus a signal callback list."""
+
+    def __init__(self, reader: asyncio.StreamReader, writer: asyncio.StreamWriter):
+        self._reader = reader
+        self._writer = writer
+        self._serials = itertools.count(1)
+        self._pending: Dict[int, asyncio.Future] = {}
+        self._signal_handlers: List[Callable[[Message], None]] = []
+        self.closed: asyncio.Future = asyncio.get_running_loop().create_future()
+        self.unique_name: Optional[str] = None
+        self._read_task = asyncio.create_task(self._read_loop())
+
+    @classmethod
+    async def connect(cls, address: Optional[str] = None) -> "DBusConnection":
+        """Connect to the system bus (or ``address``), authenticate, and say Hello."""
+        address = address or os.environ.get("DBUS_SYSTEM_BUS_ADDRESS") or SYSTEM_BUS_ADDRESS
+        reader, writer = await asyncio.open_unix_connection(_socket_path(address))
+        try:
+            uid = str(os.geteuid()).encode().hex()
+            writer.write(b"\0AUTH EXTERNAL " + uid.encode() + b"\r\n")
+            await writer.drain()
+            line = await reader.readline()
+            if not line.startswith(b"OK "):
+                raise DBusError("org.freedesktop.DBus.Error.AuthFailed", line.decode(errors="replace").strip())
+            writer.write(b"BEGIN\r\n")
+        except BaseException:
+            writer.close()
+            raise
+        conn = cls(reader, writer)
+        try:
+            (conn.unique_name,) = await conn.call(BUS_NAME, BUS_PATH, BUS_NAME, "Hello")
+        except BaseException:
+            await conn.close()
+            raise
+        return conn
+
+    def add_signal_handler(self, handler: Callable[[Message], None]) -> None:
+        self._signal_handlers.append(handler)
+
+    async def call(
+        self,
+        destination: str,
+        path: str,
+        interface: str,
+        member: str,
+        signature: str = "",
+        body: Sequence[Any] = (),
+        *,
+        timeout: float = 10.0,
+    ) -> List[Any]:
+        """Call a method and return the reply body; raises DBusError for error replies."""
+        if self.closed.done():
+            raise ConnectionError("D-Bus connection is closed")
+        serial = next(self._serials)
+        message = Message(
+            type=METHOD_CALL,
+            serial=serial,
+            path=path,
+            interface=interface,
+            member=member,
+            destination=destination,
+            signature=signature,
+            body=list(body),
+        )
+        future = asyncio.get_running_loop().create_future()
+        self._pending[serial] = future
+        try:
+            self._writer.write(message.encode())
+            await self._writer.drain()
+            reply = await asyncio.wait_for(future, timeout=timeout)
+        finally:
+            self._pending.pop(serial, None)
+        if reply.type == ERROR:
+            text = reply.body[0] if reply.body and isinstance(reply.body[0], str) else ""
+            raise DBusError(reply.error_name or "org.freedesktop.DBus.Error.Failed", text)
+        return reply.body
+
+    async def add_match(self, rule: str) -> None:
+        await self.call(BUS_NAME, BUS_PATH, BUS_NAME, "AddMatch", "s", [rule])
+
+    async def _read_loop(self) -> None:
+        error: Optional[BaseException] = None
+        try:
+            while True:
+                message = await read_message(self._reader)
+                if message.type in (METHOD_RETURN, ERROR):
+                    future = self._pending.get(message.reply_serial)
+                    if future is not None and not future.done():
+                        future.set_result(message)
+                elif message.type == SIGNAL:
+                    for handler in list(self._signal_handlers):
+                        try:
+                            handler(message)
+                        except Exception as e:
+                            logger.warning("D-Bus signal handler failed for {}: {}", message.member, e)
+        except asyncio.CancelledError:
+            error = ConnectionError("D-Bus connection closed")
+        except (asyncio.IncompleteReadError, OSError, DBusError, struct.error, ValueError, KeyError) as e:
+            error = e if isinstance(e, (OSError, DBusError)) else ConnectionError(f"D-Bus connection lost: {e!r}")
+        finally:
+            error = error or ConnectionError("D-Bus connection closed")
+            for future in self._pending.values():
+                if not future.done():
+                    future.set_exception(error)
+            if not self.closed.done():
+                self.closed.set_result(error)
+            self._writer.close()
+
+    async def close(self) -> None:
+        if not self._read_task.done():
+            self._read_task.cancel()
+            try:
+                await self._read_task
+            except asyncio.CancelledError:
+                pass
@@ -0,0 +1,124 @@
+"""Status submodule: native directory size scanner.
+
+``sek8s-dirscan`` (built from ansible/k3s/roles/system-manager/files/sek8s-dirscan.c)
+walks a tree with getdents64/statx on a thread pool and reports the size of
+every directory up to a maximum depth, counting hard-linked files once and
+reporting how many it saw.  Its output is NUL-separated
+``<bytes>\\t<depth>\\t<path>`` records and is read in full, so large trees are
+never truncated the way ``du`` text output is.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import os
+from dataclasses import dataclass
+from pathlib import Path
+from typing import List, Optional
+
+from fastapi import HTTPException
+from loguru import logger
+
+DIRSCAN_BINARY = "/usr/bin/sek8s-dirscan"
+
+
+@dataclass
+class ScanEntry:
+    """A directory and the allocated size of everything below it."""
+
+    path: str
+    depth: int  # 0 for the scanned root
+    size_bytes: int
+
+
+@dataclass
+class ScanResult:
+    entries: List[ScanEntry]
+    errors: int  # entries that could not be read (permissions, races with deletes)
+    hardlinks: int = 0  # multiply-linked files seen (each counted once within this scan only)
+
+
+def parse_records(stdout: bytes) -> List[ScanEntry]:
+    """Parse ``<bytes>\\t<depth>\\t<path>\\0`` records; malformed records are skipped."""
+    entries: List[ScanEntry] = []
+    for record in stdout.split(b"\0"):
+        if not record:
+            continue
+        parts = record.split(b"\t", 2)
+        try:
+            size_bytes, depth = int(parts[0]), int(parts[1])
+            path = parts[2].decode("utf-8", errors="surrogateescape")
+        except (IndexError, ValueError):
+            logger.warning("Failed to parse dirscan record: {!r}", record[:200])
+            continue
+        entries.append(ScanEntry(path=path, depth=depth, size_bytes=size_bytes))
+    return entries
+
+
+def _parse_count(stderr: bytes, name: str) -> int:
+    for line in stderr.decode("utf-8", errors="replace").splitlines():
+        if line.startswith(f"{name}="):
+            try:
+                return int(line.split("=", 1)[1])
+            except ValueError:
+                break
+    return 0
+
+
+async def scan_directories(
+    path: Path,
+    max_depth: int,
+    *,
+    cross_filesystems: bool,
+    excludes: List[str],
+    threads: int,
+    timeout: float,
+) -> Optional[ScanResult]:
+    """Scan ``path`` with sek8s-dirscan.
+
+    Returns None when the scanner is not installed or cannot run (e.g. sudo
+    not yet allowed for it), so callers can fall back to ``du``.  Raises
+    HTTPException(504) on timeout, like ``run_command``.
+    """
+    if not os.access(DIRSCAN_BINARY, os.X_OK):
+        return None
+
+    command = ["sudo", "-n", DIRSCAN_BINARY, "-d", str(max_depth), "-j", str(threads)]
+    if not cross_filesystems:
+        command.append("-x")
+    for exclude in excludes:
+        command.extend(["-e", exclude])
+    command.extend(["--", str(path)])
+    logger.debug("Executing command: {}", command)
+
+    try:
+        process = await asyncio.create_subprocess_exec(
+            *command,
+            stdout=asyncio.subprocess.PIPE,
+            stderr=asyncio.subprocess.PIPE,
+        )
+    except FileNotFoundError:
+        return None
+    try:
+        stdout, stderr = await asyncio.wait_for(process.communicate(), timeout=timeout)
+    except asyncio.TimeoutError as exc:
+        process.kill()
+        await process.wait()
+        logger.error("Command timeout for {}", command)
+        raise HTTPException(
+            status_code=504,
+            detail={"error": "timeout", "command": "sek8s-dirscan"},
+        ) from exc
+
+    if process.returncode != 0:
+        logger.warning(
+            "sek8s-dirscan exited with {}: {}",
+            process.returncode,
+            stderr.decode("utf-8", errors="replace").strip()[:500],
+        )
+        return None
+
+    errors = _parse_count(stderr, "errors")
+    if errors:
+        logger.debug("sek8s-dirscan skipped {} unreadable entries under {}", errors, path)
+    return ScanResult(entries=parse_records(stdout), errors=errors, hardlinks=_parse_count(stderr, "hardlinks"))
@@ -0,0 +1,379 @@
+"""Status submodule: background disk-usage model behind ``/status/disk/space``.
+
+The first request for a path scans its directory tree (sek8s-dirscan or du)
+and keeps every directory's size in memory; later requests at the same or a
+smaller depth are answered from that tree together with its scan time.
+
+Trees are kept fresh in the background:
+
+* directories in a tree are watched with inotify (up to a watch budget,
+  shallowest first); a change marks that directory's subtree dirty, and once
+  the changes settle only that subtree is rescanned and its ancestors'
+  totals are adjusted by the difference (a subtree holding hard-linked
+  files is rescanned from the tree root instead: its own scan counts those
+  once within the subtree only);
+* every tree is fully rescanned on a schedule, which also catches changes
+  deeper than the watched directories;
+* trees nobody asked for within the idle timeout are dropped.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import ctypes
+import errno
+import os
+import struct
+import time
+from dataclasses import dataclass, field
+from datetime import datetime, timezone
+from pathlib import Path
+from typing import Callable, Dict, List, Optional
+
+from loguru import logger
+
+from sek8s.config import SystemStatusConfig
+
+from .util import scan_directory_sizes
+
+# Most trees a model keeps; the least recently requested is dropped beyond this
+_MAX_TREES = 32
+# A dirty subtree is rescanned once it has seen no new change for this long
+_CHANGE_SETTLE_SECONDS = 10.0
+_TICK_SECONDS = 2.0
+
+_IN_CLOSE_WRITE = 0x00000008
+_IN_MOVED_FROM = 0x00000040
+_IN_MOVED_TO = 0x00000080
+_IN_CREATE = 0x00000100
+_IN_DELETE = 0x00000200
+_IN_Q_OVERFLOW = 0x00004000
+_IN_IGNORED = 0x00008000
+_IN_ONLYDIR = 0x01000000
+_IN_NONBLOCK = os.O_NONBLOCK
+_IN_CLOEXEC = os.O_CLOEXEC
+_WATCH_MASK = _IN_CLOSE_WRITE | _IN_MOVED_FROM | _IN_MOVED_TO | _IN_CREATE | _IN_DELETE | _IN_ONLYDIR
+_EVENT_HEADER = struct.Struct("iIII")
+
+
+def _is_within(path: str, ancestor: str) -> bool:
+    return path == ancestor or path.startswith(ancestor.rstrip("/") + "/")
+
+
+@dataclass(eq=False)
+class DiskUsageTree:
+    """Sizes of every directory up to ``max_depth`` below one path."""
+
+    path: str
+    cross_filesystems: bool
+    max_depth: int
+    sizes: Dict[str, tuple[int, int]]  # directory -> (size_bytes, depth); the root is depth 0
+    truncated: bool
+    scanned_at: datetime  # last full scan
+    last_requested: float = field(default_factory=time.monotonic)
+    dirty: Dict[str, float] = field(default_factory=dict)  # directory -> monotonic time of last change
+
+    @classmethod
+    def from_scan(
+        cls,
+        path: str,
+        cross_filesystems: bool,
+        max_depth: int,
+        entries: List[tuple[int, str, int]],
+        root_size: int,
+        truncated: bool,
+    ) -> "DiskUsageTree":
+        sizes = {dir_path: (size_bytes, depth) for size_bytes, dir_path, depth in entries}
+        sizes[path] = (root_size, 0)
+        return cls(
+            path=path,
+            cross_filesystems=cross_filesystems,
+            max_depth=max_depth,
+            sizes=sizes,
+            truncated=truncated,
+            scanned_at=datetime.now(timezone.utc),
+        )
+
+    @property
+    def root_size(self) -> int:
+        return self.sizes[self.path][0]
+
+    def entries(self, max_depth: int) -> List[tuple[int, str, int]]:
+        """``(size_bytes, path, depth)`` for directories at depth 1..max_depth."""
+        return [
+            (size_bytes, dir_path, depth)
+            for dir_path, (size_bytes, depth) in self.sizes.items()
+            if 1 <= depth <= max_depth
+        ]
+
+    def directories(self) -> List[str]:
+        """Directories of the tree, shallowest first."""
+        return [d for d, _ in sorted(self.sizes.items(), key=lambda item: item[1][1])]
+
+    def mark_dirty(self, directory: str) -> bool:
+        if directory not in self.sizes:
+            return False
+        self.dirty[directory] = time.monotonic()
+        return True
+
+    def settled_dirty(self, now: float) -> List[str]:
+        """Dirty directories whose changes have settled, without those inside another one."""
+        if not self.dirty or now - max(self.dirty.values()) < _CHANGE_SETTLE_SECONDS:
+            return []
+        roots: List[str] = []
+        for directory in sorted(self.dirty, key=lambda d: self.sizes.get(d, (0, 0))[1]):
+            if not any(_is_within(directory, r) for r in roots):
+                roots.append(directory)
+        self.dirty.clear()
+        return roots
+
+    def replace_subtree(self, directory: str, entries: List[tuple[int, str, int]], size: int, truncated: bool) -> None:
+        """Swap in a rescan of ``directory`` (entry depths relative to it) and fix ancestor totals."""
+        old_size, base_depth = self.sizes[directory]
+        for dir_path in [d for d in self.sizes if d != directory and _is_within(d, directory)]:
+            del self.sizes[dir_path]
+        for size_bytes, dir_path, depth in entries:
+            self.sizes[dir_path] = (size_bytes, base_depth + depth)
+        self.sizes[directory] = (size, base_depth)
+        self.truncated = self.truncated or truncated
+
+        delta = size - old_size
+        current = directory
+        while delta and current != self.path:
+            parent = os.path.dirname(current)
+            if parent == current or parent not in self.sizes:
+                break
+            parent_size, parent_depth = self.sizes[parent]
+            self.sizes[parent] = (max(0, parent_size + delta), parent_depth)
+            current = parent
+
+
+class _DirWatcher:
+    """inotify watches on a set of directories; reports the directory whose entries changed."""
+
+    def __init__(self, on_change: Callable[[str], None], on_overflow: Callable[[], None]):
+        self._on_change = on_change
+        self._on_overflow = on_overflow
+        self._fd = -1
+        self._libc = None
+        self._wd_paths: Dict[int, str] = {}
+        self._path_wds: Dict[str, int] = {}
+
+    def open(self) -> bool:
+        try:
+            libc = ctypes.CDLL(None, use_errno=True)
+            fd = libc.inotify_init1(_IN_NONBLOCK | _IN_CLOEXEC)
+        except (OSError, AttributeError) as e:
+            logger.info("inotify unavailable, disk usage refreshes on schedule only: {}", e)
+            return False
+        if fd < 0:
+            logger.info(
+                "inotify_init1 failed, disk usage refreshes on schedule only: {}",
+                os.strerror(ctypes.get_errno()),
+            )
+            return False
+        self._libc, self._fd = libc, fd
+        asyncio.get_running_loop().add_reader(fd, self._read_events)
+        return True
+
+    def close(self) -> None:
+        if self._fd >= 0:
+            asyncio.get_running_loop().remove_reader(self._fd)
+            os.close(self._fd)
+            self._fd = -1
+        self._wd_paths.clear()
+        self._path_wds.clear()
+
+    @property
+    def watch_count(self) -> int:
+        return len(self._path_wds)
+
+    def sync(self, wanted: List[str]) -> None:
+        """Watch exactly ``wanted`` (as far as the kernel allows)."""
+        if self._fd < 0:
+            return
+        keep = set(wanted)
+        for path in [p for p in self._path_wds if p not in keep]:
+            wd = self._path_wds.pop(path)
+            self._wd_paths.pop(wd, None)
+            self._libc.inotify_rm_watch(self._fd, wd)
+        for path in wanted:
+            if path in self._path_wds:
+                continue
+            wd = self._libc.inotify_add_watch(self._fd, os.fsencode(path), _WATCH_MASK)
+            if wd < 0:
+                if ctypes.get_errno() == errno.ENOSPC:  # fs.inotify.max_user_watches reached
+                    logger.warning("inotify watch limit reached after {} directories", len(self._path_wds))
+                    break
+                continue
+            self._wd_paths[wd] = path
+            self._path_wds[path] = wd
+
+    def _read_events(self) -> None:
+        try:
+            data = os.read(self._fd, 64 * 1024)
+        except BlockingIOError:
+            return
+        except OSError as e:
+            logger.warning("Reading inotify events failed: {}", e)
+            return
+        offset = 0
+        while offset + _EVENT_HEADER.size <= len(data):
+            wd, mask, _cookie, name_len = _EVENT_HEADER.unpack_from(data, offset)
+            offset += _EVENT_HEADER.size + name_len
+            if mask & _IN_Q_OVERFLOW:
+                self._on_overflow()
+                continue
+            if mask & _IN_IGNORED:
+                path = self._wd_paths.pop(wd, None)
+                if path is not None:
+                    self._path_wds.pop(path, None)
+                continue
+            path = self._wd_paths.get(wd)
+            if path is not None:
+                self._on_change(path)
+
+
+class DiskUsageModel:
+    """In-memory directory trees for the disk-space endpoint, refreshed in the background."""
+
+    def __init__(self, config: SystemStatusConfig):
+        self.config = config
+        self._trees: Dict[tuple[str, bool], DiskUsageTree] = {}
+        self._locks: Dict[tuple[str, bool], asyncio.Lock] = {}
+        self._watcher = _DirWatcher(self._on_change, self._on_overflow)
+        self._watching = False
+        self._task: Optional[asyncio.Task] = None
+
+    async def start(self) -> None:
+        if self._task is not None:
+            return
+        if self.config.disk_usage_max_watches > 0:
+            self._watching = self._watcher.open()
+        self._task = asyncio.create_task(self._refresh_loop())
+
+    async def stop(self) -> None:
+        if self._task is not None:
+            self._task.cancel()
+            try:
+                await self._task
+            except asyncio.CancelledError:
+                pass
+            self._task = None
+        self._watcher.close()
+        self._watching = False
+
+    async def get(self, path: Path, max_depth: int, cross_filesystems: bool) -> DiskUsageTree:
+        """The tree for ``path`` covering at least ``max_depth``, scanning it if not held yet."""
+        key = (str(path), cross_filesystems)
+        tree = self._trees.get(key)
+        if tree is None or tree.max_depth < max_depth:
+            async with self._locks.setdefault(key, asyncio.Lock()):
+                tree = self._trees.get(key)
+                if tree is None or tree.max_depth < max_depth:
+                    tree = await self._scan(key, max_depth)
+        tree.last_requested = time.monotonic()
+        return tree
+
+    async def _scan(self, key: tuple[str, bool], max_depth: int) -> DiskUsageTree:
+        path, cross_filesystems = key
+        entries, root_size, truncated, _ = await scan_directory_sizes(
+            Path(path), self.config, max_depth, cross_filesystems
+        )
+        tree = DiskUsageTree.from_scan(path, cross_filesystems, max_depth, entries, root_size, truncated)
+        previous = self._trees.get(key)
+        if previous is not None:
+            tree.last_requested = previous.last_requested
+        self._trees[key] = tree
+        if len(self._trees) > _MAX_TREES:
+            oldest = min(self._trees, key=lambda k: self._trees[k].last_requested)
+            self._trees.pop(oldest)
+            self._locks.pop(oldest, None)
+        self._sync_watches()
+        return tree
+
+    async def _rescan_subtree(self, tree: DiskUsageTree, directory: str) -> bool:
+        """Rescan one directory of ``tree``; False if only a full rescan gives correct totals."""
+        if directory not in tree.sizes:
+            return True
+        depth = tree.sizes[directory][1]
+        if not os.path.isdir(directory):
+            # Gone: drop it (and its size from the ancestors) until the parent is rescanned
+            tree.replace_subtree(directory, [], 0, False)
+            tree.sizes.pop(directory, None)
+            return True
+        entries, size, truncated, hardlinked = await scan_directory_sizes(
+            Path(directory), self.config, tree.max_depth - depth, tree.cross_filesystems
+        )
+        if hardlinked:
+            # A file also linked outside the subtree would be counted twice in the ancestors
+            return False
+        tree.replace_subtree(directory, entries, size, truncated)
+        return True
+
+    def _sync_watches(self) -> None:
+        if not self._watching:
+            return
+        budget = self.config.disk_usage_max_watches
+        wanted: List[str] = []
+        seen = set()
+        trees = sorted(self._trees.values(), key=lambda t: t.last_requested, reverse=True)
+        for tree in trees:
+            for directory in tree.directories():
+                if len(wanted) >= budget:
+                    break
+                if directory not in seen:
+                    seen.add(directory)
+                    wanted.append(directory)
+        self._watcher.sync(wanted)
+
+    def _on_change(self, directory: str) -> None:
+        for tree in self._trees.values():
+            tree.mark_dirty(directory)
+
+    def _on_overflow(self) -> None:
+        logger.warning("inotify queue overflowed; disk usage trees will be fully rescanned")
+        for tree in self._trees.values():
+            tree.dirty.clear()
+            tree.dirty[tree.path] = time.monotonic()
+
+    async def _refresh_loop(self) -> None:
+        while True:
+            await asyncio.sleep(_TICK_SECONDS)
+            try:
+                await self._refresh_once()
+            except asyncio.CancelledError:
+                raise
+            except Exception as e:
+                logger.warning("Disk usage refresh failed: {}", e)
+
+    async def _refresh_once(self) -> None:
+        now = time.monotonic()
+        refresh_after = self.config.disk_usage_refresh_seconds
+        idle_after = self.config.disk_usage_idle_seconds
+
+        resync = False
+        for key, tree in list(self._trees.items()):
+            if now - tree.last_requested > idle_after:
+                logger.debug("Dropping idle disk usage tree for {}", tree.path)
+                self._trees.pop(key, None)
+                self._locks.pop(key, None)
+                resync = True
+                continue
+
+            async with self._locks.setdefault(key, asyncio.Lock()):
+                if self._trees.get(key) is not tree:
+                    continue
+                changed = tree.settled_dirty(now)
+                age = (datetime.now(timezone.utc) - tree.scanned_at).total_seconds()
+                if age >= refresh_after or tree.path in changed:
+                    await self._scan(key, tree.max_depth)
+                    continue
+                for directory in changed:
+                    if not await self._rescan_subtree(tree, directory):
+                        await self._scan(key, tree.max_depth)
+                        break
+                resync = resync or bool(changed)
+
+        if resync:
+            self._sync_watches()
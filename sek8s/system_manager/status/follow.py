@@ -0,0 +1,249 @@
+"""Status submodule: shared journal followers behind the log streams.
+
+One follower per unit reads new journal entries (a thread blocked in
+``sd_journal_wait``) and fans the formatted lines out to every client
+streaming that unit, so N dashboards tailing k3s cost one journal reader
+plus a list append per line each, instead of N ``journalctl --follow``
+processes.  The follower starts with the first subscriber and stops when the
+last one leaves.
+
+A ``since_usec`` backlog covers the whole window: it is read a page of
+``backlog_lines`` at a time, back to the window start and then forward, so
+no entry of the window is skipped however many there are.
+
+Each subscriber has a bounded buffer.  A client that falls further behind
+than that is dropped: it gets a marker line and its stream ends, so a slow
+reader never holds memory or delays the others.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import socket
+import threading
+from collections import deque
+from dataclasses import dataclass, field
+from datetime import datetime
+from typing import AsyncIterator, Callable, Dict, List, Optional, Tuple
+
+from loguru import logger
+
+from .journal import Journal, JournalEntry, JournalUnavailable, read_page
+
+# journalctl --follow starts with the last 10 entries
+DEFAULT_BACKLOG_LINES = 10
+_WAIT_USEC = 1_000_000  # how often a follower thread checks whether it should stop
+_MAX_BATCH = 1000
+
+Line = Tuple[str, str]  # (cursor, formatted line)
+
+
+def format_short(entry: JournalEntry, hostname: str) -> str:
+    """One entry as journalctl ``--output=short`` prints it."""
+    stamp = datetime.fromtimestamp(entry.realtime_usec / 1e6).strftime("%b %d %H:%M:%S")
+    ident = entry.identifier or "unknown"
+    if entry.pid is not None:
+        ident = f"{ident}[{entry.pid}]"
+    return f"{stamp} {hostname} {ident}: {entry.message}\n"
+
+
+@dataclass(eq=False)
+class _Subscriber:
+    capacity: int
+    buffer: deque = field(default_factory=deque)
+    wake: asyncio.Event = field(default_factory=asyncio.Event)
+    ended: Optional[str] = None  # marker line to send before the stream ends
+
+
+@dataclass(eq=False)
+class _Follower:
+    unit: str
+    subscribers: set = field(default_factory=set)
+    stop: threading.Event = field(default_factory=threading.Event)
+    ready: Optional[asyncio.Future] = None
+
+
+class JournalFollowerHub:
+    """Per-unit journal followers shared by all stream subscribers of that unit."""
+
+    def __init__(
+        self,
+        buffer_lines: int = 2000,
+        open_journal: Callable[[], Journal] = Journal,
+        hostname: Optional[str] = None,
+    ):
+        self.buffer_lines = buffer_lines
+        self._open_journal = open_journal
+        self._hostname = hostname or socket.gethostname()
+        self._followers: Dict[str, _Follower] = {}
+
+    def subscriber_count(self, unit: Optional[str] = None) -> int:
+        followers = self._followers.values() if unit is None else [self._followers.get(unit)]
+        return sum(len(f.subscribers) for f in followers if f is not None)
+
+    @property
+    def follower_count(self) -> int:
+        return len(self._followers)
+
+    async def subscribe(
+        self,
+        unit: str,
+        backlog_lines: int = DEFAULT_BACKLOG_LINES,
+        since_usec: Optional[int] = None,
+    ) -> AsyncIterator[str]:
+        """Yield recent lines of ``unit`` and then new ones until the client goes away.
+
+        The backlog is the last ``backlog_lines`` entries, or with
+        ``since_usec`` every entry from then on, read ``backlog_lines`` a page.
+        """
+        follower = self._followers.get(unit)
+        if follower is None:
+            follower = self._start(unit)
+        sub = _Subscriber(self.buffer_lines)
+        follower.subscribers.add(sub)
+        try:
+            # The follower is positioned at the tail, so the backlog ends where live lines begin;
+            # entries appended in between arrive both ways and are skipped below.  Only the last
+            # ``capacity`` of them can still be buffered (more would have dropped the subscriber).
+            recent: deque = deque(maxlen=sub.capacity)
+            try:
+                await asyncio.shield(follower.ready)
+                async for entry in self._backlog(unit, backlog_lines, since_usec):
+                    recent.append(entry.cursor)
+                    yield format_short(entry, self._hostname)
+            except JournalUnavailable as e:
+                yield f"-- journal unavailable: {e} --\n"
+                return
+            seen = set(recent)
+
+            while True:
+                while sub.buffer:
+                    cursor, line = sub.buffer.popleft()
+                    if seen:
+                        if cursor in seen:
+                            continue
+                        seen.clear()
+                    yield line
+                if sub.ended is not None:
+                    yield sub.ended
+                    return
+                sub.wake.clear()
+                await sub.wake.wait()
+        finally:
+            follower.subscribers.discard(sub)
+            if not follower.subscribers:
+                self._stop(follower)
+
+    async def _backlog(
+        self, unit: str, page_lines: int, since_usec: Optional[int]
+    ) -> AsyncIterator[JournalEntry]:
+        """The backlog entries, oldest first, holding one page in memory at a time."""
+
+        def read(**kwargs):
+            return asyncio.to_thread(
+                read_page, unit, page_lines, since_usec=since_usec, open_journal=self._open_journal, **kwargs
+            )
+
+        page = await read()
+        if since_usec is None:
+            for entry in page.entries:
+                yield entry
+            return
+        # Walk back to the oldest page of the window, then forward from it to the tail
+        forward = False
+        while page.has_more and page.before_cursor:
+            older = await read(before=page.before_cursor)
+            if not older.entries:
+                break
+            page, forward = older, True
+        while True:
+            for entry in page.entries:
+                yield entry
+            if not forward or not page.after_cursor:
+                return
+            page = await read(after=page.after_cursor)
+            forward = page.has_more
+
+    async def close(self) -> None:
+        for follower in list(self._followers.values()):
+            self._end(follower, "-- stream closed: server shutting down --\n")
+            self._stop(follower)
+
+    def _start(self, unit: str) -> _Follower:
+        loop = asyncio.get_running_loop()
+        follower = _Follower(unit, ready=loop.create_future())
+        self._followers[unit] = follower
+        # A dedicated thread: followers live as long as their streams and would
+        # otherwise pin the default executor's workers
+        thread = threading.Thread(
+            target=self._follow, args=(follower, loop), name=f"journal-follow-{unit}", daemon=True
+        )
+        thread.start()
+        logger.debug("Started journal follower for {}", unit)
+        return follower
+
+    def _stop(self, follower: _Follower) -> None:
+        follower.stop.set()
+        if self._followers.get(follower.unit) is follower:
+            del self._followers[follower.unit]
+            logger.debug("Stopped journal follower for {}", follower.unit)
+
+    def _follow(self, follower: _Follower, loop: asyncio.AbstractEventLoop) -> None:
+        """Follower thread: read entries appended after the current tail and hand them to the loop."""
+
+        def call(callback, *args) -> None:
+            try:
+                loop.call_soon_threadsafe(callback, *args)
+            except RuntimeError:  # loop closed
+                follower.stop.set()
+
+        try:
+            with self._open_journal() as journal:
+                journal.match_unit(follower.unit)
+                journal.seek_tail()
+                journal.previous()  # on the last entry: next() now only returns new ones
+                call(_resolve, follower.ready, None)
+                while not follower.stop.is_set():
+                    lines: List[Line] = []
+                    while len(lines) < _MAX_BATCH and journal.next():
+                        entry = journal.entry()
+                        lines.append((entry.cursor, format_short(entry, self._hostname)))
+                    if lines:
+                        call(self._publish, follower, lines)
+                    elif not follower.stop.is_set():
+                        journal.wait(_WAIT_USEC)
+        except JournalUnavailable as e:
+            logger.error("Journal follower for {} failed: {}", follower.unit, e)
+            call(_resolve, follower.ready, e)
+            call(self._end, follower, f"-- journal unavailable: {e} --\n")
+            call(self._stop, follower)
+
+    def _publish(self, follower: _Follower, lines: List[Line]) -> None:
+        for sub in list(follower.subscribers):
+            if sub.ended is not None:
+                continue
+            if len(sub.buffer) + len(lines) > sub.capacity:
+                # Slow client: drop it rather than buffer without bound
+                sub.buffer.clear()
+                sub.ended = f"-- stream dropped: client fell more than {sub.capacity} lines behind --\n"
+                follower.subscribers.discard(sub)
+            else:
+                sub.buffer.extend(lines)
+            sub.wake.set()
+        if not follower.subscribers:
+            self._stop(follower)
+
+    def _end(self, follower: _Follower, marker: str) -> None:
+        for sub in follower.subscribers:
+            if sub.ended is None:
+                sub.ended = marker
+                sub.wake.set()
+
+
+def _resolve(future: asyncio.Future, error: Optional[BaseException]) -> None:
+    if future.done():
+        return
+    if error is None:
+        future.set_result(None)
+    else:
+        future.set_exception(error)
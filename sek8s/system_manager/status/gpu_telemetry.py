@@ -0,0 +1,414 @@
+"""Status submodule: GPU telemetry sampled from NVML into in-memory ring buffers.
+
+A background loop reads every GPU's utilization, memory, power, clocks,
+temperatures and ECC counters through NVML at a fixed interval, and a thread
+waits on NVML's event set for XID errors.  Samples go into fixed-size rings
+per GPU at three resolutions:
+
+* ``raw`` - every sample, for the last 15 minutes;
+* ``1m`` - one-minute averages, for the last 24 hours;
+* ``15m`` - fifteen-minute averages, for the last 7 days.
+
+Gauges are averaged over a bucket; ECC counters keep the bucket's last value.
+Reads are served from memory, so polling the current state or a range costs
+no ``nvidia-smi`` process and no NVML call.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import ctypes
+import math
+import threading
+import time
+from collections import deque
+from dataclasses import dataclass, field
+from typing import Any, Dict, List, Optional, Sequence, Tuple
+
+from loguru import logger
+
+try:
+    import pynvml
+except ImportError:  # pragma: no cover - nvidia-ml-py is a dependency
+    pynvml = None
+
+METRICS: Tuple[str, ...] = (
+    "utilization_gpu_percent",
+    "utilization_memory_percent",
+    "memory_used_bytes",
+    "memory_total_bytes",
+    "power_watts",
+    "power_limit_watts",
+    "clock_graphics_mhz",
+    "clock_sm_mhz",
+    "clock_memory_mhz",
+    "temperature_gpu_c",
+    "temperature_memory_c",
+    "ecc_corrected_total",
+    "ecc_uncorrected_total",
+)
+_COUNTERS = frozenset({"ecc_corrected_total", "ecc_uncorrected_total"})
+
+# (name, bucket seconds or None for every sample, retention seconds)
+TIERS: Tuple[Tuple[str, Optional[float], float], ...] = (
+    ("raw", None, 15 * 60),
+    ("1m", 60.0, 24 * 3600),
+    ("15m", 900.0, 7 * 24 * 3600),
+)
+XID_EVENTS_PER_GPU = 256
+_XID_WAIT_MS = 1000
+
+Point = Tuple[float, Tuple[Optional[float], ...]]
+
+
+class TelemetryUnavailable(Exception):
+    """NVML could not be initialized (no driver or no GPUs)."""
+
+
+class Ring:
+    """Fixed-capacity ring of (timestamp, values) points in time order."""
+
+    def __init__(self, capacity: int):
+        self.capacity = max(1, capacity)
+        self._points: List[Point] = []
+        self._start = 0  # index of the oldest point once the ring is full
+
+    def __len__(self) -> int:
+        return len(self._points)
+
+    def append(self, point: Point) -> None:
+        if len(self._points) < self.capacity:
+            self._points.append(point)
+        else:
+            self._points[self._start] = point
+            self._start = (self._start + 1) % self.capacity
+
+    def _at(self, i: int) -> Point:
+        return self._points[(self._start + i) % len(self._points)]
+
+    def _bisect(self, timestamp: float, right: bool) -> int:
+        # Binary search over the logical (oldest-first) order without copying
+        lo, hi = 0, len(self._points)
+        while lo < hi:
+            mid = (lo + hi) // 2
+            ts = self._at(mid)[0]
+            if ts < timestamp or (right and ts == timestamp):
+                lo = mid + 1
+            else:
+                hi = mid
+        return lo
+
+    def range(self, start: float, end: float) -> List[Point]:
+        first = self._bisect(start, right=False)
+        last = self._bisect(end, right=True)
+        return [self._at(i) for i in range(first, last)]
+
+    def oldest(self) -> Optional[float]:
+        return self._at(0)[0] if self._points else None
+
+    def latest(self) -> Optional[Point]:
+        return self._at(len(self._points) - 1) if self._points else None
+
+
+class _Bucket:
+    """Accumulates samples of one downsampling bucket."""
+
+    def __init__(self, start: float):
+        self.start = start
+        self.sums = [0.0] * len(METRICS)
+        self.counts = [0] * len(METRICS)
+        self.last: List[Optional[float]] = [None] * len(METRICS)
+
+    def add(self, values: Sequence[Optional[float]]) -> None:
+        for i, value in enumerate(values):
+            if value is not None:
+                self.sums[i] += value
+                self.counts[i] += 1
+                self.last[i] = value
+
+    def point(self) -> Point:
+        values = tuple(
+            self.last[i] if name in _COUNTERS else (self.sums[i] / self.counts[i] if self.counts[i] else None)
+            for i, name in enumerate(METRICS)
+        )
+        return self.start, values
+
+
+@dataclass
+class XidEvent:
+    timestamp: float
+    xid: int
+
+
+@dataclass
+class GpuSeries:
+    index: int
+    uuid: str
+    name: str
+    rings: Dict[str, Ring]
+    buckets: Dict[str, Optional[_Bucket]] = field(default_factory=dict)
+    xid_events: deque = field(default_factory=lambda: deque(maxlen=XID_EVENTS_PER_GPU))
+    unsupported: set = field(default_factory=set)
+
+    def add(self, point: Point) -> None:
+        timestamp, values = point
+        for name, bucket_seconds, _ in TIERS:
+            if bucket_seconds is None:
+                self.rings[name].append(point)
+                continue
+            start = math.floor(timestamp / bucket_seconds) * bucket_seconds
+            bucket = self.buckets.get(name)
+            if bucket is not None and bucket.start != start:
+                self.rings[name].append(bucket.point())
+                bucket = None
+            if bucket is None:
+                bucket = self.buckets[name] = _Bucket(start)
+            bucket.add(values)
+
+    def latest(self) -> Optional[Point]:
+        return self.rings["raw"].latest()
+
+
+def _resolution_seconds(name: str, interval: float) -> float:
+    bucket_seconds = dict((n, b) for n, b, _ in TIERS)[name]
+    return interval if bucket_seconds is None else bucket_seconds
+
+
+class GpuTelemetry:
+    """NVML sampler plus per-GPU multi-resolution rings."""
+
+    def __init__(self, interval: float = 1.0, nvml: Any = None):
+        self.interval = interval
+        self._nvml = nvml if nvml is not None else pynvml
+        self._gpus: List[GpuSeries] = []
+        self._handles: List[Any] = []
+        self._task: Optional[asyncio.Task] = None
+        self._stop = threading.Event()
+        self._xid_thread: Optional[threading.Thread] = None
+        self.error: Optional[str] = None
+        self.available = False
+
+    @property
+    def gpus(self) -> List[GpuSeries]:
+        return self._gpus
+
+    def gpu(self, ident: str) -> Optional[GpuSeries]:
+        """GPU by index or UUID (with or without the ``GPU-`` prefix)."""
+        for series in self._gpus:
+            if ident == str(series.index) or ident in (series.uuid, series.uuid.removeprefix("GPU-")):
+                return series
+        return None
+
+    async def start(self) -> None:
+        if self._task is not None:
+            return
+        try:
+            await asyncio.to_thread(self._init)
+        except TelemetryUnavailable as e:
+            self.error = str(e)
+            logger.warning("GPU telemetry disabled: {}", e)
+            return
+        self.available = True
+        self._stop.clear()
+        self._task = asyncio.create_task(self._sample_loop())
+        self._xid_thread = threading.Thread(target=self._watch_xids, name="nvml-xid-events", daemon=True)
+        self._xid_thread.start()
+        logger.info("Sampling {} GPUs every {}s", len(self._gpus), self.interval)
+
+    async def stop(self) -> None:
+        self._stop.set()
+        if self._task is not None:
+            self._task.cancel()
+            try:
+                await self._task
+            except asyncio.CancelledError:
+                pass
+            self._task = None
+        if self._xid_thread is not None:
+            await asyncio.to_thread(self._xid_thread.join)
+            self._xid_thread = None
+        if self.available:
+            self.available = False
+            try:
+                self._nvml.nvmlShutdown()
+            except self._nvml.NVMLError as e:
+                logger.warning("nvmlShutdown failed: {}", e)
+
+    def _init(self) -> None:
+        nvml = self._nvml
+        if nvml is None:
+            raise TelemetryUnavailable("pynvml is not installed")
+        try:
+            nvml.nvmlInit()
+        except nvml.NVMLError as e:
+            raise TelemetryUnavailable(f"NVML: {e}") from e
+        try:
+            count = nvml.nvmlDeviceGetCount()
+            handles = [nvml.nvmlDeviceGetHandleByIndex(i) for i in range(count)]
+            gpus = [
+                GpuSeries(
+                    index=i,
+                    uuid=nvml.nvmlDeviceGetUUID(handle),
+                    name=nvml.nvmlDeviceGetName(handle),
+                    rings={
+                        name: Ring(math.ceil(retention / _resolution_seconds(name, self.interval)))
+                        for name, _, retention in TIERS
+                    },
+                )
+                for i, handle in enumerate(handles)
+            ]
+        except nvml.NVMLError as e:
+            nvml.nvmlShutdown()
+            raise TelemetryUnavailable(f"NVML: {e}") from e
+        if not gpus:
+            nvml.nvmlShutdown()
+            raise TelemetryUnavailable("no GPUs found")
+        self._handles, self._gpus = handles, gpus
+
+    async def _sample_loop(self) -> None:
+        loop = asyncio.get_running_loop()
+        next_at = loop.time()
+        while True:
+            try:
+                samples = await asyncio.to_thread(self._sample_all)
+            except Exception:
+                logger.exception("GPU telemetry sample failed")
+            else:
+                for series, point in zip(self._gpus, samples):
+                    series.add(point)
+            next_at += self.interval
+            now = loop.time()
+            if next_at < now:  # fell behind (slow NVML): skip missed ticks instead of bursting
+                next_at = now
+            await asyncio.sleep(next_at - now)
+
+    def _sample_all(self) -> List[Point]:
+        return [self._sample(series, handle) for series, handle in zip(self._gpus, self._handles)]
+
+    def _read(self, series: GpuSeries, metric: str, call, *args) -> Optional[Any]:
+        """One NVML query; metrics a GPU does not support are not asked for again."""
+        if metric in series.unsupported:
+            return None
+        try:
+            return call(*args)
+        except self._nvml.NVMLError_NotSupported:
+            series.unsupported.add(metric)
+        except self._nvml.NVMLError as e:
+            logger.debug("NVML {} on GPU {} failed: {}", metric, series.index, e)
+        return None
+
+    def _sample(self, series: GpuSeries, handle: Any) -> Point:
+        nvml = self._nvml
+        values: Dict[str, Optional[float]] = {}
+
+        util = self._read(series, "utilization", nvml.nvmlDeviceGetUtilizationRates, handle)
+        if util is not None:
+            values["utilization_gpu_percent"] = util.gpu
+            values["utilization_memory_percent"] = util.memory
+        memory = self._read(series, "memory", nvml.nvmlDeviceGetMemoryInfo, handle)
+        if memory is not None:
+            values["memory_used_bytes"] = memory.used
+            values["memory_total_bytes"] = memory.total
+        power = self._read(series, "power", nvml.nvmlDeviceGetPowerUsage, handle)
+        if power is not None:
+            values["power_watts"] = power / 1000.0
+        limit = self._read(series, "power_limit", nvml.nvmlDeviceGetEnforcedPowerLimit, handle)
+        if limit is not None:
+            values["power_limit_watts"] = limit / 1000.0
+        for metric, clock in (
+            ("clock_graphics_mhz", nvml.NVML_CLOCK_GRAPHICS),
+            ("clock_sm_mhz", nvml.NVML_CLOCK_SM),
+            ("clock_memory_mhz", nvml.NVML_CLOCK_MEM),
+        ):
+            values[metric] = self._read(series, metric, nvml.nvmlDeviceGetClockInfo, handle, clock)
+        values["temperature_gpu_c"] = self._read(
+            series, "temperature_gpu_c", nvml.nvmlDeviceGetTemperature, handle, nvml.NVML_TEMPERATURE_GPU
+        )
+        values["temperature_memory_c"] = self._memory_temperature(series, handle)
+        for metric, error_type in (
+            ("ecc_corrected_total", nvml.NVML_MEMORY_ERROR_TYPE_CORRECTED),
+            ("ecc_uncorrected_total", nvml.NVML_MEMORY_ERROR_TYPE_UNCORRECTED),
+        ):
+            values[metric] = self._read(
+                series, metric, nvml.nvmlDeviceGetTotalEccErrors, handle, error_type, nvml.NVML_VOLATILE_ECC
+            )
+        return time.time(), tuple(
+            None if values.get(name) is None else float(values[name]) for name in METRICS
+        )
+
+    def _memory_temperature(self, series: GpuSeries, handle: Any) -> Optional[float]:
+        """HBM temperature (field value; data-center GPUs only)."""
+        nvml = self._nvml
+        field_id = getattr(nvml, "NVML_FI_DEV_MEMORY_TEMP", None)
+        if field_id is None:
+            return None
+        values = self._read(series, "temperature_memory_c", nvml.nvmlDeviceGetFieldValues, handle, [field_id])
+        if not values or values[0].nvmlReturn != nvml.NVML_SUCCESS:
+            series.unsupported.add("temperature_memory_c")
+            return None
+        value = values[0]
+        if value.valueType == nvml.NVML_VALUE_TYPE_DOUBLE:
+            return value.value.dVal
+        return float(value.value.uiVal)
+
+    def _watch_xids(self) -> None:
+        """Thread: record XID errors reported through an NVML event set until stopped."""
+        nvml = self._nvml
+        try:
+            event_set = nvml.nvmlEventSetCreate()
+        except nvml.NVMLError as e:
+            logger.warning("XID events unavailable: {}", e)
+            return
+        try:
+            by_handle = {}
+            for series, handle in zip(self._gpus, self._handles):
+                try:
+                    nvml.nvmlDeviceRegisterEvents(handle, nvml.nvmlEventTypeXidCriticalError, event_set)
+                    by_handle[_handle_key(handle)] = series
+                except nvml.NVMLError as e:
+                    logger.warning("XID events unavailable on GPU {}: {}", series.index, e)
+            if not by_handle:
+                return
+            wait = getattr(nvml, "nvmlEventSetWait_v2", None) or nvml.nvmlEventSetWait
+            while not self._stop.is_set():
+                try:
+                    event = wait(event_set, _XID_WAIT_MS)
+                except nvml.NVMLError_Timeout:
+                    continue
+                except nvml.NVMLError as e:
+                    logger.warning("Waiting for XID events failed: {}", e)
+                    self._stop.wait(_XID_WAIT_MS / 1000)
+                    continue
+                series = by_handle.get(_handle_key(event.device))
+                if series is not None:
+                    logger.warning("GPU {} reported XID {}", series.index, event.eventData)
+                    series.xid_events.append(XidEvent(time.time(), int(event.eventData)))
+        finally:
+            nvml.nvmlEventSetFree(event_set)
+
+    def resolution_seconds(self, tier: str) -> float:
+        return _resolution_seconds(tier, self.interval)
+
+    def query(
+        self,
+        series: GpuSeries,
+        start: float,
+        end: float,
+        resolution: Optional[str] = None,
+    ) -> Tuple[str, List[Point]]:
+        """Points of ``series`` in [start, end] at ``resolution``, or the finest tier covering ``start``."""
+        if resolution is None:
+            resolution = TIERS[-1][0]
+            for name, _, retention in TIERS:
+                if start >= time.time() - retention:
+                    resolution = name
+                    break
+        return resolution, series.rings[resolution].range(start, end)
+
+
+def _handle_key(handle: Any) -> Any:
+    # NVML device handles are ctypes pointers; events carry a new pointer object to the same device
+    try:
+        return ctypes.cast(handle, ctypes.c_void_p).value
+    except (TypeError, ctypes.ArgumentError):
+        return id(handle)
@@ -0,0 +1,428 @@
+"""Status submodule: journal reader over libsystemd's sd-journal API (ctypes).
+
+Reads a unit's entries straight from the journal files instead of running
+``journalctl`` and truncating its text output:
+
+* pages are anchored on journal cursors, so a client walks back (``before``)
+  or polls forward (``after``) from where the previous page ended without
+  re-reading anything;
+* the priority filter is a journal match and the regex is applied to
+  ``MESSAGE`` while reading, so only matching entries are returned; matching
+  runs in a child process under a time budget, so a pattern that backtracks
+  catastrophically is killed and rejected instead of pinning a worker thread;
+* entries are structured (cursor, timestamp, priority, identifier, pid,
+  message).
+
+sd-journal handles are not thread-safe; each page opens its own handle and
+is read in a worker thread.
+"""
+
+from __future__ import annotations
+
+import contextlib
+import ctypes
+import ctypes.util
+import errno
+import os
+import re
+import select
+import struct
+import subprocess
+import sys
+import threading
+import time
+from dataclasses import dataclass
+from datetime import datetime, timezone
+from typing import Callable, List, Optional
+
+from loguru import logger
+
+_SD_JOURNAL_LOCAL_ONLY = 1 << 0
+# Entries examined per page at most, so a rare regex match cannot pin a worker thread
+MAX_SCANNED_ENTRIES = 200_000
+MAX_PATTERN_LENGTH = 256
+# Seconds of regex matching allowed per page before the pattern is rejected
+MATCH_BUDGET_SECONDS = 5.0
+_MATCH_BATCH = 512
+
+_libsystemd = None
+_libsystemd_lock = threading.Lock()
+
+
+class JournalUnavailable(Exception):
+    """libsystemd is missing or the journal cannot be opened."""
+
+
+def _load_libsystemd() -> ctypes.CDLL:
+    global _libsystemd
+    with _libsystemd_lock:
+        if _libsystemd is not None:
+            return _libsystemd
+        name = ctypes.util.find_library("systemd") or "libsystemd.so.0"
+        try:
+            lib = ctypes.CDLL(name, use_errno=True)
+        except OSError as e:
+            raise JournalUnavailable(f"cannot load libsystemd: {e}") from e
+
+        j = ctypes.c_void_p
+        lib.sd_journal_open.argtypes = [ctypes.POINTER(ctypes.c_void_p), ctypes.c_int]
+        lib.sd_journal_close.argtypes = [j]
+        lib.sd_journal_close.restype = None
+        lib.sd_journal_add_match.argtypes = [j, ctypes.c_char_p, ctypes.c_size_t]
+        lib.sd_journal_add_disjunction.argtypes = [j]
+        lib.sd_journal_add_conjunction.argtypes = [j]
+        lib.sd_journal_seek_head.argtypes = [j]
+        lib.sd_journal_seek_tail.argtypes = [j]
+        lib.sd_journal_seek_cursor.argtypes = [j, ctypes.c_char_p]
+        lib.sd_journal_seek_realtime_usec.argtypes = [j, ctypes.c_uint64]
+        lib.sd_journal_test_cursor.argtypes = [j, ctypes.c_char_p]
+        lib.sd_journal_next.argtypes = [j]
+        lib.sd_journal_previous.argtypes = [j]
+        lib.sd_journal_get_data.argtypes = [
+            j, ctypes.c_char_p, ctypes.POINTER(ctypes.c_void_p), ctypes.POINTER(ctypes.c_size_t),
+        ]
+        lib.sd_journal_get_cursor.argtypes = [j, ctypes.POINTER(ctypes.c_void_p)]
+        lib.sd_journal_get_realtime_usec.argtypes = [j, ctypes.POINTER(ctypes.c_uint64)]
+        lib.sd_journal_set_data_threshold.argtypes = [j, ctypes.c_size_t]
+        lib.sd_journal_get_fd.argtypes = [j]
+        lib.sd_journal_process.argtypes = [j]
+        lib.sd_journal_wait.argtypes = [j, ctypes.c_uint64]
+        lib.free.argtypes = [ctypes.c_void_p]
+        lib.free.restype = None
+        _libsystemd = lib
+        return lib
+
+
+def _check(result: int, what: str) -> int:
+    if result < 0:
+        raise JournalUnavailable(f"{what}: {errno.errorcode.get(-result, -result)}")
+    return result
+
+
+@dataclass
+class JournalEntry:
+    cursor: str
+    realtime_usec: int
+    priority: Optional[int]
+    identifier: Optional[str]
+    pid: Optional[int]
+    message: str
+
+    @property
+    def timestamp(self) -> str:
+        return datetime.fromtimestamp(self.realtime_usec / 1e6, tz=timezone.utc).isoformat()
+
+
+class Journal:
+    """One sd_journal handle on the local system journal (use from one thread at a time)."""
+
+    def __init__(self, data_threshold: int = 64 * 1024):
+        self._lib = _load_libsystemd()
+        handle = ctypes.c_void_p()
+        _check(self._lib.sd_journal_open(ctypes.byref(handle), _SD_JOURNAL_LOCAL_ONLY), "sd_journal_open")
+        self._j = handle
+        self._lib.sd_journal_set_data_threshold(self._j, data_threshold)
+
+    def close(self) -> None:
+        if self._j:
+            self._lib.sd_journal_close(self._j)
+            self._j = ctypes.c_void_p()
+
+    def __enter__(self) -> "Journal":
+        return self
+
+    def __exit__(self, *exc) -> None:
+        self.close()
+
+    def add_match(self, field: str, value: str) -> None:
+        data = f"{field}={value}".encode()
+        _check(self._lib.sd_journal_add_match(self._j, data, len(data)), "sd_journal_add_match")
+
+    def add_disjunction(self) -> None:
+        _check(self._lib.sd_journal_add_disjunction(self._j), "sd_journal_add_disjunction")
+
+    def add_conjunction(self) -> None:
+        _check(self._lib.sd_journal_add_conjunction(self._j), "sd_journal_add_conjunction")
+
+    def match_unit(self, unit: str, priority: Optional[int] = None) -> None:
+        """Entries of ``unit`` (as ``journalctl --unit``: its processes plus systemd's messages about it)."""
+        if priority is not None:
+            for level in range(priority + 1):
+                self.add_match("PRIORITY", str(level))
+            self.add_conjunction()
+        self.add_match("_SYSTEMD_UNIT", unit)
+        self.add_disjunction()
+        self.add_match("_PID", "1")
+        self.add_match("UNIT", unit)
+
+    def seek_head(self) -> None:
+        _check(self._lib.sd_journal_seek_head(self._j), "sd_journal_seek_head")
+
+    def seek_tail(self) -> None:
+        _check(self._lib.sd_journal_seek_tail(self._j), "sd_journal_seek_tail")
+
+    def seek_cursor(self, cursor: str) -> None:
+        result = self._lib.sd_journal_seek_cursor(self._j, cursor.encode())
+        if result == -errno.EINVAL:
+            raise ValueError("invalid journal cursor")
+        _check(result, "sd_journal_seek_cursor")
+
+    def seek_realtime(self, usec: int) -> None:
+        _check(self._lib.sd_journal_seek_realtime_usec(self._j, usec), "sd_journal_seek_realtime_usec")
+
+    def test_cursor(self, cursor: str) -> bool:
+        return self._lib.sd_journal_test_cursor(self._j, cursor.encode()) > 0
+
+    def next(self) -> bool:
+        return _check(self._lib.sd_journal_next(self._j), "sd_journal_next") > 0
+
+    def previous(self) -> bool:
+        return _check(self._lib.sd_journal_previous(self._j), "sd_journal_previous") > 0
+
+    def get(self, field: str) -> Optional[str]:
+        data = ctypes.c_void_p()
+        length = ctypes.c_size_t()
+        result = self._lib.sd_journal_get_data(self._j, field.encode(), ctypes.byref(data), ctypes.byref(length))
+        if result < 0:
+            return None
+        raw = ctypes.string_at(data, length.value)
+        return raw[len(field) + 1:].decode("utf-8", errors="replace")
+
+    def cursor(self) -> str:
+        ptr = ctypes.c_void_p()
+        _check(self._lib.sd_journal_get_cursor(self._j, ctypes.byref(ptr)), "sd_journal_get_cursor")
+        try:
+            return ctypes.string_at(ptr).decode()
+        finally:
+            self._lib.free(ptr)
+
+    def realtime_usec(self) -> int:
+        usec = ctypes.c_uint64()
+        _check(self._lib.sd_journal_get_realtime_usec(self._j, ctypes.byref(usec)), "sd_journal_get_realtime_usec")
+        return usec.value
+
+    def entry(self) -> JournalEntry:
+        priority = self.get("PRIORITY")
+        pid = self.get("_PID")
+        return JournalEntry(
+            cursor=self.cursor(),
+            realtime_usec=self.realtime_usec(),
+            priority=int(priority) if priority and priority.isdigit() else None,
+            identifier=self.get("SYSLOG_IDENTIFIER") or self.get("_COMM"),
+            pid=int(pid) if pid and pid.isdigit() else None,
+            message=self.get("MESSAGE") or "",
+        )
+
+    def wait(self, timeout_usec: int) -> int:
+        """Block until the journal changes or the timeout passes (sd_journal_wait)."""
+        return _check(self._lib.sd_journal_wait(self._j, timeout_usec), "sd_journal_wait")
+
+
+@dataclass
+class JournalPage:
+    entries: List[JournalEntry]  # oldest first
+    before_cursor: Optional[str]  # pass as ``before`` for the next older page
+    after_cursor: Optional[str]  # pass as ``after`` to poll for newer entries
+    has_more: bool  # older (backward) or newer (forward) matching entries may remain
+    scanned: int
+
+
+def compile_pattern(pattern: Optional[str]) -> Optional[re.Pattern]:
+    """Compile a MESSAGE filter; raises ValueError when it is too long or invalid."""
+    if not pattern:
+        return None
+    if len(pattern) > MAX_PATTERN_LENGTH:
+        raise ValueError(f"pattern longer than {MAX_PATTERN_LENGTH} characters")
+    try:
+        return re.compile(pattern)
+    except re.error as e:
+        raise ValueError(f"invalid pattern: {e}") from e
+
+
+# Reads the pattern, then answers each batch of messages with one 0/1 byte per message
+_MATCHER_SOURCE = """
+import re, struct, sys
+stdin, stdout = sys.stdin.buffer, sys.stdout.buffer
+def read(n):
+    data = stdin.read(n)
+    if len(data) < n:
+        sys.exit(0)
+    return data
+flags, size = struct.unpack("<II", read(8))
+pattern = re.compile(read(size).decode("utf-8", "surrogatepass"), flags)
+while True:
+    (count,) = struct.unpack("<I", read(4))
+    found = bytearray(count)
+    for i in range(count):
+        (size,) = struct.unpack("<I", read(4))
+        found[i] = pattern.search(read(size).decode("utf-8", "surrogatepass")) is not None
+    stdout.write(found)
+    stdout.flush()
+"""
+
+
+class _PatternMatcher:
+    """``pattern.search`` over batches of messages in a child process.
+
+    Python's ``re`` backtracks and cannot be interrupted, so the matching runs
+    where it can be killed: once the page's budget is spent the child is
+    killed and ValueError raised.
+    """
+
+    def __init__(self, pattern: re.Pattern, budget: float):
+        self._budget = budget
+        self._deadline = time.monotonic() + budget
+        self._proc = subprocess.Popen(
+            [sys.executable, "-I", "-S", "-c", _MATCHER_SOURCE],
+            stdin=subprocess.PIPE,
+            stdout=subprocess.PIPE,
+        )
+        os.set_blocking(self._proc.stdin.fileno(), False)
+        source = pattern.pattern.encode("utf-8", "surrogatepass")
+        self._write(struct.pack("<II", pattern.flags, len(source)) + source)
+
+    def close(self) -> None:
+        self._proc.kill()
+        self._proc.wait()
+        self._proc.stdin.close()
+        self._proc.stdout.close()
+
+    def __enter__(self) -> "_PatternMatcher":
+        return self
+
+    def __exit__(self, *exc) -> None:
+        self.close()
+
+    def search(self, messages: List[str]) -> List[bool]:
+        payload = [struct.pack("<I", len(messages))]
+        for message in messages:
+            data = message.encode("utf-8", "surrogatepass")
+            payload += [struct.pack("<I", len(data)), data]
+        self._write(b"".join(payload))
+        return [bool(found) for found in self._read(len(messages))]
+
+    def _wait(self, fd: int, writing: bool) -> None:
+        remaining = self._deadline - time.monotonic()
+        watched = ([], [fd]) if writing else ([fd], [])
+        if remaining <= 0 or not any(select.select(*watched, [], remaining)):
+            raise ValueError(f"pattern exceeded the {self._budget:g}s match budget; simplify it")
+
+    def _write(self, data: bytes) -> None:
+        fd = self._proc.stdin.fileno()
+        view = memoryview(data)
+        while view:
+            self._wait(fd, writing=True)
+            try:
+                view = view[os.write(fd, view):]
+            except BlockingIOError:
+                continue
+            except BrokenPipeError as e:
+                raise RuntimeError("pattern matcher exited") from e
+
+    def _read(self, size: int) -> bytes:
+        fd = self._proc.stdout.fileno()
+        data = bytearray()
+        while len(data) < size:
+            self._wait(fd, writing=False)
+            chunk = os.read(fd, size - len(data))
+            if not chunk:
+                raise RuntimeError("pattern matcher exited")
+            data += chunk
+        return bytes(data)
+
+
+def read_page(
+    unit: str,
+    limit: int,
+    *,
+    before: Optional[str] = None,
+    after: Optional[str] = None,
+    since_usec: Optional[int] = None,
+    priority: Optional[int] = None,
+    pattern: Optional[re.Pattern] = None,
+    open_journal: Callable[[], Journal] = Journal,
+) -> JournalPage:
+    """Up to ``limit`` matching entries of ``unit`` (blocking; run in a thread).
+
+    Without ``after`` the page is the newest entries (older than ``before``
+    when given), read backward; with ``after`` it is the entries following
+    that cursor, read forward.  ``since_usec`` bounds how far back to go.
+    """
+    forward = after is not None
+    anchor = after if forward else before
+    entries: List[JournalEntry] = []
+    scanned = 0
+    exhausted = False
+    resume: Optional[str] = None  # where to continue when the scan budget ran out
+    batch: List[JournalEntry] = []  # read but not yet matched against ``pattern``
+
+    def flush() -> None:
+        nonlocal exhausted, resume
+        found = [entry for entry, hit in zip(batch, matcher.search([e.message for e in batch])) if hit]
+        if len(entries) + len(found) > limit:
+            # The page ends inside the batch: the next page starts after its last returned entry
+            exhausted = False
+            resume = None
+        entries.extend(found[: limit - len(entries)])
+        batch.clear()
+
+    with open_journal() as journal, contextlib.ExitStack() as stack:
+        matcher = stack.enter_context(_PatternMatcher(pattern, MATCH_BUDGET_SECONDS)) if pattern else None
+        journal.match_unit(unit, priority)
+        if anchor:
+            journal.seek_cursor(anchor)
+        elif forward:
+            journal.seek_head()
+        else:
+            journal.seek_tail()
+
+        step = journal.next if forward else journal.previous
+        first = True
+        while len(entries) < limit:
+            if scanned >= MAX_SCANNED_ENTRIES:
+                resume = journal.cursor()
+                break
+            if not step():
+                exhausted = True
+                break
+            if first and anchor and journal.test_cursor(anchor):
+                # Seeking to a cursor lands on that entry; it belongs to the previous page
+                first = False
+                continue
+            first = False
+            scanned += 1
+            if since_usec is not None and journal.realtime_usec() < since_usec:
+                if not forward:
+                    exhausted = True
+                    break
+                continue
+            if matcher is None:
+                entries.append(journal.entry())
+                continue
+            batch.append(journal.entry())
+            if len(batch) >= _MATCH_BATCH:
+                flush()
+        if batch:
+            flush()
+
+    if not forward:
+        entries.reverse()
+    logger.debug("Journal page for {}: {} entries, {} scanned", unit, len(entries), scanned)
+
+    oldest = entries[0].cursor if entries else None
+    newest = entries[-1].cursor if entries else None
+    if forward:
+        return JournalPage(
+            entries,
+            before_cursor=oldest or after,
+            after_cursor=resume or newest or after,
+            has_more=not exhausted,
+            scanned=scanned,
+        )
+    return JournalPage(
+        entries,
+        before_cursor=resume or oldest or before,
+        after_cursor=newest or before,
+        has_more=not exhausted,
+        scanned=scanned,
+    )
@@ -46,6 +46,24 @@ class ServiceLogsResponse(BaseModel):
     logs: List[str] = Field(..., description="Log entries")
 
 
+class JournalEntryInfo(BaseModel):
+    cursor: str = Field(..., description="Journal cursor of the entry")
+    timestamp: str = Field(..., description="Entry time (ISO 8601, UTC)")
+    priority: Optional[int] = Field(None, description="Syslog priority (0=emerg .. 7=debug)")
+    identifier: Optional[str] = Field(None, description="Syslog identifier or command name")
+    pid: Optional[int] = Field(None, description="Process ID")
+    message: str = Field(..., description="Log message")
+
+
+class ServiceJournalResponse(BaseModel):
+    service: Dict[str, str] = Field(..., description="Service identifier and unit")
+    entries: List[JournalEntryInfo] = Field(..., description="Matching entries, oldest first")
+    before_cursor: Optional[str] = Field(None, description="Pass as 'before' to fetch the next older page")
+    after_cursor: Optional[str] = Field(None, description="Pass as 'after' to fetch newer entries")
+    has_more: bool = Field(..., description="Whether more entries may remain in the paging direction")
+    scanned: int = Field(..., description="Journal entries examined for this page")
+
+
 class NvidiaSmiResponse(BaseModel):
     command: List[str] = Field(..., description="Command executed")
     exit_code: int = Field(..., description="Command exit code")
@@ -60,11 +78,37 @@ class NvidiaSmiResponse(BaseModel):
     status: str = Field(..., description="Status of the command", example="ok")
 
 
-class OverviewResponse(BaseModel):
-    status: str = Field(..., description="Overall system status", example="ok")
-    services: List[ServiceStatusResponse] = Field(..., description="Status of all monitored services")
-    gpu: NvidiaSmiResponse = Field(..., description="GPU status from nvidia-smi")
-    timestamp: str = Field(..., description="ISO 8601 timestamp of the report")
+class GpuXidEventInfo(BaseModel):
+    timestamp: float = Field(..., description="Unix time the event was received")
+    xid: int = Field(..., description="XID error code")
+
+
+class GpuTelemetryDevice(BaseModel):
+    index: int = Field(..., description="GPU index")
+    uuid: str = Field(..., description="GPU UUID")
+    name: str = Field(..., description="GPU product name")
+    timestamp: Optional[float] = Field(None, description="Unix time of the latest sample")
+    metrics: Dict[str, Optional[float]] = Field(..., description="Latest sample (null when unsupported)")
+    unsupported: List[str] = Field(..., description="Metrics this GPU does not report")
+    xid_events: List[GpuXidEventInfo] = Field(..., description="Recent XID errors, oldest first")
+
+
+class GpuTelemetryResponse(BaseModel):
+    available: bool = Field(..., description="Whether NVML sampling is running")
+    error: Optional[str] = Field(None, description="Why sampling is not running")
+    interval_seconds: float = Field(..., description="Sampling interval")
+    devices: List[GpuTelemetryDevice] = Field(..., description="Per-GPU latest telemetry")
+
+
+class GpuTelemetryHistoryResponse(BaseModel):
+    index: int = Field(..., description="GPU index")
+    uuid: str = Field(..., description="GPU UUID")
+    resolution: str = Field(..., description="Tier the points come from (raw, 1m or 15m)")
+    resolution_seconds: float = Field(..., description="Seconds per point")
+    start: float = Field(..., description="Unix time the range starts")
+    end: float = Field(..., description="Unix time the range ends")
+    timestamps: List[float] = Field(..., description="Unix time of each point (bucket start for averages)")
+    series: Dict[str, List[Optional[float]]] = Field(..., description="Values per metric, aligned with timestamps")
 
 
 class DirectoryInfo(BaseModel):
@@ -91,6 +135,31 @@ class FilesystemInfo(BaseModel):
     used_percent: float = Field(..., description="Percentage of filesystem capacity used")
 
 
+class OverviewSourceInfo(BaseModel):
+    updated_at: Optional[str] = Field(None, description="ISO 8601 time of the last successful refresh")
+    age_seconds: Optional[float] = Field(None, description="Seconds since the last successful refresh")
+    refresh_interval_seconds: float = Field(..., description="How often the source is refreshed")
+    stale: bool = Field(..., description="No value yet, last refresh failed, or refreshes are overdue")
+    refreshing: bool = Field(..., description="Whether a refresh is in progress")
+    error: Optional[str] = Field(None, description="Error of the last refresh, if it failed")
+
+
+class OverviewCacheSummary(BaseModel):
+    total_size_bytes: int = Field(..., description="Total model cache size in bytes")
+    chutes: int = Field(..., description="Number of cached chutes")
+    by_status: Dict[str, int] = Field(..., description="Number of chutes per cache status")
+
+
+class OverviewResponse(BaseModel):
+    status: str = Field(..., description="Overall system status", example="ok")
+    services: List[ServiceStatusResponse] = Field(..., description="Status of all monitored services")
+    gpu: Optional[NvidiaSmiResponse] = Field(None, description="GPU status from nvidia-smi (null until collected)")
+    filesystems: Optional[List[FilesystemInfo]] = Field(None, description="Filesystem capacity (null until collected)")
+    cache: Optional[OverviewCacheSummary] = Field(None, description="Model cache summary (null until collected)")
+    sources: Dict[str, OverviewSourceInfo] = Field(..., description="Age and staleness of each overview source")
+    timestamp: str = Field(..., description="ISO 8601 timestamp of the report")
+
+
 class DiskSpaceResponse(BaseModel):
     path: str = Field(..., description="Parent directory path")
     directories: List[DirectoryInfo] = Field(..., description="List of immediate subdirectories with sizes")
@@ -104,6 +173,12 @@ class DiskSpaceResponse(BaseModel):
         None,
         description="Filesystem capacity (one entry for path's mount, or all mounts when path is /)",
     )
+    scanned_at: Optional[str] = Field(
+        None, description="ISO timestamp of the full directory scan the sizes come from"
+    )
+    age_seconds: Optional[float] = Field(
+        None, description="Seconds since scanned_at (changed subtrees may have been rescanned since)"
+    )
 
 
 class ShutdownResponse(BaseModel):
@@ -3,33 +3,47 @@
 from __future__ import annotations
 
 import asyncio
+import time
 from datetime import datetime, timedelta, timezone
 from functools import lru_cache
+from typing import Optional
 
 from aiocache import cached as aiocache_cached
-from fastapi import APIRouter, Depends, Query
+from fastapi import APIRouter, Depends, HTTPException, Query, Request
 from fastapi.responses import StreamingResponse
 from loguru import logger
 
 from sek8s.config import SystemStatusConfig
 from sek8s.services.util import authorize
 
+from .collectors import SourceCollector
+from .disk_usage import DiskUsageModel
+from .follow import DEFAULT_BACKLOG_LINES, JournalFollowerHub
+from .gpu_telemetry import METRICS, TIERS, GpuSeries, GpuTelemetry
+from .journal import JournalUnavailable, compile_pattern, read_page
 from .models import SERVICE_ALLOWLIST
 from .responses import (
     DiskSpaceResponse,
+    GpuTelemetryDevice,
+    GpuTelemetryHistoryResponse,
+    GpuTelemetryResponse,
+    GpuXidEventInfo,
     HealthResponse,
     NvidiaSmiResponse,
+    JournalEntryInfo,
     OverviewResponse,
     ServiceInfo,
+    ServiceJournalResponse,
     ServiceLogsResponse,
     ServiceStatusResponse,
     ServicesListResponse,
     ShutdownResponse,
 )
+from .units import UnitStateTracker
 from .util import (
+    build_disk_space_response,
     collect_service_status,
-    get_disk_space_diagnostic,
-    get_disk_space_simple,
+    get_filesystems,
     nvidia_smi_impl,
     resolve_service,
     run_command,
@@ -45,6 +59,11 @@ def get_config() -> SystemStatusConfig:
     return SystemStatusConfig()
 
 
+def get_unit_tracker(request: Request) -> Optional[UnitStateTracker]:
+    """FastAPI dependency for the D-Bus unit tracker on app.state (None when disabled)."""
+    return getattr(request.app.state, "unit_tracker", None)
+
+
 @router.get(
     "/health",
     response_model=HealthResponse,
@@ -84,14 +103,14 @@ async def list_services(
     summary="Get service status",
     description="Returns systemd status for a specific service",
 )
-@aiocache_cached(ttl=30)
 async def get_service_status(
     service_id: str,
     config: SystemStatusConfig = Depends(get_config),
+    tracker: Optional[UnitStateTracker] = Depends(get_unit_tracker),
     _auth: bool = Depends(authorize(allow_miner=True, allow_validator=True, purpose="status")),
 ) -> ServiceStatusResponse:
     service = resolve_service(service_id)
-    return await collect_service_status(service, config)
+    return await collect_service_status(service, config, tracker=tracker)
 
 
 @router.get(
@@ -142,57 +161,113 @@ async def get_service_logs(
     )
 
 
+@router.get(
+    "/services/{service_id}/journal",
+    response_model=ServiceJournalResponse,
+    summary="Page through service journal entries",
+    description=(
+        "Returns structured journal entries for a specific service, newest page first. "
+        "Pass 'before' from a response to page further back, or 'after' to fetch newer entries; "
+        "priority and regex filters are applied while reading the journal"
+    ),
+)
+async def get_service_journal(
+    service_id: str,
+    config: SystemStatusConfig = Depends(get_config),
+    limit: int = Query(200, ge=1, description="Maximum number of entries to return"),
+    before: Optional[str] = Query(None, description="Return entries older than this cursor"),
+    after: Optional[str] = Query(None, description="Return entries newer than this cursor"),
+    since_minutes: int = Query(0, ge=0, le=1440, description="Only entries from last N minutes (0 = no filter)"),
+    priority: Optional[int] = Query(None, ge=0, le=7, description="Only entries at this priority or more severe"),
+    grep: Optional[str] = Query(None, description="Only entries whose message matches this regular expression"),
+    _auth: bool = Depends(authorize(allow_miner=True, allow_validator=True, purpose="status")),
+) -> ServiceJournalResponse:
+    service = resolve_service(service_id)
+    if before and after:
+        raise HTTPException(status_code=400, detail="use either before or after, not both")
+    try:
+        pattern = compile_pattern(grep)
+    except ValueError as e:
+        raise HTTPException(status_code=400, detail=str(e))
+
+    since_usec = None
+    if since_minutes > 0:
+        window_limit = min(since_minutes, config.log_window_max_minutes)
+        since_time = datetime.now(timezone.utc) - timedelta(minutes=window_limit)
+        since_usec = int(since_time.timestamp() * 1_000_000)
+
+    try:
+        page = await asyncio.to_thread(
+            read_page,
+            service.unit,
+            max(1, min(limit, config.log_tail_max)),
+            before=before,
+            after=after,
+            since_usec=since_usec,
+            priority=priority,
+            pattern=pattern,
+        )
+    except ValueError as e:
+        raise HTTPException(status_code=400, detail=str(e))
+    except JournalUnavailable as e:
+        logger.error("Journal unavailable: {}", e)
+        raise HTTPException(status_code=503, detail={"error": "journal_unavailable", "message": str(e)})
+
+    return ServiceJournalResponse(
+        service={
+            "id": service.service_id,
+            "unit": service.unit,
+        },
+        entries=[
+            JournalEntryInfo(
+                cursor=entry.cursor,
+                timestamp=entry.timestamp,
+                priority=entry.priority,
+                identifier=entry.identifier,
+                pid=entry.pid,
+                message=entry.message,
+            )
+            for entry in page.entries
+        ],
+        before_cursor=page.before_cursor,
+        after_cursor=page.after_cursor,
+        has_more=page.has_more,
+        scanned=page.scanned,
+    )
+
+
+def get_journal_hub(request: Request) -> JournalFollowerHub:
+    """FastAPI dependency for the shared journal followers on app.state."""
+    return request.app.state.journal_hub
+
+
 @router.get(
     "/services/{service_id}/logs/stream",
     summary="Stream service logs",
-    description="Stream live journal logs for a specific service via journalctl --follow",
+    description=(
+        "Stream live journal logs for a specific service. "
+        "All clients of a service share one journal follower; a client that falls too far behind "
+        "receives a marker line and its stream ends"
+    ),
 )
 async def stream_service_logs(
     service_id: str,
     config: SystemStatusConfig = Depends(get_config),
+    hub: JournalFollowerHub = Depends(get_journal_hub),
     since_minutes: int = Query(0, ge=0, le=1440, description="Only logs from last N minutes (0 = no filter)"),
     _auth: bool = Depends(authorize(allow_miner=True, allow_validator=True, purpose="status")),
 ):
     service = resolve_service(service_id)
-    return StreamingResponse(
-        _stream_journal(service, since_minutes, config),
-        media_type="text/plain",
-    )
-
-
-async def _stream_journal(service, since_minutes: int, config: SystemStatusConfig):
-    """Async generator that follows journalctl output for a service."""
-    command = [
-        "journalctl",
-        f"--unit={service.unit}",
-        "--no-pager",
-        "--output=short",
-        "--follow",
-    ]
-
+    backlog_lines, since_usec = DEFAULT_BACKLOG_LINES, None
     if since_minutes > 0:
         window_limit = min(since_minutes, config.log_window_max_minutes)
         since_time = datetime.now(timezone.utc) - timedelta(minutes=window_limit)
-        command.append(f"--since={since_time.isoformat()}")
-
-    process = await asyncio.create_subprocess_exec(
-        *command,
-        stdout=asyncio.subprocess.PIPE,
-        stderr=asyncio.subprocess.PIPE,
+        backlog_lines, since_usec = config.log_tail_max, int(since_time.timestamp() * 1_000_000)
+    return StreamingResponse(
+        hub.subscribe(service.unit, backlog_lines, since_usec),
+        media_type="text/plain",
     )
 
-    try:
-        async for raw_line in process.stdout:
-            yield raw_line.decode("utf-8", errors="replace")
-    except (asyncio.CancelledError, GeneratorExit):
-        pass
-    finally:
-        try:
-            process.kill()
-        except ProcessLookupError:
-            pass
-        await process.wait()
-
 
 @router.get(
     "/gpu/nvidia-smi",
@@ -209,46 +284,173 @@ async def nvidia_smi(
     return await nvidia_smi_impl(detail, gpu, get_config)
 
 
+def get_gpu_telemetry(request: Request) -> Optional[GpuTelemetry]:
+    """FastAPI dependency for the NVML sampler on app.state (None when disabled)."""
+    return getattr(request.app.state, "gpu_telemetry", None)
+
+
+def _require_telemetry(telemetry: Optional[GpuTelemetry]) -> GpuTelemetry:
+    if telemetry is None or not telemetry.available:
+        raise HTTPException(
+            status_code=503,
+            detail={
+                "error": "gpu_telemetry_unavailable",
+                "message": telemetry.error if telemetry is not None else "GPU telemetry is disabled",
+            },
+        )
+    return telemetry
+
+
+def _telemetry_device(series: GpuSeries) -> GpuTelemetryDevice:
+    latest = series.latest()
+    return GpuTelemetryDevice(
+        index=series.index,
+        uuid=series.uuid,
+        name=series.name,
+        timestamp=latest[0] if latest else None,
+        metrics=dict(zip(METRICS, latest[1])) if latest else {},
+        unsupported=sorted(series.unsupported),
+        xid_events=[GpuXidEventInfo(timestamp=e.timestamp, xid=e.xid) for e in series.xid_events],
+    )
+
+
+@router.get(
+    "/gpu/telemetry",
+    response_model=GpuTelemetryResponse,
+    summary="Get GPU telemetry",
+    description="Returns the latest NVML sample and recent XID errors of every GPU (served from memory)",
+)
+async def gpu_telemetry(
+    telemetry: Optional[GpuTelemetry] = Depends(get_gpu_telemetry),
+    _auth: bool = Depends(authorize(allow_miner=True, allow_validator=True, purpose="status")),
+) -> GpuTelemetryResponse:
+    if telemetry is None:
+        return GpuTelemetryResponse(available=False, error="GPU telemetry is disabled", interval_seconds=0, devices=[])
+    return GpuTelemetryResponse(
+        available=telemetry.available,
+        error=telemetry.error,
+        interval_seconds=telemetry.interval,
+        devices=[_telemetry_device(series) for series in telemetry.gpus],
+    )
+
+
+@router.get(
+    "/gpu/telemetry/{gpu}/history",
+    response_model=GpuTelemetryHistoryResponse,
+    summary="Get GPU telemetry history",
+    description=(
+        "Returns sampled GPU metrics over a time range from in-memory ring buffers: "
+        "raw samples for 15 minutes, 1-minute averages for 24 hours, 15-minute averages for 7 days"
+    ),
+)
+async def gpu_telemetry_history(
+    gpu: str,
+    telemetry: Optional[GpuTelemetry] = Depends(get_gpu_telemetry),
+    since_minutes: int = Query(15, ge=1, le=7 * 24 * 60, description="Range start, in minutes before end"),
+    end: Optional[float] = Query(None, description="Range end as Unix time (default now)"),
+    resolution: Optional[str] = Query(
+        None, description="raw, 1m or 15m (default: the finest tier that covers the range)"
+    ),
+    metrics: Optional[str] = Query(None, description="Comma-separated metric names (default all)"),
+    _auth: bool = Depends(authorize(allow_miner=True, allow_validator=True, purpose="status")),
+) -> GpuTelemetryHistoryResponse:
+    telemetry = _require_telemetry(telemetry)
+    series = telemetry.gpu(gpu)
+    if series is None:
+        raise HTTPException(status_code=404, detail="GPU not found")
+    if resolution is not None and resolution not in {name for name, _, _ in TIERS}:
+        raise HTTPException(status_code=400, detail="resolution must be raw, 1m or 15m")
+    names = [m.strip() for m in metrics.split(",") if m.strip()] if metrics else list(METRICS)
+    unknown = [m for m in names if m not in METRICS]
+    if unknown:
+        raise HTTPException(status_code=400, detail=f"unknown metrics: {', '.join(unknown)}")
+
+    range_end = end if end is not None else datetime.now(timezone.utc).timestamp()
+    range_start = range_end - since_minutes * 60
+    tier, points = telemetry.query(series, range_start, range_end, resolution)
+    columns = [METRICS.index(m) for m in names]
+    return GpuTelemetryHistoryResponse(
+        index=series.index,
+        uuid=series.uuid,
+        resolution=tier,
+        resolution_seconds=telemetry.resolution_seconds(tier),
+        start=range_start,
+        end=range_end,
+        timestamps=[timestamp for timestamp, _ in points],
+        series={name: [values[i] for _, values in points] for name, i in zip(names, columns)},
+    )
+
+
+def get_overview_collector(request: Request) -> SourceCollector:
+    """FastAPI dependency for the overview sources on app.state."""
+    return request.app.state.overview_collector
+
+
 @router.get(
     "/overview",
     response_model=OverviewResponse,
     summary="System overview",
-    description="Returns combined status of all services and GPUs",
+    description=(
+        "Returns combined status of all services, GPUs, filesystems and the model cache. "
+        "Each part is refreshed in the background on its own schedule; 'sources' reports "
+        "the age and staleness of each"
+    ),
 )
-@aiocache_cached(ttl=30)
 async def overview(
-    config: SystemStatusConfig = Depends(get_config),
+    collector: SourceCollector = Depends(get_overview_collector),
     _auth: bool = Depends(authorize(allow_miner=True, allow_validator=True, purpose="status")),
 ) -> OverviewResponse:
-    services = await asyncio.gather(
-        *(
-            collect_service_status(service, config, tolerate_errors=True)
-            for service in SERVICE_ALLOWLIST.values()
-        )
-    )
+    sources = await collector.read()
+    now = time.monotonic()
+
+    services = []
+    for service in SERVICE_ALLOWLIST.values():
+        entry = sources[f"service:{service.service_id}"].value
+        if entry is None:
+            entry = ServiceStatusResponse(
+                service=ServiceInfo(id=service.service_id, unit=service.unit, description=service.description),
+                status=None,
+                healthy=False,
+                error={"error": "not_collected"},
+            )
+        services.append(entry)
 
-    gpu_info = await nvidia_smi_impl(detail=False, gpu="all", get_config_fn=get_config)
-    gpu_healthy = gpu_info.status == "ok"
-    services_healthy = all(entry.healthy for entry in services)
+    gpu_source = sources["gpu"]
+    gpu_info = gpu_source.value
+    gpu_healthy = gpu_info is not None and gpu_info.status == "ok" and not gpu_source.stale(now)
+    services_healthy = all(entry.healthy for entry in services) and not any(
+        sources[f"service:{service_id}"].stale(now) for service_id in SERVICE_ALLOWLIST
+    )
     overall_status = "ok" if services_healthy and gpu_healthy else "degraded"
 
+    cache_source = sources.get("cache")
     return OverviewResponse(
         status=overall_status,
         services=services,
         gpu=gpu_info,
+        filesystems=sources["disk"].value,
+        cache=cache_source.value if cache_source is not None else None,
+        sources={name: source.info(now) for name, source in sources.items()},
         timestamp=datetime.now(timezone.utc).isoformat(),
     )
 
 
+async def get_disk_usage(request: Request) -> DiskUsageModel:
+    """FastAPI dependency that pulls the DiskUsageModel off app.state."""
+    return request.app.state.disk_usage
+
+
 @router.get(
     "/disk/space",
     response_model=DiskSpaceResponse,
     summary="Get directory sizes",
-    description="Returns sizes of immediate subdirectories within a given path",
+    description=(
+        "Returns sizes of immediate subdirectories within a given path. Sizes come from an "
+        "in-memory tree refreshed in the background (see scanned_at); filesystem capacity is live."
+    ),
 )
-@aiocache_cached(ttl=120)
 async def get_disk_space(
-    config: SystemStatusConfig = Depends(get_config),
+    model: DiskUsageModel = Depends(get_disk_usage),
     path: str = Query("/", description="Directory path to analyze"),
     diagnostic: bool = Query(
         False, description="Enable diagnostic mode for deep analysis"
@@ -266,12 +468,23 @@ async def get_disk_space(
     _auth: bool = Depends(authorize(allow_miner=True, allow_validator=True, purpose="status")),
 ):
     validated_path = validate_path(path)
+    depth = max_depth if diagnostic else 1
 
-    if diagnostic:
-        return await get_disk_space_diagnostic(
-            validated_path, config, max_depth, top_n, cross_filesystems
-        )
-    return await get_disk_space_simple(validated_path, config, cross_filesystems)
+    tree, filesystems = await asyncio.gather(
+        model.get(validated_path, depth, cross_filesystems),
+        get_filesystems(validated_path),
+    )
+    return build_disk_space_response(
+        validated_path,
+        tree.entries(depth),
+        tree.root_size,
+        truncated=tree.truncated,
+        filesystems=filesystems,
+        diagnostic=diagnostic,
+        max_depth=max_depth,
+        top_n=top_n,
+        scanned_at=tree.scanned_at,
+    )
 
 
 @router.post(
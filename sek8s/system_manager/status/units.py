@@ -0,0 +1,181 @@
+"""Status submodule: systemd unit state tracker over D-Bus.
+
+Holds one system bus connection to systemd, subscribes to ``PropertiesChanged``
+on the object of every allow-listed unit, and keeps their state in memory, so
+service status and the overview are lookups instead of one ``systemctl show``
+per unit per request, and changes show up as soon as systemd reports them.
+
+While the bus is unavailable (not connected yet, systemd or dbus restarting)
+``status`` returns None and callers fall back to ``systemctl``; the tracker
+reconnects in the background and reloads every unit's state.
+"""
+
+from __future__ import annotations
+
+import asyncio
+from typing import Any, Dict, Iterable, Optional
+
+from loguru import logger
+
+from .dbus import DBusConnection, DBusError, Message
+from .models import SERVICE_ALLOWLIST, ServiceDefinition
+from .responses import ServiceStatus
+
+SYSTEMD_BUS_NAME = "org.freedesktop.systemd1"
+SYSTEMD_PATH = "/org/freedesktop/systemd1"
+MANAGER_INTERFACE = "org.freedesktop.systemd1.Manager"
+UNIT_INTERFACE = "org.freedesktop.systemd1.Unit"
+SERVICE_INTERFACE = "org.freedesktop.systemd1.Service"
+PROPERTIES_INTERFACE = "org.freedesktop.DBus.Properties"
+
+# Properties collect_service_status reads via systemctl show, by interface
+_TRACKED_PROPERTIES = {
+    UNIT_INTERFACE: ("Id", "LoadState", "ActiveState", "SubState", "UnitFileState"),
+    SERVICE_INTERFACE: ("MainPID", "ExecMainStatus", "ExecMainCode"),
+}
+
+_RECONNECT_MIN_SECONDS = 2.0
+_RECONNECT_MAX_SECONDS = 60.0
+
+
+def _text(value: Any) -> Optional[str]:
+    return None if value is None else str(value)
+
+
+def status_from_properties(props: Dict[str, Any]) -> ServiceStatus:
+    """ServiceStatus from D-Bus property values, formatted the way systemctl show prints them."""
+    return ServiceStatus(
+        load_state=_text(props.get("LoadState")),
+        active_state=_text(props.get("ActiveState")),
+        sub_state=_text(props.get("SubState")),
+        unit_file_state=_text(props.get("UnitFileState")),
+        main_pid=_text(props.get("MainPID")),
+        exit_code=_text(props.get("ExecMainCode")),
+        exit_status=_text(props.get("ExecMainStatus")),
+    )
+
+
+class UnitStateTracker:
+    """In-memory state of a fixed set of systemd units, kept current by D-Bus signals."""
+
+    def __init__(self, services: Optional[Iterable[ServiceDefinition]] = None, address: Optional[str] = None):
+        services = SERVICE_ALLOWLIST.values() if services is None else services
+        self._units = [service.unit for service in services]
+        self._address = address
+        self._props: Dict[str, Dict[str, Any]] = {}
+        self._paths: Dict[str, str] = {}  # object path -> unit
+        self._conn: Optional[DBusConnection] = None
+        self._synced = False
+        self._task: Optional[asyncio.Task] = None
+        self._refreshes: set[asyncio.Task] = set()
+
+    @property
+    def connected(self) -> bool:
+        return self._synced and self._conn is not None and not self._conn.closed.done()
+
+    def status(self, unit: str) -> Optional[ServiceStatus]:
+        """Current state of ``unit``; None if it is not tracked or the bus is unavailable."""
+        if not self.connected or unit not in self._props:
+            return None
+        return status_from_properties(self._props[unit])
+
+    async def start(self) -> None:
+        if self._task is None:
+            self._task = asyncio.create_task(self._run())
+
+    async def stop(self) -> None:
+        if self._task is not None:
+            self._task.cancel()
+            try:
+                await self._task
+            except asyncio.CancelledError:
+                pass
+            self._task = None
+
+    async def _run(self) -> None:
+        delay = _RECONNECT_MIN_SECONDS
+        while True:
+            try:
+                await self._session()
+                delay = _RECONNECT_MIN_SECONDS
+                logger.warning("systemd D-Bus connection lost; using systemctl until it is back")
+            except (OSError, ConnectionError, DBusError, asyncio.TimeoutError) as e:
+                logger.warning("systemd D-Bus unavailable, using systemctl: {}", e)
+            await asyncio.sleep(delay)
+            delay = min(delay * 2, _RECONNECT_MAX_SECONDS)
+
+    async def _session(self) -> None:
+        """Connect, subscribe, load every unit, then wait until the connection drops."""
+        conn = await DBusConnection.connect(self._address)
+        self._conn = conn
+        try:
+            conn.add_signal_handler(self._on_signal)
+            await conn.add_match(
+                f"type='signal',sender='{SYSTEMD_BUS_NAME}',path='{SYSTEMD_PATH}',"
+                f"interface='{MANAGER_INTERFACE}',member='Reloading'"
+            )
+            # Without a subscriber systemd does not emit unit signals
+            await conn.call(SYSTEMD_BUS_NAME, SYSTEMD_PATH, MANAGER_INTERFACE, "Subscribe")
+
+            for unit in self._units:
+                (path,) = await conn.call(SYSTEMD_BUS_NAME, SYSTEMD_PATH, MANAGER_INTERFACE, "LoadUnit", "s", [unit])
+                self._paths[path] = unit
+                await conn.add_match(
+                    f"type='signal',sender='{SYSTEMD_BUS_NAME}',path='{path}',"
+                    f"interface='{PROPERTIES_INTERFACE}',member='PropertiesChanged'"
+                )
+                await self._load(conn, unit, path)
+
+            self._synced = True
+            logger.info("Tracking {} systemd units over D-Bus", len(self._units))
+            await asyncio.shield(conn.closed)
+        finally:
+            self._synced = False
+            self._conn = None
+            self._paths.clear()
+            self._props.clear()
+            for task in list(self._refreshes):
+                task.cancel()
+            await conn.close()
+
+    async def _load(self, conn: DBusConnection, unit: str, path: str) -> None:
+        props: Dict[str, Any] = {}
+        for interface, names in _TRACKED_PROPERTIES.items():
+            if interface == SERVICE_INTERFACE and not unit.endswith(".service"):
+                continue
+            (values,) = await conn.call(SYSTEMD_BUS_NAME, path, PROPERTIES_INTERFACE, "GetAll", "s", [interface])
+            props.update({name: values[name] for name in names if name in values})
+        self._props.setdefault(unit, {}).update(props)
+
+    def _reload(self, units: Iterable[str]) -> None:
+        conn = self._conn
+        if conn is None:
+            return
+        paths = {unit: path for path, unit in self._paths.items()}
+
+        async def _reload_units() -> None:
+            for unit in units:
+                try:
+                    await self._load(conn, unit, paths[unit])
+                except (ConnectionError, DBusError, asyncio.TimeoutError) as e:
+                    logger.warning("Reloading D-Bus state of {} failed: {}", unit, e)
+
+        task = asyncio.create_task(_reload_units())
+        self._refreshes.add(task)
+        task.add_done_callback(self._refreshes.discard)
+
+    def _on_signal(self, message: Message) -> None:
+        if message.member == "PropertiesChanged":
+            unit = self._paths.get(message.path or "")
+            if unit is None or len(message.body) != 3:
+                return
+            interface, changed, invalidated = message.body
+            names = _TRACKED_PROPERTIES.get(interface)
+            if not names:
+                return
+            self._props.setdefault(unit, {}).update({k: v for k, v in changed.items() if k in names})
+            if any(name in names for name in invalidated):
+                self._reload([unit])
+        elif message.member == "Reloading" and message.body == [False]:
+            # daemon-reload finished: unit files (and UnitFileState) may have changed
+            self._reload(list(self._units))
@@ -3,6 +3,8 @@
 from __future__ import annotations
 
 import asyncio
+import math
+import os
 from datetime import datetime, timedelta, timezone
 from pathlib import Path
 from typing import Dict, List, Optional
@@ -12,6 +14,7 @@ from loguru import logger
 
 from sek8s.config import SystemStatusConfig
 
+from .dirscan import scan_directories
 from .models import CommandResult, ServiceDefinition, SERVICE_ALLOWLIST
 from .responses import (
     DirectoryInfo,
@@ -22,6 +25,7 @@ from .responses import (
     ServiceStatus,
     ServiceStatusResponse,
 )
+from .units import UnitStateTracker
 
 
 def parse_key_value(output: str) -> Dict[str, str]:
@@ -113,12 +117,36 @@ def is_service_healthy(status: ServiceStatus) -> bool:
     )
 
 
+def tracked_service_status(
+    service: ServiceDefinition, tracker: Optional[UnitStateTracker]
+) -> Optional[ServiceStatusResponse]:
+    """Status of one unit from the D-Bus tracker; None when it is not connected."""
+    status = tracker.status(service.unit) if tracker is not None else None
+    if status is None:
+        return None
+    return ServiceStatusResponse(
+        service=ServiceInfo(
+            id=service.service_id,
+            unit=service.unit,
+            description=service.description,
+        ),
+        status=status,
+        healthy=is_service_healthy(status),
+    )
+
+
 async def collect_service_status(
     service: ServiceDefinition,
     config: SystemStatusConfig,
     *,
     tolerate_errors: bool = False,
+    tracker: Optional[UnitStateTracker] = None,
 ) -> ServiceStatusResponse:
+    """Status of one unit: from the D-Bus tracker when it is connected, else systemctl show."""
+    tracked = tracked_service_status(service, tracker)
+    if tracked is not None:
+        return tracked
+
     properties = [
         "Id",
         "LoadState",
@@ -248,27 +276,52 @@ def human_readable_size(size_bytes: int) -> str:
     return f"{size_bytes:.1f} PB"
 
 
-def _parse_df_line(line: str) -> Optional[FilesystemInfo]:
-    """Parse a line from df -k output (default or --output=source,size,used,avail,pcent,target)."""
-    parts = line.split()
-    if len(parts) < 6:
-        return None
+_MOUNTS_FILE = "/proc/self/mounts"
+
+
+def _unescape_mount_field(value: str) -> str:
+    """Decode the octal escapes (``\\040`` for space etc.) used in /proc/self/mounts."""
+    if "\\" not in value:
+        return value
+    out, i = [], 0
+    while i < len(value):
+        if value[i] == "\\" and value[i + 1 : i + 4].isdigit() and i + 4 <= len(value):
+            out.append(chr(int(value[i + 1 : i + 4], 8)))
+            i += 4
+        else:
+            out.append(value[i])
+            i += 1
+    return "".join(out)
+
+
+def _read_mounts() -> List[tuple[str, str]]:
+    """(source, target) of every mount, in mount order."""
+    mounts: List[tuple[str, str]] = []
     try:
-        size_kb = int(parts[1])
-        used_kb = int(parts[2])
-        avail_kb = int(parts[3])
-    except ValueError:
-        return None
-    source = parts[0]
-    pcent_str = parts[4].rstrip("%")
+        with open(_MOUNTS_FILE, encoding="utf-8", errors="replace") as f:
+            for line in f:
+                parts = line.split()
+                if len(parts) >= 2:
+                    mounts.append((_unescape_mount_field(parts[0]), _unescape_mount_field(parts[1])))
+    except OSError as exc:
+        logger.warning("Could not read {}: {}", _MOUNTS_FILE, exc)
+    return mounts
+
+
+def _statvfs_info(source: str, target: str) -> Optional[FilesystemInfo]:
+    """Capacity of the filesystem mounted at target, computed like df -k. None for pseudo filesystems."""
     try:
-        used_percent = float(pcent_str)
-    except ValueError:
-        used_percent = (used_kb / size_kb * 100) if size_kb > 0 else 0.0
-    target = " ".join(parts[5:]) if len(parts) > 5 else ""
-    total_bytes = size_kb * 1024
-    used_bytes = used_kb * 1024
-    available_bytes = avail_kb * 1024
+        st = os.statvfs(target)
+    except OSError:
+        return None
+    if st.f_blocks == 0:
+        return None
+    total_bytes = st.f_blocks * st.f_frsize
+    used_bytes = (st.f_blocks - st.f_bfree) * st.f_frsize
+    available_bytes = st.f_bavail * st.f_frsize
+    # df's Use% is used / (used + available to non-root), rounded up
+    usable = used_bytes + available_bytes
+    used_percent = math.ceil(used_bytes * 100 / usable) if usable > 0 else 0.0
     return FilesystemInfo(
         source=source,
         target=target,
@@ -278,128 +331,95 @@ def _parse_df_line(line: str) -> Optional[FilesystemInfo]:
         total_human=human_readable_size(total_bytes),
         used_human=human_readable_size(used_bytes),
         available_human=human_readable_size(available_bytes),
-        used_percent=round(used_percent, 2),
+        used_percent=round(float(used_percent), 2),
     )
 
 
-async def _get_filesystems(
-    validated_path: Path,
-    config: SystemStatusConfig,
-) -> Optional[List[FilesystemInfo]]:
-    """Run df -k for path (all mounts if path is /, else single filesystem). Returns None on failure."""
-    path_str = str(validated_path.resolve())
+def _collect_filesystems(path_str: str) -> Optional[List[FilesystemInfo]]:
+    mounts = _read_mounts()
     if path_str == "/":
-        command = ["df", "-k"]
-    else:
-        command = ["df", "-k", path_str]
-    try:
-        result = await run_command(
-            command,
-            config.command_timeout_seconds,
-            config.max_output_bytes,
-        )
-    except HTTPException:
-        return None
-    if result.exit_code != 0:
+        # All mounts, skipping pseudo filesystems and repeated mounts of one device (as df does)
+        filesystems: List[FilesystemInfo] = []
+        seen_devices = set()
+        for source, target in mounts:
+            try:
+                device = os.stat(target).st_dev
+            except OSError:
+                continue
+            if device in seen_devices:
+                continue
+            info = _statvfs_info(source, target)
+            if info is not None:
+                seen_devices.add(device)
+                filesystems.append(info)
+        return filesystems or None
+
+    # The mount containing path is the longest matching target; the last one wins when stacked
+    best: Optional[tuple[str, str]] = None
+    for source, target in mounts:
+        prefix = target.rstrip("/") + "/"
+        if path_str == target or path_str.startswith(prefix):
+            if best is None or len(target) >= len(best[1]):
+                best = (source, target)
+    if best is None:
         return None
-    filesystems: List[FilesystemInfo] = []
-    for line in result.stdout.strip().splitlines():
-        info = _parse_df_line(line)
-        if info is not None:
-            filesystems.append(info)
-    return filesystems if filesystems else None
-
-
-async def get_disk_space_simple(
-    validated_path: Path,
-    config: SystemStatusConfig,
-    cross_filesystems: bool = False,
-) -> DiskSpaceResponse:
-    command = ["sudo", "du", "-k"]
-    if not cross_filesystems:
-        command.append("-x")
-    command.extend(_du_exclude_args(validated_path))
-    command.extend(["--max-depth=1", str(validated_path)])
-
-    timeout = max(config.command_timeout_seconds * 5, 120)
-
-    result = await run_command(
-        command,
-        timeout,
-        config.max_output_bytes,
-    )
-
-    directories: List[DirectoryInfo] = []
-    parent_size = 0
-
-    for line in result.stdout.strip().splitlines():
-        if not line:
-            continue
-        try:
-            size_bytes, dir_path = parse_du_line(line)
-        except ValueError as exc:
-            logger.warning("Failed to parse du line: {}", exc)
-            continue
-
-        if Path(dir_path).resolve() == validated_path:
-            parent_size = size_bytes
-            continue
-
-        dir_name = Path(dir_path).name
-        directories.append(
-            DirectoryInfo(
-                name=dir_name,
-                path=dir_path,
-                size_bytes=size_bytes,
-                size_human=human_readable_size(size_bytes),
-                depth=1,
-                percentage=None,
-            )
-        )
-
-    directories.sort(key=lambda d: d.size_bytes, reverse=True)
-    total_bytes = parent_size if parent_size > 0 else sum(d.size_bytes for d in directories)
+    info = _statvfs_info(*best)
+    return [info] if info is not None else None
 
-    if total_bytes > 0:
-        for d in directories:
-            d.percentage = (d.size_bytes / total_bytes) * 100
 
-    filesystems = await _get_filesystems(validated_path, config)
-    return DiskSpaceResponse(
-        path=str(validated_path),
-        directories=directories,
-        total_size_bytes=total_bytes,
-        total_size_human=human_readable_size(total_bytes),
-        stdout_truncated=result.stdout_truncated,
-        diagnostic_mode=False,
-        filesystems=filesystems,
-    )
+async def get_filesystems(validated_path: Path) -> Optional[List[FilesystemInfo]]:
+    """Filesystem capacity via statvfs (all mounts if path is /, else the one holding path). None on failure."""
+    return await asyncio.to_thread(_collect_filesystems, str(validated_path.resolve()))
 
 
-async def get_disk_space_diagnostic(
+async def scan_directory_sizes(
     validated_path: Path,
     config: SystemStatusConfig,
     max_depth: int,
-    top_n: int,
-    cross_filesystems: bool = False,
-) -> DiskSpaceResponse:
+    cross_filesystems: bool,
+) -> tuple[List[tuple[int, str, int]], int, bool, bool]:
+    """Directory sizes up to *max_depth* below *validated_path*.
+
+    Returns ``(entries, root_size, truncated, hardlinked)`` where entries are
+    ``(size_bytes, path, depth)`` for depth >= 1 and ``hardlinked`` is True
+    when the tree may contain multiply-linked files (each counted once within
+    this scan only).  Uses the native sek8s-dirscan scanner when installed
+    (complete output, reports hard links), otherwise ``du``, whose output is
+    capped by ``max_output_bytes`` and which cannot tell, so ``hardlinked`` is
+    always True for it.
+    """
+    timeout = max(config.command_timeout_seconds * 5, 120)
+    excludes = VIRTUAL_FS_EXCLUDES if str(validated_path) == "/" else []
+
+    scan = await scan_directories(
+        validated_path,
+        max_depth,
+        cross_filesystems=cross_filesystems,
+        excludes=excludes,
+        threads=config.disk_scan_threads,
+        timeout=timeout,
+    )
+    if scan is not None:
+        root_size = 0
+        entries: List[tuple[int, str, int]] = []
+        for entry in scan.entries:
+            if entry.depth == 0:
+                root_size = entry.size_bytes
+            else:
+                entries.append((entry.size_bytes, entry.path, entry.depth))
+        return entries, root_size, False, scan.hardlinks > 0
+
     command = ["sudo", "du", "-k"]
     if not cross_filesystems:
         command.append("-x")
     command.extend(_du_exclude_args(validated_path))
     command.extend([f"--max-depth={max_depth}", str(validated_path)])
 
-    timeout = max(config.command_timeout_seconds * 5, 120)
+    limit = config.max_output_bytes if max_depth <= 1 else config.max_output_bytes * 2
+    result = await run_command(command, timeout, limit)
 
-    result = await run_command(
-        command,
-        timeout,
-        config.max_output_bytes * 2,
-    )
-
-    all_entries: List[tuple[int, str, int]] = []
     root_size = 0
-
+    entries = []
     for line in result.stdout.strip().splitlines():
         if not line:
             continue
@@ -420,19 +440,78 @@ async def get_disk_space_diagnostic(
             root_size = size_bytes
             continue
 
-        all_entries.append((size_bytes, str(resolved), depth))
+        entries.append((size_bytes, str(resolved), depth))
+
+    return entries, root_size, result.stdout_truncated, True
+
+
+def build_disk_space_response(
+    validated_path: Path,
+    entries: List[tuple[int, str, int]],
+    root_size: int,
+    *,
+    truncated: bool,
+    filesystems: Optional[List[FilesystemInfo]],
+    diagnostic: bool,
+    max_depth: int,
+    top_n: int,
+    scanned_at: Optional[datetime] = None,
+) -> DiskSpaceResponse:
+    """Shape scanned ``(size_bytes, path, depth)`` entries for simple or diagnostic mode."""
+    freshness = {}
+    if scanned_at is not None:
+        freshness = {
+            "scanned_at": scanned_at.isoformat(),
+            "age_seconds": round(max(0.0, (datetime.now(timezone.utc) - scanned_at).total_seconds()), 3),
+        }
+
+    if not diagnostic:
+        directories: List[DirectoryInfo] = []
+        for size_bytes, dir_path, depth in entries:
+            if depth != 1:
+                continue
+            directories.append(
+                DirectoryInfo(
+                    name=Path(dir_path).name,
+                    path=dir_path,
+                    size_bytes=size_bytes,
+                    size_human=human_readable_size(size_bytes),
+                    depth=1,
+                    percentage=None,
+                )
+            )
+
+        directories.sort(key=lambda d: d.size_bytes, reverse=True)
+        total_bytes = root_size if root_size > 0 else sum(d.size_bytes for d in directories)
+
+        if total_bytes > 0:
+            for d in directories:
+                d.percentage = (d.size_bytes / total_bytes) * 100
+
+        return DiskSpaceResponse(
+            path=str(validated_path),
+            directories=directories,
+            total_size_bytes=total_bytes,
+            total_size_human=human_readable_size(total_bytes),
+            stdout_truncated=truncated,
+            diagnostic_mode=False,
+            filesystems=filesystems,
+            **freshness,
+        )
 
     depth_groups: Dict[int, List[tuple[int, str]]] = {}
-    for size_bytes, path, depth in all_entries:
+    for size_bytes, path, depth in entries:
+        if depth > max_depth:
+            continue
         if depth not in depth_groups:
             depth_groups[depth] = []
         depth_groups[depth].append((size_bytes, path))
 
     top_offenders: List[DirectoryInfo] = []
     for depth in sorted(depth_groups.keys()):
-        entries = depth_groups[depth]
-        entries.sort(reverse=True)
-        for size_bytes, path in entries[:top_n]:
+        group = depth_groups[depth]
+        group.sort(reverse=True)
+        for size_bytes, path in group[:top_n]:
             percentage = (size_bytes / root_size * 100) if root_size > 0 else 0
             top_offenders.append(
                 DirectoryInfo(
@@ -447,17 +526,17 @@ async def get_disk_space_diagnostic(
 
     top_offenders.sort(key=lambda d: d.size_bytes, reverse=True)
 
-    filesystems = await _get_filesystems(validated_path, config)
     return DiskSpaceResponse(
         path=str(validated_path),
         directories=top_offenders,
         total_size_bytes=root_size,
         total_size_human=human_readable_size(root_size),
-        stdout_truncated=result.stdout_truncated,
+        stdout_truncated=truncated,
         diagnostic_mode=True,
         max_depth=max_depth,
         top_n=top_n,
         filesystems=filesystems,
+        **freshness,
     )
 
 
@@ -4,11 +4,292 @@ Base validator interface and common functionality.
 
 from abc import ABC, abstractmethod
 from dataclasses import dataclass, field
-from typing import Dict, List, Optional
+from typing import Any, Dict, List, Optional, Tuple, Union
+
+import orjson
 
 from sek8s.config import AdmissionConfig
 
 
+# Resource kinds that carry (or template) a pod spec and therefore container images
+POD_KINDS = frozenset(
+    ["Pod", "Deployment", "StatefulSet", "DaemonSet", "Job", "CronJob", "ReplicaSet"]
+)
+
+ImageReference = Tuple[str, str, str, str]
+
+
+def _container_images(pod_spec: Dict, fields: Tuple[str, ...]) -> List[str]:
+    images = []
+    for name in fields:
+        for container in pod_spec.get(name) or []:
+            images.append(container.get("image", ""))
+    return images
+
+
+def extract_images(obj: Optional[Dict]) -> List[str]:
+    """Extract all container images from a Kubernetes object."""
+    if not obj:
+        return []
+
+    images = []
+
+    # Handle different object types
+    spec = obj.get("spec") or {}
+
+    # Direct pod spec
+    if "containers" in spec:
+        images.extend(
+            _container_images(spec, ("containers", "initContainers", "ephemeralContainers"))
+        )
+
+    # Deployment, StatefulSet, DaemonSet, Job, CronJob
+    template = spec.get("template") or {}
+    if template:
+        images.extend(
+            _container_images(
+                template.get("spec") or {},
+                ("containers", "initContainers", "ephemeralContainers"),
+            )
+        )
+
+    # CronJob has an additional level
+    job_template = spec.get("jobTemplate") or {}
+    if job_template:
+        job_spec = job_template.get("spec") or {}
+        job_template_spec = (job_spec.get("template") or {}).get("spec") or {}
+        images.extend(_container_images(job_template_spec, ("containers", "initContainers")))
+
+    return [img for img in images if img]  # Filter out empty strings
+
+
+def pod_container_images(obj: Optional[Dict]) -> List[Tuple[str, str]]:
+    """Return (JSON pointer, image) for each container of a Pod object, for JSON patches."""
+    images = []
+    spec = (obj or {}).get("spec") or {}
+    for name in ("initContainers", "containers"):
+        for i, container in enumerate(spec.get(name) or []):
+            image = container.get("image", "")
+            if image:
+                images.append((f"/spec/{name}/{i}/image", image))
+    return images
+
+
+def parse_image_reference(image: str) -> ImageReference:
+    """
+    Parse image reference into (registry, organization, repository, tag/digest).
+
+    Examples:
+        nginx:latest -> (docker.io, library, nginx, latest)
+        parachutes/chutes-agent:k3s -> (docker.io, parachutes, chutes-agent, k3s)
+        gcr.io/distroless/base:latest -> (gcr.io, distroless, base, latest)
+        gcr.io/my-project/subdir/app:v1 -> (gcr.io, my-project, subdir/app, v1)
+        registry.k8s.io/pause:3.9 -> (registry.k8s.io, library, pause, 3.9)
+    """
+    original_image = image
+
+    # Handle digest vs tag
+    if "@" in image:
+        image, digest = image.split("@", 1)
+        tag_or_digest = f"@{digest}"
+    elif ":" in image.split("/")[-1]:  # Only check last component for tag
+        image, tag = image.rsplit(":", 1)
+        tag_or_digest = tag
+    else:
+        tag_or_digest = "latest"
+
+    # No slashes = official Docker Hub image (nginx, alpine, etc.)
+    if "/" not in image:
+        return ("docker.io", "library", image, tag_or_digest)
+
+    parts = image.split("/")
+    first_part = parts[0]
+
+    # Check if first part is a registry (contains . or :)
+    if "." in first_part or ":" in first_part:
+        # Has explicit registry
+        registry = first_part
+        remaining = parts[1:]
+
+        if len(remaining) == 0:
+            raise ValueError(f"Invalid image reference: {original_image}")
+        elif len(remaining) == 1:
+            # registry.io/image -> assume "library" org
+            org = "library"
+            repo = remaining[0]
+        else:
+            # registry.io/org/repo or registry.io/org/subdir/repo
+            org = remaining[0]
+            repo = "/".join(remaining[1:])
+    else:
+        # No explicit registry, assume Docker Hub
+        registry = "docker.io"
+        # user/repo or user/subdir/repo
+        org = parts[0]
+        repo = "/".join(parts[1:])
+
+    return (registry, org, repo, tag_or_digest)
+
+
+_JSON_WS = b" \t\r\n"
+
+
+def _skip_ws(buf: bytes, i: int) -> int:
+    while i < len(buf) and buf[i] in _JSON_WS:
+        i += 1
+    return i
+
+
+def _string_end(buf: bytes, i: int) -> int:
+    """Index just past the JSON string starting at ``buf[i] == '"'``."""
+    i += 1
+    while True:
+        c = buf[i]
+        if c == 0x5C:  # backslash
+            i += 2
+        elif c == 0x22:  # closing quote
+            return i + 1
+        else:
+            i += 1
+
+
+def _value_end(buf: bytes, i: int) -> int:
+    """Index just past the JSON value starting at ``buf[i]``."""
+    c = buf[i]
+    if c == 0x22:
+        return _string_end(buf, i)
+    if c not in b"{[":
+        while i < len(buf) and buf[i] not in b",}] \t\r\n":
+            i += 1
+        return i
+    depth = 0
+    while True:
+        c = buf[i]
+        if c == 0x22:
+            i = _string_end(buf, i)
+            continue
+        if c in b"{[":
+            depth += 1
+        elif c in b"}]":
+            depth -= 1
+            if depth == 0:
+                return i + 1
+        i += 1
+
+
+def raw_member(raw: bytes, key: str) -> Optional[bytes]:
+    """Raw bytes of a top-level member of an (already validated) JSON object.
+
+    Only keys without escape sequences are matched. As with the decoder, the last
+    occurrence of a duplicated key wins. Returns None when the key is absent or
+    the body is not an object.
+    """
+    name = key.encode()
+    found = None
+    i = _skip_ws(raw, 0)
+    if i >= len(raw) or raw[i] != 0x7B:
+        return None
+    i = _skip_ws(raw, i + 1)
+    while i < len(raw) and raw[i] == 0x22:
+        key_end = _string_end(raw, i)
+        matched = raw[i + 1 : key_end - 1] == name
+        i = _skip_ws(raw, _skip_ws(raw, key_end) + 1)  # past the colon
+        value_end = _value_end(raw, i)
+        if matched:
+            found = raw[i:value_end]
+        i = _skip_ws(raw, value_end)
+        if i < len(raw) and raw[i] == 0x2C:
+            i = _skip_ws(raw, i + 1)
+    return found
+
+
+@dataclass
+class AdmissionContext:
+    """Per-request view of an admission review, built once and shared by all validators.
+
+    The body is parsed a single time (orjson) and everything the validators look up
+    repeatedly (kind, namespace, images, parsed image references, namespace policy)
+    is extracted up front. The raw bytes of the request object are kept so OPA can
+    receive them without re-serializing the request.
+    """
+
+    review: Dict
+    request: Dict
+    uid: str
+    kind: str
+    operation: Optional[str]
+    namespace: str
+    object: Dict
+    images: List[str]
+    references: Dict[str, ImageReference]
+    exempt: bool
+    enforcement_mode: str
+    raw: Optional[bytes] = None
+    raw_request: Optional[bytes] = None
+
+    @classmethod
+    def from_bytes(cls, raw: bytes, config: AdmissionConfig) -> "AdmissionContext":
+        """Parse a raw AdmissionReview body. Raises ValueError on invalid JSON or shape."""
+        review = orjson.loads(raw)
+        if not isinstance(review, dict) or not isinstance(review.get("request"), dict):
+            raise ValueError("Invalid admission review: missing request")
+        return cls.from_review(review, config, raw=raw)
+
+    @classmethod
+    def from_review(
+        cls, review: Dict, config: AdmissionConfig, raw: Optional[bytes] = None
+    ) -> "AdmissionContext":
+        """Build a context from an already-decoded AdmissionReview dict."""
+        request = review.get("request") or {}
+        namespace = request.get("namespace", "default")
+        obj = request.get("object") or {}
+
+        images = extract_images(obj) if isinstance(obj, dict) else []
+        references: Dict[str, ImageReference] = {}
+        for image in images:
+            if image in references:
+                continue
+            try:
+                references[image] = parse_image_reference(image)
+            except ValueError:
+                # Left unresolved; validators re-parse and report the error themselves
+                pass
+
+        policy = config.get_namespace_policy(namespace)
+        return cls(
+            review=review,
+            request=request,
+            uid=request.get("uid", "unknown"),
+            kind=(request.get("kind") or {}).get("kind", ""),
+            operation=request.get("operation", None),
+            namespace=namespace,
+            object=obj if isinstance(obj, dict) else {},
+            images=images,
+            references=references,
+            exempt=bool(policy and policy.exempt),
+            enforcement_mode=policy.mode if policy else config.enforcement_mode,
+            raw=raw,
+            raw_request=raw_member(raw, "request") if raw is not None else None,
+        )
+
+    @property
+    def is_pod_kind(self) -> bool:
+        return self.kind in POD_KINDS
+
+    def opa_payload(self, extra: Dict[str, Any]) -> bytes:
+        """Serialize the OPA query body ``{"input": {"request": ..., **extra}}``.
+
+        When the raw body is available the request object is spliced in verbatim,
+        so it is never re-encoded; ``extra`` must not contain a ``request`` key.
+        """
+        if self.raw_request is not None and "request" not in extra:
+            tail = orjson.dumps(extra)
+            if len(tail) > 2:
+                return b'{"input":{"request":' + self.raw_request + b"," + tail[1:] + b"}"
+            return b'{"input":{"request":' + self.raw_request + b"}}"
+        return orjson.dumps({"input": {"request": self.request, **extra}})
+
+
 @dataclass
 class ValidationResult:
     """Result of a validation check."""
@@ -53,12 +334,13 @@ class ValidatorBase(ABC):
         self.config = config
 
     @abstractmethod
-    async def validate(self, admission_review: Dict) -> ValidationResult:
+    async def validate(self, admission_review: Union[Dict, AdmissionContext]) -> ValidationResult:
         """
         Validate an admission review request.
 
         Args:
-            admission_review: Kubernetes admission review request
+            admission_review: Kubernetes admission review request, or the shared
+                AdmissionContext built for it by the controller
 
         Returns:
             ValidationResult with decision and messages
@@ -74,35 +356,12 @@ class ValidatorBase(ABC):
         """
         return True
 
+    def admission_context(self, admission_review: Union[Dict, AdmissionContext]) -> AdmissionContext:
+        """Return the shared request context, building one for bare review dicts."""
+        if isinstance(admission_review, AdmissionContext):
+            return admission_review
+        return AdmissionContext.from_review(admission_review, self.config)
+
     def extract_images(self, obj: Dict) -> List[str]:
         """Extract all container images from a Kubernetes object."""
-        images = []
-
-        # Handle different object types
-        spec = obj.get("spec", {})
-
-        # Direct pod spec
-        if "containers" in spec:
-            images.extend([c.get("image", "") for c in spec.get("containers", [])])
-            images.extend([c.get("image", "") for c in spec.get("initContainers", [])])
-            images.extend([c.get("image", "") for c in spec.get("ephemeralContainers", [])])
-
-        # Deployment, StatefulSet, DaemonSet, Job, CronJob
-        template = spec.get("template", {})
-        if template:
-            template_spec = template.get("spec", {})
-            images.extend([c.get("image", "") for c in template_spec.get("containers", [])])
-            images.extend([c.get("image", "") for c in template_spec.get("initContainers", [])])
-            images.extend(
-                [c.get("image", "") for c in template_spec.get("ephemeralContainers", [])]
-            )
-
-        # CronJob has an additional level
-        job_template = spec.get("jobTemplate", {})
-        if job_template:
-            job_spec = job_template.get("spec", {})
-            job_template_spec = job_spec.get("template", {}).get("spec", {})
-            images.extend([c.get("image", "") for c in job_template_spec.get("containers", [])])
-            images.extend([c.get("image", "") for c in job_template_spec.get("initContainers", [])])
-
-        return [img for img in images if img]  # Filter out empty strings
+        return extract_images(obj)
@@ -3,13 +3,19 @@ import json
 import logging
 import re
 import time
-from dataclasses import dataclass
+from dataclasses import dataclass, field
 from pathlib import Path
-from typing import Awaitable, Callable, Dict, List, Optional, Tuple
+from typing import Awaitable, Callable, Dict, List, Optional, Tuple, Union
 
 from cachetools import TTLCache
 
-from sek8s.validators.base import ValidatorBase, ValidationResult
+from sek8s.validators.base import (
+    AdmissionContext,
+    ImageReference,
+    ValidatorBase,
+    ValidationResult,
+    parse_image_reference,
+)
 from sek8s.config import AdmissionConfig, CosignConfig, CosignRegistryConfig, CosignVerificationConfig
 
 
@@ -43,12 +49,53 @@ class ValidationContext:
     cosign_config: CosignConfig
     validator: "CosignValidator"
     required_key_path: Optional[Path] = None
+    references: Dict[str, ImageReference] = field(default_factory=dict)
+
+    def parse_image(self, image: str) -> ImageReference:
+        """Return the pre-parsed reference for image, parsing only on a miss."""
+        reference = self.references.get(image)
+        if reference is None:
+            reference = self.validator._parse_image_reference(image)
+        return reference
 
 
 # Rule type: async (validator, ctx) -> list of violation strings (empty if none)
 Rule = Callable[["CosignValidator", ValidationContext], Awaitable[List[str]]]
 
 
+class ImageDigestCache:
+    """Tag-based image -> digest-pinned reference, recorded only after a successful verification.
+
+    Shared between the cosign validator (which fills it) and the mutating webhook
+    (which rewrites pod images from it), so pods run exactly the digest that was
+    verified and later admissions of the pinned image hit digest-keyed caches.
+    """
+
+    def __init__(self, maxsize: int, ttl: int):
+        self._cache = TTLCache(maxsize=maxsize, ttl=ttl)
+
+    @staticmethod
+    def pin(image: str, digest: str) -> str:
+        """Replace the tag of image with digest (``sha256:...``), keeping the name as written."""
+        name = image.split("@", 1)[0]
+        if ":" in name.split("/")[-1]:
+            name = name.rsplit(":", 1)[0]
+        return f"{name}@{digest}"
+
+    def record(self, image: str, digest: Optional[str]) -> None:
+        """Remember the verified digest for a tag-based image."""
+        if "@" in image or not digest or not digest.startswith("sha256:"):
+            return
+        self._cache[image] = self.pin(image, digest)
+
+    def get(self, image: str) -> Optional[str]:
+        """Return the verified digest-pinned reference for image, if known."""
+        return self._cache.get(image)
+
+    def __len__(self) -> int:
+        return len(self._cache)
+
+
 class CosignValidator(ValidatorBase):
     """Validator that verifies container image signatures using cosign."""
 
@@ -65,6 +112,10 @@ class CosignValidator(ValidatorBase):
             maxsize=self.cosign_config.admission_result_cache_maxsize,
             ttl=self.cosign_config.admission_result_cache_ttl,
         )
+        self.digest_cache = ImageDigestCache(
+            maxsize=self.cosign_config.digest_cache_maxsize,
+            ttl=self.cosign_config.digest_cache_ttl,
+        )
         self._admission_cache_lock = asyncio.Lock()
         self._rate_limit_until = 0.0
         self._rate_limit_patterns = [
@@ -142,30 +193,22 @@ class CosignValidator(ValidatorBase):
         combined = f"{stdout}\n{stderr}".lower()
         return any(ind in combined for ind in indicators)
 
-    async def validate(self, admission_review: Dict) -> ValidationResult:
+    async def validate(self, admission_review: Union[Dict, AdmissionContext]) -> ValidationResult:
         """Validate admission request: for pod-like resources with images, require valid cosign signatures; allow otherwise."""
-        request = admission_review.get("request", {})
+        admission = self.admission_context(admission_review)
+        request = admission.request
 
         # Only check pods and pod-creating resources
-        kind = request.get("kind", {}).get("kind", "")
-        if kind not in [
-            "Pod",
-            "Deployment",
-            "StatefulSet",
-            "DaemonSet",
-            "Job",
-            "CronJob",
-            "ReplicaSet",
-        ]:
+        kind = admission.kind
+        if not admission.is_pod_kind:
             return ValidationResult.allow()
 
-        operation = request.get("operation", None)
-        if operation == "DELETE":
+        if admission.operation == "DELETE":
             return ValidationResult.allow()
 
-        obj = request.get("object", {})
-        images = self.extract_images(obj)
-        namespace = request.get("namespace", "default")
+        obj = admission.object
+        images = admission.images
+        namespace = admission.namespace
 
         logger.debug(f"Found {len(images)} images for pod {obj.get('metadata', {}).get('name', 'Unknown')}")
 
@@ -194,6 +237,7 @@ class CosignValidator(ValidatorBase):
             images=images,
             cosign_config=self.cosign_config,
             validator=self,
+            references=admission.references,
         )
         # 2. Get validation rules (based on context)
         rules = self._get_rules_for_context(ctx)
@@ -235,7 +279,7 @@ class CosignValidator(ValidatorBase):
             if image in seen:
                 continue
             seen.add(image)
-            registry, org, repo, _ = ctx.validator._parse_image_reference(image)
+            registry, org, repo, _ = ctx.parse_image(image)
             vc = ctx.cosign_config.get_verification_config(registry, org, repo)
             if not vc:
                 violations.append(f"Image {image} has no cosign configuration")
@@ -249,7 +293,7 @@ class CosignValidator(ValidatorBase):
             if image in seen:
                 continue
             seen.add(image)
-            registry, org, repo, _ = ctx.validator._parse_image_reference(image)
+            registry, org, repo, _ = ctx.parse_image(image)
             vc = ctx.cosign_config.get_verification_config(registry, org, repo)
             if vc and (
                 vc.verification_method == "disabled" or not vc.require_signature
@@ -265,7 +309,7 @@ class CosignValidator(ValidatorBase):
             if image in seen:
                 continue
             seen.add(image)
-            registry, org, repo, _ = ctx.validator._parse_image_reference(image)
+            registry, org, repo, _ = ctx.parse_image(image)
             vc = ctx.cosign_config.get_verification_config(registry, org, repo)
             if vc and (
                 vc.verification_method != "key" or vc.public_key is None
@@ -286,7 +330,7 @@ class CosignValidator(ValidatorBase):
             if image in seen:
                 continue
             seen.add(image)
-            registry, org, repo, _ = ctx.validator._parse_image_reference(image)
+            registry, org, repo, _ = ctx.parse_image(image)
             vc = ctx.cosign_config.get_verification_config(registry, org, repo)
             if vc and vc.public_key is not None and str(vc.public_key) != str(ctx.required_key_path):
                 violations.append(f"Image {image} uses a different cosign key")
@@ -300,7 +344,7 @@ class CosignValidator(ValidatorBase):
             if image in seen:
                 continue
             seen.add(image)
-            registry, org, repo, _ = ctx.validator._parse_image_reference(image)
+            registry, org, repo, _ = ctx.parse_image(image)
             logger.debug(f"Parsed image {image} -> registry={registry}, org={org}, repo={repo}")
             vc = ctx.cosign_config.get_verification_config(registry, org, repo)
             if not vc:
@@ -327,65 +371,8 @@ class CosignValidator(ValidatorBase):
         return violations
 
     def _parse_image_reference(self, image: str) -> tuple[str, str, str, str]:
-        """
-        Parse image reference into (registry, organization, repository, tag/digest).
-        
-        Examples:
-            nginx:latest -> (docker.io, library, nginx, latest)
-            parachutes/chutes-agent:k3s -> (docker.io, parachutes, chutes-agent, k3s)
-            gcr.io/distroless/base:latest -> (gcr.io, distroless, base, latest)
-            gcr.io/my-project/subdir/app:v1 -> (gcr.io, my-project, subdir/app, v1)
-            registry.k8s.io/pause:3.9 -> (registry.k8s.io, library, pause, 3.9)
-        """
-        original_image = image
-        
-        # Handle digest vs tag
-        if "@" in image:
-            image, digest = image.split("@", 1)
-            tag_or_digest = f"@{digest}"
-        elif ":" in image.split("/")[-1]:  # Only check last component for tag
-            image, tag = image.rsplit(":", 1)
-            tag_or_digest = tag
-        else:
-            tag_or_digest = "latest"
-        
-        # No slashes = official Docker Hub image (nginx, alpine, etc.)
-        if "/" not in image:
-            return ("docker.io", "library", image, tag_or_digest)
-        
-        parts = image.split("/")
-        first_part = parts[0]
-        
-        # Check if first part is a registry (contains . or :)
-        if "." in first_part or ":" in first_part:
-            # Has explicit registry
-            registry = first_part
-            remaining = parts[1:]
-            
-            if len(remaining) == 0:
-                raise ValueError(f"Invalid image reference: {original_image}")
-            elif len(remaining) == 1:
-                # registry.io/image -> assume "library" org
-                org = "library"
-                repo = remaining[0]
-            else:
-                # registry.io/org/repo or registry.io/org/subdir/repo
-                org = remaining[0]
-                repo = "/".join(remaining[1:])
-        else:
-            # No explicit registry, assume Docker Hub
-            registry = "docker.io"
-            
-            if len(parts) == 1:
-                # Should have been caught by "/" check, but just in case
-                org = "library"
-                repo = parts[0]
-            else:
-                # user/repo or user/subdir/repo
-                org = parts[0]
-                repo = "/".join(parts[1:])
-        
-        return (registry, org, repo, tag_or_digest)
+        """Parse image reference into (registry, organization, repository, tag/digest)."""
+        return parse_image_reference(image)
 
     async def _verify_image_signature(
         self, image: str, verification_config: CosignVerificationConfig
@@ -399,6 +386,8 @@ class CosignValidator(ValidatorBase):
                 f"{time.strftime('%Y-%m-%d %H:%M:%S', time.localtime(self._rate_limit_until))}"
             )
 
+        # Always resolve: a tag may have moved since it was last verified. The digest
+        # cache only feeds the mutating webhook's pinning, never this lookup.
         resolved_image = await self._resolve_image_reference(image)
         cache_key = self._make_cache_key(resolved_image, verification_config)
 
@@ -429,6 +418,12 @@ class CosignValidator(ValidatorBase):
         # Cache result (success in main cache; failure in short negative cache)
         if valid:
             self._result_cache[cache_key] = True
+            if "@" in resolved_image:
+                self.digest_cache.record(image, resolved_image.split("@", 1)[1])
+            pinned = self.digest_cache.get(image)
+            if pinned:
+                # Pods rewritten by the mutating webhook arrive with this exact reference
+                self._result_cache[self._make_cache_key(pinned, verification_config)] = True
         else:
             self._negative_cache[cache_key] = False
 
@@ -471,6 +466,7 @@ class CosignValidator(ValidatorBase):
                     try:
                         verification_result = json.loads(stdout)
                         logger.debug(f"Verification result: {verification_result}")
+                        self.digest_cache.record(image, self._manifest_digest(verification_result))
                         valid = True
                     except json.JSONDecodeError:
                         logger.warning(f"Invalid JSON output from cosign verify: {stdout}")
@@ -518,7 +514,10 @@ class CosignValidator(ValidatorBase):
             if success:
                 try:
                     verification_result = json.loads(stdout)
-                    return isinstance(verification_result, list) and len(verification_result) > 0
+                    if isinstance(verification_result, list) and len(verification_result) > 0:
+                        self.digest_cache.record(image, self._manifest_digest(verification_result))
+                        return True
+                    return False
                 except json.JSONDecodeError:
                     logger.error(f"Invalid JSON output from cosign verify: {stdout}")
                     return False
@@ -534,6 +533,21 @@ class CosignValidator(ValidatorBase):
             logger.error(f"Exception during keyless verification: {e}")
             return False
 
+    @staticmethod
+    def _manifest_digest(verification_result) -> Optional[str]:
+        """Return the verified manifest digest from cosign verify JSON output, if present."""
+        if not isinstance(verification_result, list):
+            return None
+        for item in verification_result:
+            if not isinstance(item, dict):
+                continue
+            digest = (
+                (item.get("critical") or {}).get("image", {}).get("docker-manifest-digest")
+            )
+            if digest:
+                return digest
+        return None
+
     async def _resolve_image_reference(self, image: str) -> str:
         """Resolve image reference to digest if possible; return as-is if already a digest or if resolution fails."""
         # If image already has digest, return as-is
@@ -4,11 +4,10 @@ OPA (Open Policy Agent) validator.
 
 import aiohttp
 import asyncio
-import json
 import logging
-from typing import Dict, List, Optional
+from typing import Dict, List, Union
 
-from sek8s.validators.base import ValidatorBase, ValidationResult
+from sek8s.validators.base import AdmissionContext, ValidatorBase, ValidationResult
 
 
 logger = logging.getLogger(__name__)
@@ -28,29 +27,29 @@ class OPAValidator(ValidatorBase):
         if self.session is None:
             self.session = aiohttp.ClientSession(timeout=self.timeout)
 
-    async def validate(self, admission_review: Dict) -> ValidationResult:
+    async def validate(self, admission_review: Union[Dict, AdmissionContext]) -> ValidationResult:
         """Validate admission request against OPA policies."""
         await self._ensure_session()
 
-        request = admission_review.get("request", {})
+        ctx = self.admission_context(admission_review)
 
         # Check if namespace is exempt
-        namespace = request.get("namespace", "default")
-        if self.config.is_namespace_exempt(namespace):
+        namespace = ctx.namespace
+        if ctx.exempt:
             logger.debug("Namespace %s is exempt from OPA validation", namespace)
             return ValidationResult.allow(f"Namespace {namespace} is exempt")
 
         # Get namespace policy
-        ns_policy = self.config.get_namespace_policy(namespace)
-        enforcement_mode = ns_policy.mode if ns_policy else self.config.enforcement_mode
+        enforcement_mode = ctx.enforcement_mode
 
         try:
-            # Prepare OPA input
-            opa_input = {
-                "request": request,
-                "allowed_registries": self.config.allowed_registries,
-                "namespace_policy": enforcement_mode,
-            }
+            # Prepare OPA input (raw request bytes are passed through, not re-encoded)
+            opa_input = ctx.opa_payload(
+                {
+                    "allowed_registries": self.config.allowed_registries,
+                    "namespace_policy": enforcement_mode,
+                }
+            )
 
             # Query OPA
             violations = await self._query_opa(opa_input)
@@ -83,14 +82,16 @@ class OPAValidator(ValidatorBase):
             # Fail closed on errors
             return ValidationResult.deny(f"Policy validation error: {str(e)}")
 
-    async def _query_opa(self, opa_input: Dict) -> List[str]:
-        """Query OPA and return list of violations."""
+    async def _query_opa(self, opa_input: bytes) -> List[str]:
+        """Query OPA with a serialized ``{"input": ...}`` body and return list of violations."""
         violations = []
 
         # Query the main deny endpoint
         url = f"{self.opa_url}/v1/data/kubernetes/admission/deny"
 
-        async with self.session.post(url, json={"input": opa_input}) as response:
+        async with self.session.post(
+            url, data=opa_input, headers={"Content-Type": "application/json"}
+        ) as response:
             if response.status != 200:
                 raise Exception(f"OPA returned status {response.status}")
 
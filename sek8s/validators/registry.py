@@ -1,7 +1,7 @@
 import logging
-from typing import Dict
+from typing import Dict, Union
 
-from sek8s.validators.base import ValidatorBase, ValidationResult
+from sek8s.validators.base import AdmissionContext, ValidatorBase, ValidationResult
 
 
 logger = logging.getLogger(__name__)
@@ -10,50 +10,35 @@ logger = logging.getLogger(__name__)
 class RegistryValidator(ValidatorBase):
     """Validator that checks container images against registry allowlist."""
 
-    async def validate(self, admission_review: Dict) -> ValidationResult:
+    async def validate(self, admission_review: Union[Dict, AdmissionContext]) -> ValidationResult:
         """Validate that all container images are from allowed registries."""
-        request = admission_review.get("request", {})
+        ctx = self.admission_context(admission_review)
 
         # Only check pods and pod-creating resources
-        kind = request.get("kind", {}).get("kind", "")
-        if kind not in [
-            "Pod",
-            "Deployment",
-            "StatefulSet",
-            "DaemonSet",
-            "Job",
-            "CronJob",
-            "ReplicaSet",
-        ]:
+        if not ctx.is_pod_kind:
             return ValidationResult.allow()
 
         # Check if namespace is exempt
-        namespace = request.get("namespace", "default")
-        if self.config.is_namespace_exempt(namespace):
-            return ValidationResult.allow(f"Namespace {namespace} is exempt")
+        if ctx.exempt:
+            return ValidationResult.allow(f"Namespace {ctx.namespace} is exempt")
 
         # Delete requests have object set to None so no images to check
-        if request.get("operation", None) == "DELETE":
+        if ctx.operation == "DELETE":
             return ValidationResult.allow()
 
-        # Extract images
-        obj = request.get("object", {})
-        images = self.extract_images(obj)
-
-        if not images:
+        if not ctx.images:
             return ValidationResult.allow()
 
         # Check each image
         violations = []
-        for image in images:
+        for image in ctx.images:
             registry = self._extract_registry(image)
             if not self._is_registry_allowed(registry):
                 violations.append(f"Image {image} uses disallowed registry {registry}")
 
         if violations:
             # Check enforcement mode
-            ns_policy = self.config.get_namespace_policy(namespace)
-            enforcement_mode = ns_policy.mode if ns_policy else self.config.enforcement_mode
+            enforcement_mode = ctx.enforcement_mode
 
             if enforcement_mode == "monitor":
                 logger.info("Registry violations (monitor mode): %s", violations)
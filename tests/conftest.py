@@ -54,6 +54,9 @@ def pytest_configure(config):
     os.environ["ALLOWED_VALIDATORS"] = "5E6xfU3oNU7y1a7pQwoc31fmUjwBZ2gKcNCw8EXsdtCQieUQ,5DAAnrj7VHTz5kZ8Yx9T6UzU6Fv5fV8qD5T4v4k1zX7N6P4Y"
 
     os.environ.setdefault("DEBUG", "false")
+    # Unit tests stub systemctl; keep the D-Bus unit tracker off the host's system bus
+    os.environ.setdefault("SYSTEMD_DBUS_ENABLED", "false")
+    os.environ.setdefault("GPU_TELEMETRY_ENABLED", "false")
     os.environ.setdefault("REGISTRY_URL", "localhost:5000")
     os.environ.setdefault("COSIGN_PASSWORD", "testpassword")
 
@@ -0,0 +1,125 @@
+# tests/unit/test_cache_accounting.py
+"""
+Unit tests for incremental cache size accounting
+"""
+
+import asyncio
+import hashlib
+import os
+
+import pytest
+
+from sek8s.system_manager.cache.accounting import ChuteUsage, UsageTracker
+from sek8s.system_manager.cache.fileio import open_noatime
+
+CHUTE_ID = "0" * 8 + "-0000-0000-0000-" + "0" * 12
+
+
+def _add_blob(blobs_dir, size):
+    data = os.urandom(size)
+    path = blobs_dir / hashlib.sha256(data).hexdigest()
+    path.write_bytes(data)
+    return path
+
+
+def _make_repo(cache_base, repo_id="org/model", revision="a" * 40):
+    repo_dir = cache_base / CHUTE_ID / "hub" / f"models--{repo_id.replace('/', '--')}"
+    (repo_dir / "snapshots" / revision).mkdir(parents=True)
+    blobs = repo_dir / "blobs"
+    blobs.mkdir()
+    return blobs
+
+
+def test_rescan_tallies_blobs_and_identity(tmp_path):
+    """A rescan sums blob sizes and ignores partial downloads and sidecars."""
+    blobs = _make_repo(tmp_path)
+    _add_blob(blobs, 1000)
+    _add_blob(blobs, 2500)
+    (blobs / ("f" * 64 + ".chunked")).write_bytes(b"x" * 4096)
+
+    usage = ChuteUsage(tmp_path / CHUTE_ID)
+    usage.rescan()
+
+    assert usage.size_bytes == 3500
+    assert usage.repo_id == "org/model"
+    assert usage.revision == "a" * 40
+    assert usage.last_accessed is not None
+    assert not usage.dirty
+
+
+def test_blob_events_adjust_tally(tmp_path):
+    """Updates replace a blob's previous size instead of double counting it."""
+    blobs = _make_repo(tmp_path)
+    usage = ChuteUsage(tmp_path / CHUTE_ID)
+    usage.rescan()
+
+    blob = _add_blob(blobs, 100)
+    usage.blob_updated(str(blob))
+    usage.blob_updated(str(blob))
+    assert usage.size_bytes == 100
+
+    blob.unlink()
+    usage.blob_updated(str(blob))  # vanished before the event was handled
+    assert usage.size_bytes == 0
+    usage.blob_removed(str(blob))
+    assert usage.size_bytes == 0
+
+
+@pytest.mark.asyncio
+async def test_tracker_follows_new_blobs_with_inotify(tmp_path):
+    """Blobs written after the first read are counted without another rescan."""
+    blobs = _make_repo(tmp_path)
+    _add_blob(blobs, 300)
+
+    tracker = UsageTracker(tmp_path)
+    tracker.start()
+    if not tracker.watching:
+        pytest.skip("inotify not available")
+    try:
+        assert (await tracker.read(CHUTE_ID)).size_bytes == 300
+        scanned_at = tracker.usage(CHUTE_ID).scanned_at
+
+        _add_blob(blobs, 700)
+        for _ in range(50):
+            await asyncio.sleep(0.01)
+            if tracker.usage(CHUTE_ID).size_bytes == 1000:
+                break
+
+        usage = await tracker.read(CHUTE_ID)
+        assert usage.size_bytes == 1000
+        assert usage.scanned_at == scanned_at
+    finally:
+        tracker.stop()
+
+
+def test_internal_reads_do_not_count_as_access(tmp_path):
+    """Blobs read through open_noatime (verification, prewarm, peers) keep their atime."""
+    if not hasattr(os, "O_NOATIME"):
+        pytest.skip("O_NOATIME not available")
+    blobs = _make_repo(tmp_path)
+    blob = _add_blob(blobs, 10)
+    os.utime(blob, (0, 0))
+
+    fd = open_noatime(blob)
+    try:
+        assert os.read(fd, 10)
+    finally:
+        os.close(fd)
+
+    usage = ChuteUsage(tmp_path / CHUTE_ID)
+    usage.rescan()
+    assert usage.last_accessed == 0
+
+
+@pytest.mark.asyncio
+async def test_tracker_rescans_when_invalidated(tmp_path):
+    """Without inotify, invalidate() forces the next read to rebuild the tally."""
+    blobs = _make_repo(tmp_path)
+    tracker = UsageTracker(tmp_path)
+
+    assert (await tracker.read(CHUTE_ID)).size_bytes == 0
+    _add_blob(blobs, 42)
+    assert (await tracker.read(CHUTE_ID)).size_bytes == 0
+
+    tracker.invalidate(CHUTE_ID)
+    assert (await tracker.read(CHUTE_ID)).size_bytes == 42
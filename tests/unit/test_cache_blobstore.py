@@ -0,0 +1,167 @@
+# tests/unit/test_cache_blobstore.py
+"""
+Unit tests for the shared content-addressed blob store
+"""
+
+import hashlib
+import os
+import shutil
+import time
+from concurrent.futures import ThreadPoolExecutor
+
+from sek8s.system_manager.cache.blobstore import BlobStore, share_snapshot
+from sek8s.system_manager.cache.manifest import VerificationManifest
+
+REPO = "org/model"
+REVISION = "b" * 40
+
+
+def _chute(cache_base, chute_id, data):
+    """Create a chute dir holding one LFS file; returns (chute_dir, snapshot_dir, blob_path)."""
+    chute_dir = cache_base / chute_id
+    repo_dir = chute_dir / "hub" / "models--org--model"
+    digest = hashlib.sha256(data).hexdigest()
+    (repo_dir / "blobs").mkdir(parents=True)
+    snapshot_dir = repo_dir / "snapshots" / REVISION
+    snapshot_dir.mkdir(parents=True)
+    blob = repo_dir / "blobs" / digest
+    blob.write_bytes(data)
+    (snapshot_dir / "model.safetensors").symlink_to(f"../../blobs/{digest}")
+    return chute_dir, snapshot_dir, blob
+
+
+def test_adopt_deduplicates_identical_blobs(tmp_path):
+    """The second chute's copy is replaced by a link to the first one's inode."""
+    store = BlobStore(tmp_path / ".blobs")
+    data = os.urandom(10000)
+    _, snap_a, blob_a = _chute(tmp_path, "a", data)
+    _, snap_b, blob_b = _chute(tmp_path, "b", data)
+
+    assert store.adopt_snapshot(snap_a) == (1, 0)
+    assert store.adopt_snapshot(snap_b) == (1, len(data))
+
+    assert os.stat(blob_a).st_ino == os.stat(blob_b).st_ino
+    assert store.refcount(blob_a.name, "sha256") == 2
+    assert blob_b.read_bytes() == data
+
+
+def test_delete_frees_bytes_only_with_last_reference(tmp_path):
+    store = BlobStore(tmp_path / ".blobs")
+    data = os.urandom(10000)
+    chute_a, snap_a, blob_a = _chute(tmp_path, "a", data)
+    chute_b, snap_b, _ = _chute(tmp_path, "b", data)
+    store.adopt_snapshot(snap_a)
+    store.adopt_snapshot(snap_b)
+    entry = store.path_for(blob_a.name, "sha256")
+
+    assert store.exclusive_bytes(chute_a) == 0
+    assert store.unique_bytes([chute_a, chute_b]) == len(data)
+
+    shared = store.shared_entries(chute_a)
+    shutil.rmtree(chute_a)
+    assert store.release(shared) == 0
+    assert entry.exists()
+
+    assert store.exclusive_bytes(chute_b) == len(data)
+    shared = store.shared_entries(chute_b)
+    shutil.rmtree(chute_b)
+    assert store.release(shared) == len(data)
+    assert not entry.exists()
+
+
+def test_gc_collects_unreferenced_entries(tmp_path):
+    store = BlobStore(tmp_path / ".blobs")
+    chute_dir, snapshot_dir, _ = _chute(tmp_path, "a", os.urandom(100))
+    store.adopt_snapshot(snapshot_dir)
+    shutil.rmtree(chute_dir)
+
+    assert store.gc() == 100
+    assert not any(p.is_file() for p in store.root.rglob("*"))
+
+
+def test_share_snapshot_keeps_manifest_current(tmp_path):
+    """Deduplicated files keep their verified state instead of forcing a re-hash."""
+    store = BlobStore(tmp_path / ".blobs")
+    data = os.urandom(5000)
+    digest = hashlib.sha256(data).hexdigest()
+    _, snap_a, _ = _chute(tmp_path, "a", data)
+    chute_b, _, blob_b = _chute(tmp_path, "b", data)
+    store.adopt_snapshot(snap_a)
+
+    manifest = VerificationManifest(REPO, REVISION)
+    manifest.record("model.safetensors", os.stat(blob_b), digest, "sha256")
+    manifest.save(chute_b)
+
+    assert share_snapshot(store, chute_b, REPO, REVISION) == (1, len(data))
+
+    reloaded = VerificationManifest.load(chute_b, REPO, REVISION)
+    assert reloaded.is_verified("model.safetensors", os.stat(blob_b), digest, "sha256")
+
+
+def test_in_place_write_with_restored_mtime_is_detected(tmp_path):
+    """Adding the store link is re-recorded; rewriting the shared inode and restoring mtime is not."""
+    store = BlobStore(tmp_path / ".blobs")
+    data = os.urandom(5000)
+    digest = hashlib.sha256(data).hexdigest()
+    chute_a, _, blob_a = _chute(tmp_path, "a", data)
+
+    manifest = VerificationManifest(REPO, REVISION)
+    manifest.record("model.safetensors", os.stat(blob_a), digest, "sha256")
+    manifest.save(chute_a)
+    time.sleep(0.05)  # past the filesystem's timestamp granularity
+
+    assert share_snapshot(store, chute_a, REPO, REVISION) == (1, 0)
+    manifest = VerificationManifest.load(chute_a, REPO, REVISION)
+    assert manifest.is_verified("model.safetensors", os.stat(blob_a), digest, "sha256")
+
+    st = os.stat(blob_a)
+    time.sleep(0.05)
+    with open(store.path_for(digest, "sha256"), "r+b") as f:
+        f.write(os.urandom(16))
+    os.utime(blob_a, ns=(st.st_atime_ns, st.st_mtime_ns))
+    assert not manifest.is_verified("model.safetensors", os.stat(blob_a), digest, "sha256")
+
+
+def test_link_into_uses_unique_temp_names(tmp_path):
+    """Concurrent links of one blob into the same chute do not trip over each other's temp file."""
+    store = BlobStore(tmp_path / ".blobs")
+    data = os.urandom(100)
+    digest = hashlib.sha256(data).hexdigest()
+    _, snapshot_dir, _ = _chute(tmp_path, "a", data)
+    store.adopt_snapshot(snapshot_dir)
+    dest = tmp_path / "b" / digest
+    dest.parent.mkdir()
+
+    with ThreadPoolExecutor(8) as pool:
+        assert all(pool.map(lambda _: store.link_into(digest, "sha256", dest), range(64)))
+    assert dest.read_bytes() == data
+    assert os.listdir(dest.parent) == [digest]
+
+
+def test_changed_store_entry_is_replaced_not_linked(tmp_path):
+    """A store entry rewritten since it was recorded is never handed to another chute as verified."""
+    store = BlobStore(tmp_path / ".blobs")
+    data = os.urandom(5000)
+    digest = hashlib.sha256(data).hexdigest()
+    _, snap_a, blob_a = _chute(tmp_path, "a", data)
+    chute_b, _, blob_b = _chute(tmp_path, "b", data)
+    store.adopt_snapshot(snap_a)
+    assert store.is_verified(digest, "sha256")
+
+    st = os.stat(blob_a)
+    time.sleep(0.05)
+    with open(store.path_for(digest, "sha256"), "r+b") as f:
+        f.write(os.urandom(16))  # same size, mtime restored below
+    os.utime(blob_a, ns=(st.st_atime_ns, st.st_mtime_ns))
+    assert not store.is_verified(digest, "sha256")
+
+    manifest = VerificationManifest(REPO, REVISION)
+    manifest.record("model.safetensors", os.stat(blob_b), digest, "sha256")
+    manifest.save(chute_b)
+    assert share_snapshot(store, chute_b, REPO, REVISION) == (1, 0)
+
+    assert blob_b.read_bytes() == data
+    assert store.is_shared(blob_b) and not store.is_shared(blob_a)
+    assert store.is_verified(digest, "sha256")
+    reloaded = VerificationManifest.load(chute_b, REPO, REVISION)
+    assert reloaded.is_verified("model.safetensors", os.stat(blob_b), digest, "sha256")
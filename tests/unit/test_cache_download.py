@@ -0,0 +1,206 @@
+# tests/unit/test_cache_download.py
+"""
+Unit tests for the chunked cache download engine
+"""
+
+import errno
+import hashlib
+import json
+import os
+
+import pytest
+import pytest_asyncio
+from aiohttp import web
+from aiohttp.test_utils import TestServer
+
+from sek8s.system_manager.cache.download import ChunkCheckpoint, ChunkedDownloader, DownloadProgress, RemoteFile
+from sek8s.system_manager.cache.manifest import VERIFY_MANIFEST_FILE
+from sek8s.system_manager.cache.merkle import MerkleManifest
+
+REVISION = "a" * 40
+CHUNK = 64 * 1024
+
+
+@pytest_asyncio.fixture
+async def hub(tmp_path):
+    """Serve a fake repo at /org/model/resolve/<rev>/ with Range support."""
+    origin = tmp_path / "origin"
+    files = {"model.safetensors": os.urandom(5 * CHUNK + 123), "nested/config.json": os.urandom(321)}
+    remote = []
+    for name, data in files.items():
+        (origin / name).parent.mkdir(parents=True, exist_ok=True)
+        (origin / name).write_bytes(data)
+        if name.endswith(".safetensors"):
+            remote.append(RemoteFile(name, len(data), hashlib.sha256(data).hexdigest(), "sha256"))
+        else:
+            blob_id = hashlib.sha1(b"blob %d\0" % len(data) + data).hexdigest()
+            remote.append(RemoteFile(name, len(data), blob_id, "git-sha1"))
+
+    app = web.Application()
+    app.router.add_static(f"/org/model/resolve/{REVISION}/", origin)
+    server = TestServer(app)
+    await server.start_server()
+    yield str(server.make_url("")).rstrip("/"), files, remote
+    await server.close()
+
+
+def test_checkpoint_round_trip(tmp_path):
+    """Completed chunks survive a reload; a different chunk size invalidates the checkpoint."""
+    path = tmp_path / "blob.chunked.json"
+    checkpoint = ChunkCheckpoint(path, 10 * CHUNK + 1, CHUNK, "abc")
+    checkpoint.mark_done(0)
+    checkpoint.mark_done(10)
+    checkpoint.save()
+
+    reloaded = ChunkCheckpoint.load(path, 10 * CHUNK + 1, CHUNK, "abc")
+    assert reloaded.num_chunks == 11
+    assert reloaded.missing() == list(range(1, 10))
+    assert reloaded.bytes_done() == CHUNK + 1
+
+    assert ChunkCheckpoint.load(path, 10 * CHUNK + 1, 2 * CHUNK, "abc").bytes_done() == 0
+
+
+@pytest.mark.asyncio
+async def test_download_builds_hub_layout(hub, tmp_path):
+    """Files land in blobs/ with relative snapshot symlinks and are recorded as verified."""
+    endpoint, files, remote = hub
+    cache_dir = tmp_path / "chute"
+    progress = DownloadProgress()
+
+    await ChunkedDownloader(endpoint, chunk_size=CHUNK, connections=4).download(
+        "org/model", REVISION, cache_dir, remote, progress
+    )
+
+    snapshot = cache_dir / "hub" / "models--org--model" / "snapshots" / REVISION
+    for name, data in files.items():
+        assert (snapshot / name).is_symlink()
+        assert (snapshot / name).read_bytes() == data
+    assert os.readlink(snapshot / "nested" / "config.json").startswith("../../../blobs/")
+    assert progress.bytes_done == progress.bytes_total == sum(len(d) for d in files.values())
+    entries = json.loads((cache_dir / VERIFY_MANIFEST_FILE).read_text())["entries"]
+    assert set(entries) == set(files)
+
+
+@pytest.mark.asyncio
+async def test_download_fetches_shared_blobs_once(hub, tmp_path):
+    """Paths with identical content (e.g. empty files) all link to one blob fetched once."""
+    endpoint, files, remote = hub
+    origin = tmp_path / "origin"
+    empty_blob = hashlib.sha1(b"blob 0\0").hexdigest()
+    for name in ("a/.gitkeep", "b/.gitkeep"):
+        (origin / name).parent.mkdir(parents=True, exist_ok=True)
+        (origin / name).write_bytes(b"")
+    big = remote[0]
+    (origin / "copy.safetensors").write_bytes(files[big.path])
+    remote = remote + [
+        RemoteFile("a/.gitkeep", 0, empty_blob, "git-sha1"),
+        RemoteFile("b/.gitkeep", 0, empty_blob, "git-sha1"),
+        RemoteFile("copy.safetensors", big.size, big.blob, big.algorithm),
+    ]
+    cache_dir = tmp_path / "chute"
+    progress = DownloadProgress()
+
+    await ChunkedDownloader(endpoint, chunk_size=CHUNK).download("org/model", REVISION, cache_dir, remote, progress)
+
+    snapshot = cache_dir / "hub" / "models--org--model" / "snapshots" / REVISION
+    assert (snapshot / "copy.safetensors").read_bytes() == files[big.path]
+    assert (snapshot / "b" / ".gitkeep").read_bytes() == b""
+    assert progress.files_done == progress.files_total == 3
+    entries = json.loads((cache_dir / VERIFY_MANIFEST_FILE).read_text())["entries"]
+    assert set(entries) == {r.path for r in remote}
+
+
+@pytest.mark.asyncio
+async def test_download_resumes_from_checkpoint(hub, tmp_path):
+    """Only chunks missing from the checkpoint are fetched again."""
+    endpoint, files, remote = hub
+    cache_dir = tmp_path / "chute"
+    big = remote[0]
+    data = files[big.path]
+    blobs = cache_dir / "hub" / "models--org--model" / "blobs"
+    blobs.mkdir(parents=True)
+    (blobs / f"{big.blob}.chunked").write_bytes(data[: 3 * CHUNK] + bytes(len(data) - 3 * CHUNK))
+    checkpoint = ChunkCheckpoint(blobs / f"{big.blob}.chunked.json", big.size, CHUNK, big.blob)
+    for index in range(3):
+        checkpoint.mark_done(index)
+    checkpoint.save()
+
+    progress = DownloadProgress()
+    await ChunkedDownloader(endpoint, chunk_size=CHUNK).download("org/model", REVISION, cache_dir, [big], progress)
+
+    assert (blobs / big.blob).read_bytes() == data
+    assert progress.bytes_resumed == 3 * CHUNK
+    assert not (blobs / f"{big.blob}.chunked.json").exists()
+
+
+@pytest.mark.asyncio
+async def test_download_discards_corrupt_blob(hub, tmp_path):
+    """A digest mismatch raises and removes the partial blob instead of publishing it."""
+    endpoint, _, remote = hub
+    cache_dir = tmp_path / "chute"
+    bad = RemoteFile(remote[0].path, remote[0].size, "0" * 64, "sha256")
+
+    with pytest.raises(ValueError, match="Hash mismatch"):
+        await ChunkedDownloader(endpoint, chunk_size=CHUNK).download("org/model", REVISION, cache_dir, [bad])
+
+    assert list((cache_dir / "hub" / "models--org--model" / "blobs").iterdir()) == []
+
+
+@pytest.mark.asyncio
+async def test_repair_refetches_only_damaged_leaves(hub, tmp_path):
+    """A flipped byte in a downloaded blob costs one leaf of traffic to repair."""
+    endpoint, files, remote = hub
+    cache_dir = tmp_path / "chute"
+    big = remote[0]
+    downloader = ChunkedDownloader(endpoint, chunk_size=CHUNK, leaf_size=CHUNK)
+    await downloader.download("org/model", REVISION, cache_dir, remote)
+    assert MerkleManifest.load(cache_dir).get(big.blob).num_leaves == 6
+
+    blob = cache_dir / "hub" / "models--org--model" / "blobs" / big.blob
+    corrupt = bytearray(blob.read_bytes())
+    corrupt[2 * CHUNK + 17] ^= 0xFF
+    blob.write_bytes(bytes(corrupt))
+
+    assert await downloader.repair("org/model", REVISION, cache_dir, big) == CHUNK
+    assert blob.read_bytes() == files[big.path]
+    assert await downloader.repair("org/model", REVISION, cache_dir, big) == 0
+
+
+@pytest.mark.asyncio
+async def test_repair_never_writes_through_other_links(hub, tmp_path):
+    """A hardlinked blob is repaired in a private copy; the other link keeps its inode and bytes."""
+    endpoint, files, remote = hub
+    cache_dir = tmp_path / "chute"
+    big = remote[0]
+    downloader = ChunkedDownloader(endpoint, chunk_size=CHUNK, leaf_size=CHUNK)
+    await downloader.download("org/model", REVISION, cache_dir, [big])
+
+    blob = cache_dir / "hub" / "models--org--model" / "blobs" / big.blob
+    corrupt = bytearray(blob.read_bytes())
+    corrupt[17] ^= 0xFF
+    blob.write_bytes(bytes(corrupt))
+    other = tmp_path / "other-link"
+    os.link(blob, other)
+
+    assert await downloader.repair("org/model", REVISION, cache_dir, big) == CHUNK
+    assert blob.read_bytes() == files[big.path]
+    assert other.read_bytes() == bytes(corrupt)
+    assert os.stat(other).st_nlink == 1
+    assert sorted(p.name for p in blob.parent.iterdir()) == [big.blob]
+
+
+@pytest.mark.asyncio
+async def test_download_fails_fast_without_space(hub, tmp_path, monkeypatch):
+    """Blobs are allocated before any chunk is fetched, so ENOSPC surfaces immediately."""
+    endpoint, _, remote = hub
+
+    def enospc(fd, offset, length):
+        raise OSError(errno.ENOSPC, "No space left on device")
+
+    monkeypatch.setattr(os, "posix_fallocate", enospc)
+    progress = DownloadProgress()
+    with pytest.raises(OSError):
+        await ChunkedDownloader(endpoint, chunk_size=CHUNK).download(
+            "org/model", REVISION, tmp_path / "chute", remote, progress
+        )
+    assert progress.bytes_done == 0
@@ -0,0 +1,102 @@
+# tests/unit/test_cache_events.py
+"""
+Unit tests for the cache event bus behind /cache/events
+"""
+
+import asyncio
+import json
+
+import pytest
+
+from sek8s.system_manager.cache.events import CacheEventBus
+
+
+def _parse(message):
+    fields = dict(line.split(": ", 1) for line in message.strip().splitlines())
+    return fields["event"], json.loads(fields["data"])
+
+
+class _Source:
+    def __init__(self, state):
+        self.state = state
+        self.calls = 0
+
+    async def __call__(self):
+        self.calls += 1
+        return {cid: dict(status) for cid, status in self.state.items()}
+
+
+@pytest.mark.asyncio
+async def test_snapshot_then_deltas():
+    source = _Source({"a": {"status": "in_progress", "percent_complete": 10.0, "repo_id": "org/m"}})
+    bus = CacheEventBus(source, interval=0.01)
+    stream = bus.subscribe()
+
+    event, data = _parse(await stream.__anext__())
+    assert event == "snapshot"
+    assert data["chutes"] == [{"chute_id": "a", "status": "in_progress", "percent_complete": 10.0, "repo_id": "org/m"}]
+
+    source.state["a"]["percent_complete"] = 55.0
+    event, data = _parse(await asyncio.wait_for(stream.__anext__(), 1))
+    assert (event, data) == ("update", {"chute_id": "a", "percent_complete": 55.0})
+
+    del source.state["a"]
+    event, data = _parse(await asyncio.wait_for(stream.__anext__(), 1))
+    assert (event, data) == ("removed", {"chute_id": "a"})
+
+    await stream.aclose()
+    assert bus.subscriber_count == 0
+    calls = source.calls
+    await asyncio.sleep(0.05)
+    assert source.calls == calls  # producer stops with the last subscriber
+
+
+@pytest.mark.asyncio
+async def test_subscribers_share_one_producer_and_filter():
+    source = _Source({"a": {"percent_complete": 1.0}, "b": {"percent_complete": 1.0}})
+    bus = CacheEventBus(source, interval=0.01)
+    everything = bus.subscribe()
+    only_b = bus.subscribe("b")
+    await everything.__anext__()
+    _, data = _parse(await only_b.__anext__())
+    assert [c["chute_id"] for c in data["chutes"]] == ["b"]
+
+    source.state["a"]["percent_complete"] = 2.0
+    source.state["b"]["percent_complete"] = 2.0
+    _, data = _parse(await asyncio.wait_for(only_b.__anext__(), 1))
+    assert data["chute_id"] == "b"
+    received = {_parse(await asyncio.wait_for(everything.__anext__(), 1))[1]["chute_id"] for _ in range(2)}
+    assert received == {"a", "b"}
+
+    await asyncio.sleep(0.05)
+    # One sample per interval regardless of the number of subscribers
+    assert source.calls < 20
+    await everything.aclose()
+    await only_b.aclose()
+
+
+@pytest.mark.asyncio
+async def test_slow_subscriber_gets_fresh_snapshot():
+    source = _Source({"a": {"percent_complete": 0.0}})
+    bus = CacheEventBus(source, interval=0.001, queue_size=2)
+    stream = bus.subscribe()
+    await stream.__anext__()
+
+    for pct in range(1, 20):
+        source.state["a"]["percent_complete"] = float(pct)
+        await asyncio.sleep(0.005)
+
+    event, data = _parse(await asyncio.wait_for(stream.__anext__(), 1))
+    assert event == "snapshot"
+    assert data["chutes"][0]["percent_complete"] >= 3.0
+    await stream.aclose()
+
+
+@pytest.mark.asyncio
+async def test_keepalive_when_idle():
+    bus = CacheEventBus(_Source({}), interval=0.01, keepalive=0.02)
+    stream = bus.subscribe()
+    await stream.__anext__()
+
+    assert await asyncio.wait_for(stream.__anext__(), 1) == ": keepalive\n\n"
+    await stream.aclose()
@@ -0,0 +1,79 @@
+# tests/unit/test_cache_eviction.py
+"""
+Unit tests for watermark-driven cache eviction
+"""
+
+import os
+import time
+
+import pytest
+from unittest.mock import patch
+
+from sek8s.config import cache_config
+from sek8s.system_manager.cache import manager as manager_module
+from sek8s.system_manager.cache.eviction import AccessStats, DiskUsage, eviction_score, eviction_target
+from sek8s.system_manager.cache.manager import CacheManager, HuggingFaceSnapshot
+
+GIB = 1024 ** 3
+DAY = 86400.0
+
+
+def test_eviction_target_between_watermarks():
+    assert eviction_target(DiskUsage(total=100 * GIB, available=15 * GIB), high=0.9, low=0.8) == 0
+    assert eviction_target(DiskUsage(total=100 * GIB, available=5 * GIB), high=0.9, low=0.8) == 15 * GIB
+
+
+def test_eviction_score_prefers_large_cold_entries():
+    now = time.time()
+    half_life = 3 * DAY
+    hot = AccessStats(hits=20, last_access=now - 3600)
+    cold = AccessStats(hits=20, last_access=now - 30 * DAY)
+
+    # Same size: recency decides
+    assert eviction_score(cold, 10 * GIB, now, half_life) < eviction_score(hot, 10 * GIB, now, half_life)
+    # Same history: the larger entry goes first
+    assert eviction_score(cold, 100 * GIB, now, half_life) < eviction_score(cold, 10 * GIB, now, half_life)
+    # Frequency counts
+    assert eviction_score(AccessStats(hits=1, last_access=now - DAY), 10 * GIB, now, half_life) < \
+        eviction_score(AccessStats(hits=50, last_access=now - DAY), 10 * GIB, now, half_life)
+
+
+def _add_chute(mgr, cache_base, index, size, access):
+    chute_id = f"{index:08d}-0000-0000-0000-000000000000"
+    blobs = cache_base / chute_id / "hub" / "models--org--model" / "blobs"
+    blobs.mkdir(parents=True)
+    blob = blobs / ("%064x" % index)
+    blob.write_bytes(b"\0" * size)
+    os.utime(blob, (time.time() - 30 * DAY, time.time() - 30 * DAY))
+    chute = HuggingFaceSnapshot(chute_id=chute_id, tracker=mgr.usage)
+    chute.access = access
+    mgr._chutes[chute_id] = chute
+    return chute_id
+
+
+@pytest.mark.asyncio
+async def test_evict_to_watermark_skips_entries_in_use(tmp_path):
+    now = time.time()
+    old = now - 10 * DAY
+    with patch.object(cache_config, "cache_base", str(tmp_path)), \
+            patch.object(cache_config, "blob_store_enabled", False):
+        mgr = CacheManager()
+        leased = _add_chute(mgr, tmp_path, 1, 8000, AccessStats(1, old, lease_until=now + 600))
+        recent = _add_chute(mgr, tmp_path, 2, 8000, AccessStats(1, now - 60))
+        cold_large = _add_chute(mgr, tmp_path, 3, 8000, AccessStats(1, old))
+        cold_small = _add_chute(mgr, tmp_path, 4, 1000, AccessStats(1, old))
+
+        # 95% full; freeing 5000 bytes reaches the low watermark
+        usage = DiskUsage(total=100000, available=5000)
+        with patch.object(manager_module, "disk_usage", return_value=usage), \
+                patch.object(cache_config, "eviction_high_watermark", 0.9), \
+                patch.object(cache_config, "eviction_low_watermark", 0.9):
+            result = await mgr.evict_to_watermark()
+
+        assert result.removed_chutes == [cold_large]
+        assert result.freed_bytes == 8000
+        assert set(mgr._chutes) == {leased, recent, cold_small}
+
+        below = DiskUsage(total=100000, available=50000)
+        with patch.object(manager_module, "disk_usage", return_value=below):
+            assert (await mgr.evict_to_watermark()).removed_chutes == []
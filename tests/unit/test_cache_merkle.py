@@ -0,0 +1,63 @@
+# tests/unit/test_cache_merkle.py
+"""
+Unit tests for per-blob Merkle manifests used by partial cache repair
+"""
+
+import hashlib
+import os
+
+from sek8s.system_manager.cache.merkle import LeafHasher, MerkleEntry, MerkleManifest, merkle_root
+
+LEAF = 4096
+
+
+def _leaves(data, leaf_size=LEAF):
+    return [hashlib.sha256(data[i:i + leaf_size]).hexdigest() for i in range(0, len(data), leaf_size)]
+
+
+def test_leaf_hasher_matches_fixed_ranges():
+    """Leaves do not depend on how the stream is split into updates."""
+    data = os.urandom(3 * LEAF + 100)
+    hasher = LeafHasher(LEAF)
+    for i in range(0, len(data), 1000):
+        hasher.update(data[i:i + 1000])
+
+    assert hasher.finish() == _leaves(data)
+
+
+def test_root_detects_tampered_leaves():
+    leaves = _leaves(os.urandom(5 * LEAF))
+    entry = MerkleEntry.from_leaves(5 * LEAF, LEAF, leaves)
+    assert entry.is_consistent()
+    assert merkle_root(leaves) != merkle_root(leaves[::-1])
+
+    entry.leaves[2] = "0" * 64
+    assert not entry.is_consistent()
+
+
+def test_damaged_leaves(tmp_path):
+    data = os.urandom(4 * LEAF + 10)
+    path = tmp_path / "blob"
+    entry = MerkleEntry.from_leaves(len(data), LEAF, _leaves(data))
+
+    corrupt = bytearray(data)
+    corrupt[LEAF + 7] ^= 0xFF
+    path.write_bytes(bytes(corrupt))
+    assert entry.damaged_leaves(path) == [1]
+
+    path.write_bytes(data[: 3 * LEAF])  # truncated: tail leaves damaged, file left as is
+    assert entry.damaged_leaves(path) == [3, 4]
+    assert path.stat().st_size == 3 * LEAF
+
+
+def test_manifest_round_trip_drops_inconsistent_entries(tmp_path):
+    manifest = MerkleManifest()
+    good = os.urandom(2 * LEAF)
+    manifest.record("good", len(good), LEAF, _leaves(good))
+    manifest.record("bad", len(good), LEAF, _leaves(good))
+    manifest.entries["bad"].leaves[0] = "0" * 64
+    manifest.save(tmp_path)
+
+    reloaded = MerkleManifest.load(tmp_path)
+    assert set(reloaded.entries) == {"good"}
+    assert reloaded.prune({"other"}) == 1
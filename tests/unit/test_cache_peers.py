@@ -0,0 +1,117 @@
+# tests/unit/test_cache_peers.py
+"""
+Unit tests for fetching cache blobs from peer nodes
+"""
+
+import hashlib
+import os
+
+import pytest
+import pytest_asyncio
+from aiohttp import web
+from aiohttp.test_utils import TestServer
+
+from sek8s.system_manager.cache.download import ChunkedDownloader, DownloadProgress, RemoteFile
+from sek8s.system_manager.cache.peers import PeerDirectory, parse_range
+
+REVISION = "b" * 40
+CHUNK = 64 * 1024
+
+
+async def _serve(app, servers):
+    server = TestServer(app)
+    await server.start_server()
+    servers.append(server)
+    return str(server.make_url("")).rstrip("/")
+
+
+async def _hub(tmp_path, files, servers):
+    origin = tmp_path / "origin"
+    for name, data in files.items():
+        (origin / name).parent.mkdir(parents=True, exist_ok=True)
+        (origin / name).write_bytes(data)
+    app = web.Application()
+    app.router.add_static(f"/org/model/resolve/{REVISION}/", origin)
+    return await _serve(app, servers)
+
+
+async def _peer(tmp_path, name, blobs, servers, serve=True):
+    """A node advertising ``blobs`` (name -> bytes) and serving them (unless not ``serve``) like the system-manager."""
+    root = tmp_path / name
+    root.mkdir()
+    for blob, data in blobs.items():
+        (root / blob).write_bytes(data)
+
+    async def listing(_):
+        return web.json_response({"blobs": [{"blob": b, "size": len(d)} for b, d in blobs.items()]})
+
+    app = web.Application()
+    app.router.add_get("/cache/peer/blobs", listing)
+    if serve:
+        app.router.add_static("/cache/peer/blobs/", root)
+    return await _serve(app, servers)
+
+
+@pytest_asyncio.fixture
+async def servers():
+    running = []
+    yield running
+    for server in running:
+        await server.close()
+
+
+def test_parse_range():
+    assert parse_range(None, 100) is None
+    assert parse_range("bytes=10-19", 100) == (10, 19)
+    assert parse_range("bytes=90-", 100) == (90, 99)
+    assert parse_range("bytes=50-500", 100) == (50, 99)
+    assert parse_range("bytes=-10", 100) == (90, 99)
+    for bad in ("bytes=100-", "bytes=5-1", "items=0-1", "bytes=0-1,5-6"):
+        with pytest.raises(ValueError):
+            parse_range(bad, 100)
+
+
+@pytest.mark.asyncio
+async def test_download_prefers_peers_and_falls_back(tmp_path, servers):
+    """Blobs a peer holds come from peers; the rest, and chunks a peer fails to serve, come from the hub."""
+    big, small = os.urandom(6 * CHUNK + 7), os.urandom(1000)
+    remote = [
+        RemoteFile("model.safetensors", len(big), hashlib.sha256(big).hexdigest(), "sha256"),
+        RemoteFile("tokenizer.safetensors", len(small), hashlib.sha256(small).hexdigest(), "sha256"),
+    ]
+    endpoint = await _hub(tmp_path, {"model.safetensors": big, "tokenizer.safetensors": small}, servers)
+    peer = await _peer(tmp_path, "peer", {remote[0].blob: big}, servers)
+    broken = await _peer(tmp_path, "broken", {remote[1].blob: small}, servers, serve=False)
+    peers = PeerDirectory([peer, broken, "http://127.0.0.1:9"], timeout=2)
+
+    cache_dir = tmp_path / "chute"
+    progress = DownloadProgress()
+    await ChunkedDownloader(endpoint, chunk_size=CHUNK, connections=4, peers=peers).download(
+        "org/model", REVISION, cache_dir, remote, progress
+    )
+
+    blobs = cache_dir / "hub" / "models--org--model" / "blobs"
+    assert (blobs / remote[0].blob).read_bytes() == big
+    assert (blobs / remote[1].blob).read_bytes() == small
+    assert progress.bytes_from_peers == len(big)
+    assert progress.bytes_done == len(big) + len(small)
+
+
+@pytest.mark.asyncio
+async def test_corrupt_peer_blob_is_refetched_from_hub(tmp_path, servers):
+    """Peer bytes are only trusted once the blob's digest matches; otherwise the hub serves it again."""
+    data = os.urandom(4 * CHUNK)
+    remote = RemoteFile("model.safetensors", len(data), hashlib.sha256(data).hexdigest(), "sha256")
+    endpoint = await _hub(tmp_path, {"model.safetensors": data}, servers)
+    tampered = bytearray(data)
+    tampered[CHUNK + 3] ^= 0xFF
+    peer = await _peer(tmp_path, "peer", {remote.blob: bytes(tampered)}, servers)
+
+    cache_dir = tmp_path / "chute"
+    progress = DownloadProgress()
+    await ChunkedDownloader(endpoint, chunk_size=CHUNK, peers=PeerDirectory([peer])).download(
+        "org/model", REVISION, cache_dir, [remote], progress
+    )
+
+    assert (cache_dir / "hub" / "models--org--model" / "blobs" / remote.blob).read_bytes() == data
+    assert progress.bytes_done == len(data)
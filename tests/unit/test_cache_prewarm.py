@@ -0,0 +1,77 @@
+# tests/unit/test_cache_prewarm.py
+"""
+Unit tests for page-cache prewarming and residency reporting
+"""
+
+import os
+import threading
+
+from sek8s.system_manager.cache.prewarm import Prewarmer, resident_bytes, snapshot_files
+
+
+def _make_snapshot(tmp_path, sizes):
+    blobs = tmp_path / "blobs"
+    snapshot = tmp_path / "snapshots" / ("a" * 40)
+    blobs.mkdir()
+    snapshot.mkdir(parents=True)
+    for i, (name, size) in enumerate(sizes.items()):
+        blob = blobs / ("%064x" % i)
+        blob.write_bytes(os.urandom(size))
+        (snapshot / name).symlink_to(f"../../blobs/{blob.name}")
+    return snapshot
+
+
+def test_snapshot_files_in_load_order(tmp_path):
+    snapshot = _make_snapshot(
+        tmp_path, {"model-00002.safetensors": 10, "config.json": 5, "model-00001.safetensors": 20}
+    )
+
+    files = snapshot_files(snapshot)
+
+    assert [f.rel_path for f in files] == ["config.json", "model-00001.safetensors", "model-00002.safetensors"]
+    assert [f.size for f in files] == [5, 20, 10]
+
+
+def test_prewarm_stops_at_budget(tmp_path):
+    """Files are read in order; the file crossing the budget is only read up to it."""
+    snapshot = _make_snapshot(tmp_path, {"a": 300000, "b": 300000, "c": 300000})
+    prewarmer = Prewarmer(workers=2, segment_size=128 * 1024, window=32 * 1024)
+
+    progress = prewarmer.prewarm(snapshot_files(snapshot), budget=450000)
+
+    assert progress.bytes_total == progress.bytes_done == 450000
+    assert set(progress.files) == {"a", "b"}
+    assert progress.files_done == 2
+    assert progress.finished_at is not None
+    assert not progress.cancelled
+
+
+def test_prewarm_reads_shared_blobs_once(tmp_path):
+    """Two paths to one blob cost its bytes once against the budget."""
+    snapshot = _make_snapshot(tmp_path, {"a": 300000, "c": 300000})
+    (snapshot / "b").symlink_to(os.readlink(snapshot / "a"))
+    prewarmer = Prewarmer(workers=2, segment_size=128 * 1024, window=32 * 1024)
+
+    progress = prewarmer.prewarm(snapshot_files(snapshot), budget=600000)
+
+    assert set(progress.files) == {"a", "c"}
+    assert progress.bytes_done == 600000
+
+
+def test_prewarm_cancel(tmp_path):
+    snapshot = _make_snapshot(tmp_path, {"a": 300000})
+    cancel = threading.Event()
+    cancel.set()
+
+    progress = Prewarmer(workers=1).prewarm(snapshot_files(snapshot), budget=1 << 30, cancel=cancel)
+
+    assert progress.cancelled
+    assert progress.bytes_done == 0
+
+
+def test_resident_bytes_after_read(tmp_path):
+    path = tmp_path / "blob"
+    path.write_bytes(os.urandom(100000))
+    path.read_bytes()
+
+    assert resident_bytes(path) == 100000
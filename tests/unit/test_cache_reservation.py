@@ -0,0 +1,102 @@
+# tests/unit/test_cache_reservation.py
+"""
+Unit tests for download disk-space reservations
+"""
+
+import os
+import time
+
+import pytest
+from unittest.mock import AsyncMock, patch
+
+from sek8s.config import cache_config
+from sek8s.system_manager.cache import manager as manager_module
+from sek8s.system_manager.cache.eviction import AccessStats, DiskUsage
+from sek8s.system_manager.cache.manager import CacheManager, HuggingFaceSnapshot
+from sek8s.system_manager.cache.reservation import InsufficientSpace, SpaceLedger
+
+DAY = 86400.0
+
+
+def test_ledger_admits_against_outstanding_reservations():
+    ledger = SpaceLedger(headroom=100)
+    allocated = {}
+
+    ledger.reserve("a", 600, free=1000, allocated=lambda cid: allocated.get(cid, 0))
+    with pytest.raises(InsufficientSpace):
+        ledger.reserve("b", 400, free=1000, allocated=lambda cid: allocated.get(cid, 0))
+
+    # "a" preallocated its blobs: free space dropped by the same amount its reservation shrank
+    allocated["a"] = 600
+    ledger.reserve("b", 300, free=400, allocated=lambda cid: allocated.get(cid, 0))
+    assert ledger.outstanding(lambda cid: allocated.get(cid, 0)) == 300
+
+    ledger.release("b")
+    assert "b" not in ledger
+
+
+def _files(sizes):
+    return {
+        "files": [
+            {"path": f"model-{i}.safetensors", "size": size, "is_lfs": True, "sha256": "%064x" % (i + 1)}
+            for i, size in enumerate(sizes)
+        ]
+    }
+
+
+@pytest.mark.asyncio
+async def test_start_download_reserves_evicts_and_rejects(tmp_path):
+    repo_info = AsyncMock(return_value=_files([4000, 2000]))
+    with patch.object(cache_config, "cache_base", str(tmp_path)), \
+            patch.object(cache_config, "blob_store_enabled", False), \
+            patch.object(cache_config, "download_engine_enabled", True), \
+            patch.object(cache_config, "space_headroom_gb", 0), \
+            patch.object(manager_module, "fetch_repo_info", repo_info):
+        mgr = CacheManager()
+        # An idle, cold entry holding 5000 bytes
+        cold_id = "00000001-0000-0000-0000-000000000000"
+        blob = tmp_path / cold_id / "hub" / "models--org--old" / "blobs" / ("%064x" % 99)
+        blob.parent.mkdir(parents=True)
+        blob.write_bytes(b"\0" * 5000)
+        os.utime(blob, (time.time() - 30 * DAY, time.time() - 30 * DAY))
+        cold = HuggingFaceSnapshot(chute_id=cold_id, tracker=mgr.usage)
+        cold.access = AccessStats(1, time.time() - 30 * DAY)
+        mgr._chutes[cold_id] = cold
+
+        chute = HuggingFaceSnapshot(chute_id="00000002-0000-0000-0000-000000000000", tracker=mgr.usage)
+        mgr._chutes[chute.chute_id] = chute
+        # A partial blob from an earlier attempt is already allocated
+        blobs = chute.hub_path / "models--org--model" / "blobs"
+        blobs.mkdir(parents=True)
+        (blobs / ("%064x.chunked" % 1)).write_bytes(b"\0" * 1000)
+
+        def usage(_):
+            return DiskUsage(total=100000, available=3000 if blob.exists() else 8000)
+
+        with patch.object(manager_module, "disk_usage", side_effect=usage):
+            assert await mgr._space_needed(chute, "org/model", "main") == 5000
+            await mgr._reserve(chute, "org/model", "main")
+            assert cold_id not in mgr._chutes  # evicted to make room
+            assert chute.chute_id in mgr.reservations
+
+            # 8000 free, 5000 still reserved and nothing left to evict
+            other = HuggingFaceSnapshot(chute_id="00000003-0000-0000-0000-000000000000", tracker=mgr.usage)
+            with pytest.raises(InsufficientSpace):
+                await mgr._reserve(other, "org/model", "main")
+
+
+@pytest.mark.asyncio
+async def test_space_needed_tolerates_repo_info_errors(tmp_path):
+    with patch.object(cache_config, "cache_base", str(tmp_path)), \
+            patch.object(cache_config, "blob_store_enabled", False), \
+            patch.object(manager_module, "fetch_repo_info", AsyncMock(side_effect=ValueError("bad JSON"))):
+        mgr = CacheManager()
+        chute = HuggingFaceSnapshot(chute_id="00000002-0000-0000-0000-000000000000", tracker=mgr.usage)
+        assert await mgr._space_needed(chute, "org/model", "main") == 0
+
+    with patch.object(cache_config, "cache_base", str(tmp_path)), \
+            patch.object(cache_config, "blob_store_enabled", False), \
+            patch.object(manager_module, "fetch_repo_info", AsyncMock(return_value=None)), \
+            patch.object(manager_module, "fetch_repo_total_size", AsyncMock(return_value=123)) as total:
+        assert await mgr._space_needed(chute, "org/model", "main") == 0
+        total.assert_not_called()
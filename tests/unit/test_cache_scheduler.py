@@ -0,0 +1,131 @@
+# tests/unit/test_cache_scheduler.py
+"""
+Unit tests for the cache download scheduler
+"""
+
+import asyncio
+
+import pytest
+
+from sek8s.system_manager.cache.models import DownloadPriority
+from sek8s.system_manager.cache.scheduler import DownloadScheduler
+
+
+class _Job:
+    """Download stand-in that runs until released and records each (re)start."""
+
+    def __init__(self, name, log):
+        self.name = name
+        self.log = log
+        self.release = asyncio.Event()
+
+    async def __call__(self, throttle):
+        self.log.append(("start", self.name))
+        await self.release.wait()
+        self.log.append(("done", self.name))
+        return self.name
+
+
+async def _settle():
+    for _ in range(5):
+        await asyncio.sleep(0)
+
+
+@pytest.mark.asyncio
+async def test_concurrency_cap_and_priority_order():
+    """Only max_concurrent jobs run; queued jobs start by priority, FIFO within a priority."""
+    scheduler = DownloadScheduler(max_concurrent=1, preemption=False)
+    log = []
+    jobs = {n: _Job(n, log) for n in ("a", "b", "c")}
+    tasks = [
+        asyncio.create_task(scheduler.run("a", DownloadPriority.NORMAL, jobs["a"])),
+        asyncio.create_task(scheduler.run("b", DownloadPriority.BACKGROUND, jobs["b"])),
+        asyncio.create_task(scheduler.run("c", DownloadPriority.URGENT, jobs["c"])),
+    ]
+    await _settle()
+    assert log == [("start", "a")]
+    assert scheduler.queue_position("c") == 1
+    assert scheduler.queue_position("b") == 2
+
+    for name in ("a", "c", "b"):
+        jobs[name].release.set()
+        await _settle()
+    assert await asyncio.gather(*tasks) == ["a", "b", "c"]
+    assert [n for e, n in log if e == "start"] == ["a", "c", "b"]
+
+
+@pytest.mark.asyncio
+async def test_urgent_download_preempts_background():
+    """A background download yields its slot to an urgent one and resumes afterwards."""
+    scheduler = DownloadScheduler(max_concurrent=1)
+    log = []
+    background, urgent = _Job("bg", log), _Job("urgent", log)
+
+    bg_task = asyncio.create_task(scheduler.run("bg", DownloadPriority.BACKGROUND, background))
+    await _settle()
+    urgent_task = asyncio.create_task(scheduler.run("urgent", DownloadPriority.URGENT, urgent))
+    await _settle()
+    assert log == [("start", "bg"), ("start", "urgent")]
+    assert scheduler.queue_position("bg") == 1
+
+    urgent.release.set()
+    background.release.set()
+    assert await urgent_task == "urgent"
+    assert await bg_task == "bg"
+    assert log[-2:] == [("start", "bg"), ("done", "bg")]
+
+
+@pytest.mark.asyncio
+async def test_non_preemptible_download_keeps_its_slot():
+    scheduler = DownloadScheduler(max_concurrent=1)
+    log = []
+    background, urgent = _Job("bg", log), _Job("urgent", log)
+
+    bg_task = asyncio.create_task(
+        scheduler.run("bg", DownloadPriority.BACKGROUND, background, preemptible=False)
+    )
+    await _settle()
+    urgent_task = asyncio.create_task(scheduler.run("urgent", DownloadPriority.URGENT, urgent))
+    await _settle()
+    assert log == [("start", "bg")]
+
+    background.release.set()
+    urgent.release.set()
+    await asyncio.gather(bg_task, urgent_task)
+
+
+@pytest.mark.asyncio
+async def test_bandwidth_split_by_priority_weight():
+    scheduler = DownloadScheduler(max_concurrent=2, max_bandwidth=900.0)
+    log = []
+    jobs = [_Job("a", log), _Job("b", log)]
+    tasks = [
+        asyncio.create_task(scheduler.run("a", DownloadPriority.URGENT, jobs[0])),
+        asyncio.create_task(scheduler.run("b", DownloadPriority.BACKGROUND, jobs[1])),
+    ]
+    await _settle()
+    assert scheduler.share("a") == pytest.approx(800.0)
+    assert scheduler.share("b") == pytest.approx(100.0)
+
+    for job in jobs:
+        job.release.set()
+    await asyncio.gather(*tasks)
+    assert scheduler.share("a") is None
+
+
+@pytest.mark.asyncio
+async def test_cancelled_queued_download_frees_its_place():
+    scheduler = DownloadScheduler(max_concurrent=1)
+    log = []
+    first, second = _Job("first", log), _Job("second", log)
+    first_task = asyncio.create_task(scheduler.run("first", DownloadPriority.NORMAL, first))
+    second_task = asyncio.create_task(scheduler.run("second", DownloadPriority.NORMAL, second))
+    await _settle()
+
+    second_task.cancel()
+    await _settle()
+    assert scheduler.queue_position("second") is None
+
+    first.release.set()
+    assert await first_task == "first"
+    assert second_task.cancelled()
@@ -0,0 +1,106 @@
+# tests/unit/test_cache_singleflight.py
+"""
+Unit tests for the singleflight TTL cache used for validator repo manifests
+"""
+
+import asyncio
+
+import pytest
+
+from sek8s.system_manager.cache.singleflight import SingleflightCache
+
+
+@pytest.mark.asyncio
+async def test_concurrent_gets_share_one_load():
+    cache = SingleflightCache(ttl=60, max_entries=10)
+    calls = 0
+
+    async def loader():
+        nonlocal calls
+        calls += 1
+        await asyncio.sleep(0.01)
+        return {"files": []}
+
+    results = await asyncio.gather(*(cache.get("k", loader) for _ in range(10)))
+
+    assert calls == 1
+    assert all(r is results[0] for r in results)
+    assert await cache.get("k", loader) is results[0]
+    assert calls == 1
+
+
+@pytest.mark.asyncio
+async def test_different_keys_do_not_wait_on_each_other():
+    cache = SingleflightCache(ttl=60, max_entries=10)
+    slow_release = asyncio.Event()
+
+    async def slow():
+        await slow_release.wait()
+        return "slow"
+
+    async def fast():
+        return "fast"
+
+    slow_get = asyncio.ensure_future(cache.get("slow", slow))
+    assert await asyncio.wait_for(cache.get("fast", fast), timeout=1) == "fast"
+    slow_release.set()
+    assert await slow_get == "slow"
+
+
+@pytest.mark.asyncio
+async def test_failures_are_not_cached():
+    cache = SingleflightCache(ttl=60, max_entries=10)
+    results = iter([None, "ok"])
+
+    async def loader():
+        return next(results)
+
+    async def broken():
+        raise RuntimeError("validator down")
+
+    with pytest.raises(RuntimeError):
+        await cache.get("e", broken)
+    assert await cache.get("k", loader) is None
+    assert await cache.get("k", loader) == "ok"
+
+
+@pytest.mark.asyncio
+async def test_cancelled_waiter_does_not_abort_load():
+    cache = SingleflightCache(ttl=60, max_entries=10)
+    release = asyncio.Event()
+
+    async def loader():
+        await release.wait()
+        return "value"
+
+    first = asyncio.ensure_future(cache.get("k", loader))
+    second = asyncio.ensure_future(cache.get("k", loader))
+    await asyncio.sleep(0)
+    first.cancel()
+    release.set()
+
+    assert await second == "value"
+    assert cache.peek("k") == "value"
+
+
+def test_bounds_and_ttl(monkeypatch):
+    now = [1000.0]
+    monkeypatch.setattr("sek8s.system_manager.cache.singleflight.time.monotonic", lambda: now[0])
+    cache = SingleflightCache(ttl=10, max_entries=3, max_bytes=100, weigh=len)
+
+    for key in "abc":
+        cache.put(key, "x" * 30)
+    assert cache.peek("a") is not None  # a is now most recently used
+    cache.put("d", "x" * 30)
+    assert cache.peek("b") is None
+    assert len(cache) == 3 and cache.size_bytes == 90
+
+    cache.put("e", "x" * 60)  # byte bound evicts the two least recently used
+    assert cache.peek("c") is None and cache.peek("a") is None
+    assert cache.size_bytes == 90
+
+    cache.put("huge", "x" * 200)  # larger than the whole cache: not stored
+    assert cache.peek("huge") is None
+
+    now[0] += 11
+    assert cache.peek("e") is None
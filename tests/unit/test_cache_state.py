@@ -0,0 +1,138 @@
+# tests/unit/test_cache_state.py
+"""
+Unit tests for persisted cache manager state and background startup reconciliation
+"""
+
+import asyncio
+
+import pytest
+from unittest.mock import patch
+
+from sek8s.config import cache_config
+from sek8s.system_manager.cache.manager import CacheManager, HuggingFaceSnapshot
+from sek8s.system_manager.cache.state import CACHE_STATE_FILE, EntryState, load_state, save_state
+
+
+def _chute_id(i):
+    return f"{i:08d}-0000-0000-0000-000000000000"
+
+
+def _make_chute_dir(cache_base, chute_id):
+    (cache_base / chute_id / "hub" / "models--org--model" / "blobs").mkdir(parents=True)
+
+
+def test_state_round_trip(tmp_path):
+    entries = [
+        EntryState(_chute_id(2), "org/b", "b" * 40, externally_managed=True, reconciled_at=123.0),
+        EntryState(_chute_id(1), "org/a", "a" * 40),
+    ]
+    save_state(tmp_path, entries)
+
+    loaded = load_state(tmp_path)
+    assert list(loaded) == [_chute_id(1), _chute_id(2)]
+    assert loaded[_chute_id(2)] == entries[0]
+
+
+def test_unreadable_state_is_ignored(tmp_path):
+    (tmp_path / CACHE_STATE_FILE).write_text("{not json", encoding="utf-8")
+    assert load_state(tmp_path) == {}
+
+
+@pytest.mark.asyncio
+async def test_initialize_restores_state_and_reconciles_in_background(tmp_path):
+    """initialize() returns before reconciliation; reconciles are bounded by the configured concurrency."""
+    chute_ids = [_chute_id(i) for i in range(6)]
+    for chute_id in chute_ids:
+        _make_chute_dir(tmp_path, chute_id)
+    save_state(tmp_path, [EntryState(chute_ids[0], "org/model", "c" * 40)])
+
+    release = asyncio.Event()
+    running = 0
+    peak = 0
+
+    async def fake_reconcile(self):
+        nonlocal running, peak
+        running += 1
+        peak = max(peak, running)
+        await release.wait()
+        running -= 1
+        self._mark_reconciled()
+
+    with patch.object(cache_config, "cache_base", str(tmp_path)), \
+            patch.object(cache_config, "eviction_enabled", False), \
+            patch.object(cache_config, "reconcile_concurrency", 2), \
+            patch.object(HuggingFaceSnapshot, "reconcile", fake_reconcile):
+        mgr = CacheManager()
+        await mgr.initialize()
+
+        restored = await mgr.get(chute_ids[0])
+        assert restored.repo_id == "org/model"
+        assert restored.revision == "c" * 40
+        assert len(await mgr.all()) == 6
+
+        await asyncio.sleep(0.05)
+        assert peak == 2
+
+        release.set()
+        await asyncio.gather(*mgr._background)
+        assert all(not c.needs_reconciliation for c in await mgr.all())
+        assert set(load_state(tmp_path)) == set(chute_ids)
+        await mgr.shutdown()
+
+
+@pytest.mark.asyncio
+async def test_reconcile_deadline_defers_entry(tmp_path):
+    """An entry that misses its deadline stays pending for the next sync."""
+    _make_chute_dir(tmp_path, _chute_id(0))
+
+    async def hung_reconcile(self):
+        await asyncio.sleep(3600)
+
+    with patch.object(cache_config, "cache_base", str(tmp_path)), \
+            patch.object(cache_config, "eviction_enabled", False), \
+            patch.object(cache_config, "reconcile_timeout", 0.05), \
+            patch.object(HuggingFaceSnapshot, "reconcile", hung_reconcile):
+        mgr = CacheManager()
+        await mgr.initialize()
+        await asyncio.gather(*mgr._background)
+
+        chute = await mgr.get(_chute_id(0))
+        assert chute.needs_reconciliation
+        await mgr.shutdown()
+
+
+@pytest.mark.asyncio
+async def test_start_download_waits_for_reconciliation(tmp_path):
+    """A download never starts writing into an entry that is still being verified."""
+    _make_chute_dir(tmp_path, _chute_id(0))
+    release = asyncio.Event()
+    order = []
+
+    async def slow_reconcile(self):
+        order.append("reconcile")
+        await release.wait()
+        order.append("reconciled")
+        self._mark_reconciled()
+
+    async def fake_start(self, repo_id, revision, **kwargs):
+        order.append("download")
+
+    with patch.object(cache_config, "cache_base", str(tmp_path)), \
+            patch.object(cache_config, "eviction_enabled", False), \
+            patch.object(cache_config, "space_reservation_enabled", False), \
+            patch.object(HuggingFaceSnapshot, "reconcile", slow_reconcile), \
+            patch.object(HuggingFaceSnapshot, "start_download", fake_start):
+        mgr = CacheManager()
+        await mgr.initialize()
+        await asyncio.sleep(0.01)
+
+        chute = await mgr.get(_chute_id(0))
+        download = asyncio.create_task(mgr.start_download(chute, "org/model", "a" * 40))
+        await asyncio.sleep(0.05)
+        assert order == ["reconcile"]
+
+        release.set()
+        await download
+        assert order == ["reconcile", "reconciled", "download"]
+        await asyncio.gather(*mgr._background)
+        await mgr.shutdown()
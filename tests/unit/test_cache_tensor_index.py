@@ -0,0 +1,69 @@
+# tests/unit/test_cache_tensor_index.py
+"""
+Unit tests for safetensors tensor index sidecars
+"""
+
+import json
+import struct
+
+import pytest
+
+from sek8s.system_manager.cache.tensor_index import TensorIndex, read_header
+
+
+def _safetensors(path, tensors, metadata=None):
+    """Write a minimal safetensors file; ``tensors`` maps name -> (dtype, shape, data)."""
+    header, data, offset = {}, b"", 0
+    for name, (dtype, shape, payload) in tensors.items():
+        header[name] = {"dtype": dtype, "shape": shape, "data_offsets": [offset, offset + len(payload)]}
+        data += payload
+        offset += len(payload)
+    if metadata:
+        header["__metadata__"] = metadata
+    raw = json.dumps(header).encode()
+    path.parent.mkdir(parents=True, exist_ok=True)
+    path.write_bytes(struct.pack("<Q", len(raw)) + raw + data)
+    return 8 + len(raw)
+
+
+def test_build_indexes_every_shard(tmp_path):
+    snapshot = tmp_path / "snapshot"
+    start = _safetensors(
+        snapshot / "model-00001-of-00002.safetensors",
+        {"embed.weight": ("BF16", [4, 2], b"\1" * 16), "layers.0.w": ("F32", [2], b"\2" * 8)},
+        metadata={"format": "pt"},
+    )
+    _safetensors(snapshot / "sub" / "model-00002-of-00002.safetensors", {"layers.1.w": ("F32", [2], b"\3" * 8)})
+    (snapshot / "config.json").write_text("{}")
+
+    index = TensorIndex.build(snapshot, "org/model", "a" * 40)
+
+    assert index.files == ["model-00001-of-00002.safetensors", "sub/model-00002-of-00002.safetensors"]
+    assert set(index.tensors) == {"embed.weight", "layers.0.w", "layers.1.w"}
+    entry = index.tensors["layers.0.w"]
+    assert (entry.file, entry.dtype, entry.shape, entry.offset, entry.size) == (0, "F32", [2], start + 16, 8)
+    with open(snapshot / index.files[entry.file], "rb") as f:
+        f.seek(entry.offset)
+        assert f.read(entry.size) == b"\2" * 8
+
+
+def test_round_trip_and_revision_check(tmp_path):
+    _safetensors(tmp_path / "snapshot" / "model.safetensors", {"w": ("I8", [3], b"abc")})
+    index = TensorIndex.build(tmp_path / "snapshot", "org/model", "rev1")
+    index.save(tmp_path)
+
+    reloaded = TensorIndex.load(tmp_path, "org/model", "rev1")
+    assert reloaded.files == index.files and reloaded.tensors == index.tensors
+    assert TensorIndex.load(tmp_path, "org/model", "rev2") is None
+
+
+def test_malformed_headers_are_rejected(tmp_path):
+    path = tmp_path / "bad.safetensors"
+    path.write_bytes(struct.pack("<Q", 1 << 40))
+    with pytest.raises(ValueError):
+        read_header(path)
+
+    raw = json.dumps({"w": {"dtype": "F32", "shape": [4], "data_offsets": [0, 16]}}).encode()
+    path.write_bytes(struct.pack("<Q", len(raw)) + raw + b"\0" * 8)  # data shorter than the header claims
+    with pytest.raises(ValueError):
+        read_header(path)
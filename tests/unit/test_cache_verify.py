@@ -0,0 +1,141 @@
+# tests/unit/test_cache_verify.py
+"""
+Unit tests for the cache content verification engine
+"""
+
+import hashlib
+import os
+
+import pytest
+from unittest.mock import AsyncMock, patch
+
+from sek8s.system_manager.cache.verify import (
+    HASH_GIT_BLOB,
+    ContentVerifier,
+    HashTask,
+    VerificationProgress,
+    hash_file,
+)
+
+
+def _write(path, size):
+    data = os.urandom(size)
+    path.write_bytes(data)
+    return data
+
+
+@pytest.mark.parametrize("size", [0, 1, 4095, 4096, 65536, 65537, 3 * 65536 + 17])
+def test_hash_file_sha256_matches_hashlib(tmp_path, size):
+    """Double-buffered reads produce the same digest as a plain sha256 across chunk boundaries."""
+    path = tmp_path / "blob"
+    data = _write(path, size)
+
+    assert hash_file(path, read_size=65536) == hashlib.sha256(data).hexdigest()
+
+
+def test_hash_file_git_blob_id(tmp_path):
+    """Non-LFS files are hashed as git blobs."""
+    path = tmp_path / "config.json"
+    data = _write(path, 1234)
+    expected = hashlib.sha1(b"blob 1234\0" + data).hexdigest()
+
+    assert hash_file(path, algorithm=HASH_GIT_BLOB, direct_io=False) == expected
+
+
+def test_content_verifier_reports_progress(tmp_path):
+    """All files are hashed and progress covers every byte."""
+    tasks = []
+    for i, size in enumerate([10, 70000, 200000]):
+        path = tmp_path / f"f{i}"
+        data = _write(path, size)
+        tasks.append(HashTask(f"f{i}", path, hashlib.sha256(data).hexdigest(), size))
+
+    progress = VerificationProgress()
+    results = ContentVerifier(workers=2, read_size=65536).verify(tasks, progress)
+
+    assert set(results) == {"f0", "f1", "f2"}
+    assert progress.files_done == 3
+    assert progress.bytes_done == progress.bytes_total == 270010
+    assert progress.percent_complete == 100.0
+    assert progress.finished_at is not None
+
+
+def test_content_verifier_detects_corruption(tmp_path):
+    """A single flipped byte is reported as a hash mismatch."""
+    path = tmp_path / "model.safetensors"
+    data = bytearray(_write(path, 100000))
+    expected = hashlib.sha256(data).hexdigest()
+    data[5000] ^= 0xFF
+    path.write_bytes(bytes(data))
+
+    with pytest.raises(ValueError, match="Hash mismatch: model.safetensors"):
+        ContentVerifier(workers=2).verify([HashTask("model.safetensors", path, expected, len(data))])
+
+
+def _make_snapshot(cache_dir, repo_id, revision, files):
+    """Lay out an HF hub snapshot (blobs + relative symlinks) and return the validator file list."""
+    repo_dir = cache_dir / "hub" / f"models--{repo_id.replace('/', '--')}"
+    blobs = repo_dir / "blobs"
+    snapshot = repo_dir / "snapshots" / revision
+    blobs.mkdir(parents=True)
+    snapshot.mkdir(parents=True)
+    remote = []
+    for name, size in files.items():
+        data = os.urandom(size)
+        sha = hashlib.sha256(data).hexdigest()
+        (blobs / sha).write_bytes(data)
+        (snapshot / name).symlink_to(f"../../blobs/{sha}")
+        remote.append({"path": name, "size": size, "is_lfs": True, "sha256": sha})
+    return remote
+
+
+@pytest.mark.asyncio
+async def test_verify_cache_rehashes_only_changed_files(tmp_path):
+    """The persisted manifest lets unchanged files skip hashing on the next run."""
+    from sek8s.system_manager.cache import util
+    from sek8s.system_manager.cache.manifest import VERIFY_MANIFEST_FILE
+
+    revision = "a" * 40
+    remote = _make_snapshot(tmp_path, "org/model", revision, {"a.safetensors": 5000, "b.safetensors": 7000})
+
+    with patch.object(util, "fetch_repo_info", AsyncMock(return_value={"files": remote})):
+        first = await util.verify_cache("org/model", revision, str(tmp_path), verify_content=True)
+        assert first["hashed"] == 2
+        assert (tmp_path / VERIFY_MANIFEST_FILE).exists()
+
+        second = await util.verify_cache("org/model", revision, str(tmp_path), verify_content=True)
+        assert second["hashed"] == 0
+        assert second["unchanged"] == 2
+
+        # Rewriting a blob in place changes its stat tuple, so only that file is re-hashed
+        blob = (tmp_path / "hub" / "models--org--model" / "snapshots" / revision / "a.safetensors").resolve()
+        blob.write_bytes(blob.read_bytes())
+        third = await util.verify_cache("org/model", revision, str(tmp_path), verify_content=True)
+        assert third["hashed"] == 1
+        assert third["unchanged"] == 1
+
+
+@pytest.mark.asyncio
+async def test_verify_cache_records_merkle_leaves_and_names_mismatch(tmp_path):
+    """Hashed files get Merkle leaves; a corrupted file is reported by path, others stay verified."""
+    from sek8s.system_manager.cache import util
+    from sek8s.system_manager.cache.merkle import MerkleManifest
+    from sek8s.system_manager.cache.verify import ContentMismatch
+
+    revision = "a" * 40
+    remote = _make_snapshot(tmp_path, "org/model", revision, {"a.safetensors": 5000, "b.safetensors": 300000})
+
+    with patch.object(util, "fetch_repo_info", AsyncMock(return_value={"files": remote})), \
+            patch.object(util.cache_config, "merkle_leaf_size_mb", 1):
+        await util.verify_cache("org/model", revision, str(tmp_path), verify_content=True)
+        merkle = MerkleManifest.load(tmp_path)
+        assert {e.num_leaves for e in merkle.entries.values()} == {1}
+
+        blob = (tmp_path / "hub" / "models--org--model" / "snapshots" / revision / "b.safetensors").resolve()
+        data = bytearray(blob.read_bytes())
+        data[1000] ^= 0xFF
+        blob.write_bytes(bytes(data))
+        with pytest.raises(ContentMismatch) as exc:
+            await util.verify_cache("org/model", revision, str(tmp_path), verify_content=True)
+        assert exc.value.rel_path == "b.safetensors"
+        assert merkle.get(remote[1]["sha256"]).damaged_leaves(blob) == [0]
@@ -0,0 +1,97 @@
+# tests/unit/test_system_status_collectors.py
+"""
+Unit tests for the independently refreshed overview sources
+"""
+
+import asyncio
+import time
+
+import pytest
+
+from sek8s.system_manager.status.collectors import Source, SourceCollector
+
+
+class _Fetch:
+    def __init__(self, values, delay=0.0):
+        self.values = list(values)
+        self.delay = delay
+        self.calls = 0
+
+    async def __call__(self):
+        self.calls += 1
+        await asyncio.sleep(self.delay)
+        value = self.values.pop(0) if len(self.values) > 1 else self.values[0]
+        if isinstance(value, Exception):
+            raise value
+        return value
+
+
+@pytest.mark.asyncio
+async def test_slow_source_does_not_block_the_others():
+    fast = Source("fast", _Fetch(["ok"]), interval=60)
+    slow = Source("slow", _Fetch(["late"], delay=5), interval=60)
+    collector = SourceCollector([fast, slow], max_wait=0.05)
+    try:
+        started = time.monotonic()
+        sources = await collector.read()
+        assert time.monotonic() - started < 1
+        assert sources["fast"].value == "ok"
+        assert sources["slow"].value is None
+
+        now = time.monotonic()
+        assert not fast.stale(now) and slow.stale(now)
+        info = slow.info(now)
+        assert info.refreshing and info.updated_at is None and info.age_seconds is None
+    finally:
+        await collector.stop()
+
+
+@pytest.mark.asyncio
+async def test_failed_refresh_keeps_last_value_and_marks_stale():
+    fetch = _Fetch(["v1", RuntimeError("nvidia-smi timed out"), "v2"])
+    source = Source("gpu", fetch, interval=60)
+
+    await source.refresh()
+    assert source.value == "v1" and not source.stale(time.monotonic())
+
+    await source.refresh()
+    assert source.value == "v1" and source.error == "nvidia-smi timed out"
+    assert source.stale(time.monotonic())
+
+    await source.refresh()
+    assert source.value == "v2" and source.error is None
+    assert not source.stale(time.monotonic())
+    assert source.stale(time.monotonic() + 121)  # two missed intervals
+
+
+@pytest.mark.asyncio
+async def test_sources_refresh_on_their_own_schedule():
+    fetch = _Fetch(["x"])
+    source = Source("unit", fetch, interval=60)
+    collector = SourceCollector([source], max_wait=1)
+    try:
+        await collector.read()
+        await collector.read()
+        assert fetch.calls == 1  # not due again yet
+
+        source.interval = 0
+        await collector.read()
+        await asyncio.sleep(0)
+        assert fetch.calls == 2
+    finally:
+        await collector.stop()
+
+
+@pytest.mark.asyncio
+async def test_peek_serves_live_in_memory_state():
+    live = {"value": None}
+    fetch = _Fetch(["from systemctl"])
+    source = Source("service:k3s", fetch, interval=60, peek=lambda: live["value"])
+    collector = SourceCollector([source], max_wait=1)
+    try:
+        assert (await collector.read())["service:k3s"].value == "from systemctl"
+        live["value"] = "from d-bus"
+        assert (await collector.read())["service:k3s"].value == "from d-bus"
+        assert fetch.calls == 1
+    finally:
+        await collector.stop()
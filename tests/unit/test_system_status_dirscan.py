@@ -0,0 +1,35 @@
+# tests/unit/test_system_status_dirscan.py
+"""
+Unit tests for the native directory scanner wrapper
+"""
+
+import pytest
+
+from sek8s.system_manager.status import dirscan
+from sek8s.system_manager.status.dirscan import ScanEntry, parse_records
+
+
+def test_parse_records_keeps_arbitrary_paths():
+    stdout = b"8192\t0\t/data\x0012288\t1\t/data/with\ttab\nand newline\x00garbage\x004096\t1\t/data/b\x00"
+    assert parse_records(stdout) == [
+        ScanEntry(path="/data", depth=0, size_bytes=8192),
+        ScanEntry(path="/data/with\ttab\nand newline", depth=1, size_bytes=12288),
+        ScanEntry(path="/data/b", depth=1, size_bytes=4096),
+    ]
+
+
+
+def test_stderr_counts():
+    stderr = b"errors=2\nhardlinks=5\n"
+    assert dirscan._parse_count(stderr, "errors") == 2
+    assert dirscan._parse_count(stderr, "hardlinks") == 5
+    assert dirscan._parse_count(b"errors=x\n", "errors") == 0
+
+
+@pytest.mark.asyncio
+async def test_missing_scanner_falls_back(monkeypatch, tmp_path):
+    monkeypatch.setattr(dirscan, "DIRSCAN_BINARY", str(tmp_path / "sek8s-dirscan"))
+    result = await dirscan.scan_directories(
+        tmp_path, 1, cross_filesystems=False, excludes=[], threads=2, timeout=5
+    )
+    assert result is None
@@ -0,0 +1,112 @@
+# tests/unit/test_system_status_disk_usage.py
+"""
+Unit tests for the in-memory disk usage model
+"""
+
+import os
+from pathlib import Path
+
+import pytest
+
+from sek8s.config import SystemStatusConfig
+from sek8s.system_manager.status import disk_usage as disk_usage_module
+from sek8s.system_manager.status import util as util_module
+from sek8s.system_manager.status.disk_usage import DiskUsageModel, DiskUsageTree
+
+
+def _tree():
+    entries = [
+        (600, "/data/a", 1),
+        (400, "/data/a/x", 2),
+        (100, "/data/a/y", 2),
+        (300, "/data/b", 1),
+    ]
+    return DiskUsageTree.from_scan("/data", False, 2, entries, 1000, False)
+
+
+def test_replace_subtree_adjusts_ancestors():
+    tree = _tree()
+    tree.replace_subtree("/data/a/x", [], 50, False)
+    assert tree.sizes["/data/a/x"] == (50, 2)
+    assert tree.sizes["/data/a"] == (250, 1)
+    assert tree.root_size == 650
+
+    tree.replace_subtree("/data/b", [(700, "/data/b/new", 1)], 900, False)
+    assert tree.sizes["/data/b/new"] == (700, 2)
+    assert tree.root_size == 1250
+    assert sorted(e[1] for e in tree.entries(1)) == ["/data/a", "/data/b"]
+
+
+def test_settled_dirty_collapses_nested_changes():
+    tree = _tree()
+    for directory in ("/data/a/x", "/data/a", "/data/b", "/elsewhere"):
+        tree.mark_dirty(directory)
+    newest = max(tree.dirty.values())
+    assert tree.settled_dirty(newest + 1) == []
+    assert tree.settled_dirty(newest + 60) == ["/data/a", "/data/b"]
+    assert tree.dirty == {}
+
+
+class _FakeScanner:
+    def __init__(self, hardlinked=()):
+        self.calls = []
+        self.hardlinked = set(hardlinked)
+
+    async def __call__(self, path, config, max_depth, cross_filesystems):
+        self.calls.append((str(path), max_depth))
+        entries = [(10 * depth, f"{path}/d{depth}", depth) for depth in range(1, max_depth + 1)]
+        return entries, 100, False, str(path) in self.hardlinked
+
+
+@pytest.mark.asyncio
+async def test_repeated_requests_are_served_from_memory(monkeypatch):
+    scanner = _FakeScanner()
+    monkeypatch.setattr(disk_usage_module, "scan_directory_sizes", scanner)
+    model = DiskUsageModel(SystemStatusConfig())
+
+    first = await model.get(Path("/data"), 1, False)
+    again = await model.get(Path("/data"), 1, False)
+    assert again is first
+    assert scanner.calls == [("/data", 1)]
+
+    # A deeper request rescans once; shallower ones reuse the deeper tree
+    deep = await model.get(Path("/data"), 3, False)
+    assert deep.max_depth == 3 and [e[2] for e in sorted(deep.entries(2))] == [1, 2]
+    assert await model.get(Path("/data"), 2, False) is deep
+    assert scanner.calls == [("/data", 1), ("/data", 3)]
+
+    # Other filesystem-crossing settings are separate trees
+    await model.get(Path("/data"), 1, True)
+    assert len(scanner.calls) == 3
+
+
+
+@pytest.mark.asyncio
+async def test_hardlinked_subtree_is_rescanned_from_the_root(monkeypatch):
+    """A subtree scan counts hard links once within the subtree only, so it is not swapped in."""
+    scanner = _FakeScanner(hardlinked={"/data/d1"})
+    monkeypatch.setattr(disk_usage_module, "scan_directory_sizes", scanner)
+    model = DiskUsageModel(SystemStatusConfig())
+    tree = await model.get(Path("/data"), 2, False)
+    monkeypatch.setattr(disk_usage_module.os.path, "isdir", lambda path: True)
+
+    assert not await model._rescan_subtree(tree, "/data/d1")
+    assert tree.sizes["/data/d1"] == (10, 1) and tree.root_size == 100  # untouched
+    assert await model._rescan_subtree(tree, "/data/d2")
+    assert tree.root_size == 180
+    assert scanner.calls == [("/data", 2), ("/data/d1", 1), ("/data/d2", 0)]
+
+
+def test_filesystems_come_from_statvfs(tmp_path, monkeypatch):
+    mounts = tmp_path / "mounts"
+    mounts.write_text(f"/dev/root / ext4 rw 0 0\nproc /proc proc rw 0 0\n/dev/x {tmp_path} ext4 rw 0 0\n")
+    monkeypatch.setattr(util_module, "_MOUNTS_FILE", str(mounts))
+
+    (info,) = util_module._collect_filesystems(str(tmp_path / "sub"))
+    assert (info.source, info.target) == ("/dev/x", str(tmp_path))
+    st = os.statvfs(tmp_path)
+    assert info.total_bytes == st.f_blocks * st.f_frsize
+    assert 0 <= info.used_percent <= 100
+
+    targets = [fs.target for fs in util_module._collect_filesystems("/")]
+    assert "/proc" not in targets  # pseudo filesystem (no blocks)
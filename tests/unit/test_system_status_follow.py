@@ -0,0 +1,151 @@
+# tests/unit/test_system_status_follow.py
+"""
+Unit tests for the shared journal followers behind the log streams
+"""
+
+import asyncio
+import threading
+
+import pytest
+
+from sek8s.system_manager.status.follow import JournalFollowerHub
+from sek8s.system_manager.status.journal import JournalEntry
+
+
+class _FakeJournalFiles:
+    """Shared entry list; every open() is an independent read position (like sd_journal_open)."""
+
+    def __init__(self, count=0):
+        self.records = []
+        self.changed = threading.Condition()
+        self.opened = 0
+        for _ in range(count):
+            self.append()
+
+    def append(self, message=None):
+        with self.changed:
+            i = len(self.records)
+            self.records.append(JournalEntry(f"c{i}", i * 1_000_000, 6, "k3s", 7, message or f"line {i}"))
+            self.changed.notify_all()
+
+    def open(self):
+        self.opened += 1
+        return _FakeReader(self)
+
+
+class _FakeReader:
+    """After seek_cursor the first next/previous returns the sought entry itself (like sd-journal)."""
+
+    def __init__(self, files):
+        self.files = files
+        self.pos = -1
+        self.pending = None
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        pass
+
+    def match_unit(self, unit, priority=None):
+        pass
+
+    def seek_tail(self):
+        self.pos = len(self.files.records)
+
+    def seek_cursor(self, cursor):
+        self.pos, self.pending = None, int(cursor[1:])
+
+    def test_cursor(self, cursor):
+        return self.files.records[self.pos].cursor == cursor
+
+    def previous(self):
+        self.pos = self.pending if self.pos is None else self.pos - 1
+        return self.pos >= 0
+
+    def next(self):
+        target = self.pending if self.pos is None else self.pos + 1
+        if target >= len(self.files.records):
+            return False
+        self.pos = target
+        return True
+
+    def wait(self, timeout_usec):
+        with self.files.changed:
+            if self.pos + 1 >= len(self.files.records):
+                self.files.changed.wait(timeout_usec / 1e6)
+
+    def cursor(self):
+        return self.files.records[self.pos].cursor
+
+    def realtime_usec(self):
+        return self.files.records[self.pos].realtime_usec
+
+    def entry(self):
+        return self.files.records[self.pos]
+
+
+async def _next(stream):
+    return await asyncio.wait_for(stream.__anext__(), 2)
+
+
+@pytest.mark.asyncio
+async def test_subscribers_share_one_follower():
+    files = _FakeJournalFiles(count=5)
+    hub = JournalFollowerHub(buffer_lines=100, open_journal=files.open, hostname="node")
+    first = hub.subscribe("k3s.service", backlog_lines=2)
+    second = hub.subscribe("k3s.service", backlog_lines=1)
+
+    assert (await _next(first)).endswith(" node k3s[7]: line 3\n")
+    assert (await _next(first)).endswith(": line 4\n")
+    assert (await _next(second)).endswith(": line 4\n")
+    assert hub.follower_count == 1 and hub.subscriber_count("k3s.service") == 2
+
+    files.append("fresh")
+    assert (await _next(first)).endswith(": fresh\n")
+    assert (await _next(second)).endswith(": fresh\n")
+    assert files.opened == 3  # one follower + one backlog read per subscriber
+
+    await first.aclose()
+    assert hub.follower_count == 1
+    await second.aclose()
+    assert hub.follower_count == 0  # stops with the last subscriber
+
+
+@pytest.mark.asyncio
+async def test_slow_subscriber_is_dropped_with_marker():
+    files = _FakeJournalFiles()
+    hub = JournalFollowerHub(buffer_lines=3, open_journal=files.open, hostname="node")
+    slow = hub.subscribe("k3s.service", backlog_lines=0)
+    fast = hub.subscribe("k3s.service", backlog_lines=0)
+    pending_slow = asyncio.ensure_future(slow.__anext__())
+    pending_fast = asyncio.ensure_future(fast.__anext__())
+    await asyncio.sleep(0.05)
+
+    files.append("a")
+    assert (await asyncio.wait_for(pending_slow, 2)).endswith(": a\n")
+    assert (await asyncio.wait_for(pending_fast, 2)).endswith(": a\n")
+    for i in range(5):
+        files.append(f"b{i}")
+        assert (await _next(fast)).endswith(f": b{i}\n")
+
+    assert "stream dropped" in await _next(slow)
+    with pytest.raises(StopAsyncIteration):
+        await _next(slow)
+    assert hub.subscriber_count("k3s.service") == 1
+
+    await fast.aclose()
+    assert hub.follower_count == 0
+
+
+@pytest.mark.asyncio
+async def test_since_backlog_pages_through_the_whole_window():
+    files = _FakeJournalFiles(count=12)
+    hub = JournalFollowerHub(buffer_lines=100, open_journal=files.open, hostname="node")
+    stream = hub.subscribe("k3s.service", backlog_lines=3, since_usec=2_000_000)
+
+    for i in range(2, 12):
+        assert (await _next(stream)).endswith(f": line {i}\n")
+    files.append("fresh")
+    assert (await _next(stream)).endswith(": fresh\n")
+    await stream.aclose()
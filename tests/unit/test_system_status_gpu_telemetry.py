@@ -0,0 +1,139 @@
+# tests/unit/test_system_status_gpu_telemetry.py
+"""
+Unit tests for the NVML GPU telemetry sampler and its ring buffers
+"""
+
+import asyncio
+import types
+
+import pytest
+
+from sek8s.system_manager.status import gpu_telemetry as telemetry_module
+from sek8s.system_manager.status.gpu_telemetry import METRICS, GpuTelemetry, Ring
+
+
+class _NVMLError(Exception):
+    pass
+
+
+class _NotSupported(_NVMLError):
+    pass
+
+
+class _Timeout(_NVMLError):
+    pass
+
+
+def _fake_nvml(gpus=1):
+    """The subset of pynvml the sampler uses; GPU 0 has ECC, the others do not."""
+    state = {"power": 250_000, "xids": []}
+
+    def ecc(handle, error_type, counter):
+        if handle != 0:
+            raise _NotSupported()
+        return 3 if error_type == "corrected" else 0
+
+    def wait(event_set, timeout_ms):
+        if state["xids"]:
+            handle, xid = state["xids"].pop(0)
+            return types.SimpleNamespace(device=handle, eventData=xid)
+        raise _Timeout()
+
+    return state, types.SimpleNamespace(
+        NVMLError=_NVMLError,
+        NVMLError_NotSupported=_NotSupported,
+        NVMLError_Timeout=_Timeout,
+        NVML_CLOCK_GRAPHICS="graphics",
+        NVML_CLOCK_SM="sm",
+        NVML_CLOCK_MEM="mem",
+        NVML_TEMPERATURE_GPU="gpu",
+        NVML_MEMORY_ERROR_TYPE_CORRECTED="corrected",
+        NVML_MEMORY_ERROR_TYPE_UNCORRECTED="uncorrected",
+        NVML_VOLATILE_ECC="volatile",
+        nvmlEventTypeXidCriticalError=8,
+        nvmlInit=lambda: None,
+        nvmlShutdown=lambda: None,
+        nvmlDeviceGetCount=lambda: gpus,
+        nvmlDeviceGetHandleByIndex=lambda i: i,
+        nvmlDeviceGetUUID=lambda h: f"GPU-000{h}",
+        nvmlDeviceGetName=lambda h: "NVIDIA H200",
+        nvmlDeviceGetUtilizationRates=lambda h: types.SimpleNamespace(gpu=80, memory=40),
+        nvmlDeviceGetMemoryInfo=lambda h: types.SimpleNamespace(used=1 << 30, total=1 << 34),
+        nvmlDeviceGetPowerUsage=lambda h: state["power"],
+        nvmlDeviceGetEnforcedPowerLimit=lambda h: 700_000,
+        nvmlDeviceGetClockInfo=lambda h, clock: {"graphics": 1980, "sm": 1980, "mem": 2619}[clock],
+        nvmlDeviceGetTemperature=lambda h, sensor: 55,
+        nvmlDeviceGetTotalEccErrors=ecc,
+        nvmlEventSetCreate=lambda: "events",
+        nvmlDeviceRegisterEvents=lambda h, mask, event_set: None,
+        nvmlEventSetWait_v2=wait,
+        nvmlEventSetFree=lambda event_set: None,
+    )
+
+
+def test_ring_keeps_newest_points_and_answers_ranges():
+    ring = Ring(4)
+    for t in range(10):
+        ring.append((float(t), (t,)))
+    assert len(ring) == 4 and ring.oldest() == 6.0
+    assert [p[0] for p in ring.range(7, 8)] == [7.0, 8.0]
+    assert [p[0] for p in ring.range(0, 100)] == [6.0, 7.0, 8.0, 9.0]
+    assert ring.range(20, 30) == [] and ring.latest() == (9.0, (9,))
+
+
+def test_samples_are_downsampled_into_tiers():
+    state, nvml = _fake_nvml()
+    telemetry = GpuTelemetry(interval=1.0, nvml=nvml)
+    telemetry._init()
+    (series,) = telemetry.gpus
+    power = METRICS.index("power_watts")
+
+    for t in range(120, 240):  # two full minutes, then one sample into the third
+        state["power"] = 200_000 if t < 180 else 300_000
+        timestamp, values = telemetry._sample(series, 0)
+        series.add((float(t), values))
+    series.add((240.0, values))
+
+    assert series.latest()[1][power] == 300.0
+    assert [(t, v[power]) for t, v in series.rings["1m"].range(0, 1000)] == [(120.0, 200.0), (180.0, 300.0)]
+    assert series.rings["15m"].range(0, 1000) == []  # bucket still open
+    assert len(series.rings["raw"]) == 121
+
+
+@pytest.mark.asyncio
+async def test_sampler_runs_and_records_xids(monkeypatch):
+    monkeypatch.setattr(telemetry_module, "_XID_WAIT_MS", 10)
+    state, nvml = _fake_nvml(gpus=2)
+    state["xids"].append((1, 79))
+    telemetry = GpuTelemetry(interval=0.01, nvml=nvml)
+    await telemetry.start()
+    try:
+        for _ in range(100):
+            if len(telemetry.gpus[1].rings["raw"]) >= 3 and telemetry.gpus[1].xid_events:
+                break
+            await asyncio.sleep(0.01)
+        assert telemetry.available
+        assert [e.xid for e in telemetry.gpus[1].xid_events] == [79]
+        assert telemetry.gpu("1") is telemetry.gpu("0001") is telemetry.gpus[1]
+
+        gpu0, gpu1 = (dict(zip(METRICS, s.latest()[1])) for s in telemetry.gpus)
+        assert gpu0["ecc_corrected_total"] == 3.0 and gpu0["temperature_gpu_c"] == 55.0
+        assert gpu1["ecc_corrected_total"] is None
+        assert "ecc_corrected_total" in telemetry.gpus[1].unsupported
+    finally:
+        await telemetry.stop()
+    assert not telemetry.available
+
+
+@pytest.mark.asyncio
+async def test_missing_driver_leaves_telemetry_unavailable():
+    _, nvml = _fake_nvml()
+
+    def fail():
+        raise _NVMLError("Driver Not Loaded")
+
+    nvml.nvmlInit = fail
+    telemetry = GpuTelemetry(nvml=nvml)
+    await telemetry.start()
+    assert not telemetry.available and "Driver Not Loaded" in telemetry.error
+    await telemetry.stop()
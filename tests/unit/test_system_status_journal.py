@@ -0,0 +1,150 @@
+# tests/unit/test_system_status_journal.py
+"""
+Unit tests for the sd-journal page reader
+"""
+
+import re
+import time
+
+import pytest
+
+from sek8s.system_manager.status import journal as journal_module
+from sek8s.system_manager.status.journal import (
+    MAX_PATTERN_LENGTH,
+    JournalEntry,
+    compile_pattern,
+    read_page,
+)
+
+
+class _FakeJournal:
+    """In-memory stand-in for Journal with sd_journal seek semantics.
+
+    After seek_cursor the first next/previous returns the sought entry itself.
+    """
+
+    def __init__(self, messages):
+        self.records = [
+            JournalEntry(cursor=f"c{i}", realtime_usec=i * 1_000_000, priority=6, identifier="k3s", pid=10, message=m)
+            for i, m in enumerate(messages)
+        ]
+        self.pos = None
+        self.matched = None
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        pass
+
+    def match_unit(self, unit, priority=None):
+        self.matched = (unit, priority)
+
+    def seek_head(self):
+        self.pos = -1
+
+    def seek_tail(self):
+        self.pos = len(self.records)
+
+    def seek_cursor(self, cursor):
+        self.pending = int(cursor[1:])
+        self.pos = None
+
+    def test_cursor(self, cursor):
+        return self.records[self.pos].cursor == cursor
+
+    def next(self):
+        if self.pos is None:
+            self.pos = self.pending
+        else:
+            self.pos += 1
+        return self.pos < len(self.records)
+
+    def previous(self):
+        if self.pos is None:
+            self.pos = self.pending
+        else:
+            self.pos -= 1
+        return self.pos >= 0
+
+    def get(self, field):
+        assert field == "MESSAGE"
+        return self.records[self.pos].message
+
+    def cursor(self):
+        return self.records[self.pos].cursor
+
+    def realtime_usec(self):
+        return self.records[self.pos].realtime_usec
+
+    def entry(self):
+        return self.records[self.pos]
+
+
+def _read(journal, limit, **kwargs):
+    page = read_page("k3s.service", limit, open_journal=lambda: journal, **kwargs)
+    return page, [e.message for e in page.entries]
+
+
+def test_pages_backward_then_polls_forward():
+    journal = _FakeJournal([f"line {i}" for i in range(10)])
+
+    page, messages = _read(journal, 4, priority=3)
+    assert journal.matched == ("k3s.service", 3)
+    assert messages == ["line 6", "line 7", "line 8", "line 9"]
+    assert (page.before_cursor, page.after_cursor, page.has_more) == ("c6", "c9", True)
+
+    page, messages = _read(journal, 4, before=page.before_cursor)
+    assert messages == ["line 2", "line 3", "line 4", "line 5"]
+
+    page, messages = _read(journal, 4, before=page.before_cursor)
+    assert messages == ["line 0", "line 1"] and not page.has_more
+
+    journal.records.append(JournalEntry("c10", 10_000_000, 6, "k3s", 10, "line 10"))
+    page, messages = _read(journal, 4, after="c8")
+    assert messages == ["line 9", "line 10"]
+    assert page.after_cursor == "c10" and not page.has_more
+
+
+def test_filters_apply_while_reading():
+    journal = _FakeJournal(["ok", "error: disk", "ok", "error: net", "ok"])
+
+    page, messages = _read(journal, 10, pattern=compile_pattern(r"^error"))
+    assert messages == ["error: disk", "error: net"]
+    assert page.scanned == 5
+
+    page, messages = _read(journal, 10, since_usec=2_000_000)
+    assert messages == ["ok", "error: net", "ok"]
+    assert not page.has_more and page.scanned == 4  # stops at the first older entry
+
+
+def test_pattern_pages_do_not_skip_matches_left_in_a_batch(monkeypatch):
+    monkeypatch.setattr(journal_module, "_MATCH_BATCH", 3)
+    journal = _FakeJournal([f"{'error' if i % 2 else 'ok'} {i}" for i in range(12)])
+    pattern = compile_pattern(r"^error")
+
+    page, messages = _read(journal, 2, pattern=pattern)
+    assert messages == ["error 9", "error 11"] and page.has_more
+    page, messages = _read(journal, 2, pattern=pattern, before=page.before_cursor)
+    assert messages == ["error 5", "error 7"]
+    page, messages = _read(journal, 3, pattern=pattern, before=page.before_cursor)
+    assert messages == ["error 1", "error 3"] and not page.has_more
+
+
+def test_compile_pattern_rejects_bad_input():
+    assert compile_pattern(None) is None and compile_pattern("") is None
+    assert isinstance(compile_pattern("a+b"), re.Pattern)
+    with pytest.raises(ValueError):
+        compile_pattern("(unclosed")
+    with pytest.raises(ValueError):
+        compile_pattern("a" * (MAX_PATTERN_LENGTH + 1))
+
+
+def test_pattern_over_the_match_budget_is_rejected(monkeypatch):
+    monkeypatch.setattr(journal_module, "MATCH_BUDGET_SECONDS", 0.5)
+    journal = _FakeJournal(["a" * 40 + "!"])
+
+    started = time.monotonic()
+    with pytest.raises(ValueError, match="match budget"):
+        _read(journal, 10, pattern=compile_pattern(r"^(a+)+$"))
+    assert time.monotonic() - started < 5
@@ -0,0 +1,143 @@
+# tests/unit/test_system_status_units.py
+"""
+Unit tests for the D-Bus client and the systemd unit state tracker
+"""
+
+import asyncio
+
+import pytest
+
+from sek8s.system_manager.status.dbus import (
+    METHOD_RETURN,
+    SIGNAL,
+    Message,
+    read_message,
+    split_signature,
+)
+from sek8s.system_manager.status.models import ServiceDefinition
+from sek8s.system_manager.status.units import (
+    PROPERTIES_INTERFACE,
+    SERVICE_INTERFACE,
+    UNIT_INTERFACE,
+    UnitStateTracker,
+)
+
+UNIT_PATH = "/org/freedesktop/systemd1/unit/k3s_2eservice"
+
+
+@pytest.mark.asyncio
+async def test_signature_split_and_round_trip():
+    assert split_signature("sa{sv}as(ib)y") == ["s", "a{sv}", "as", "(ib)", "y"]
+
+    message = Message(
+        type=SIGNAL,
+        serial=7,
+        path=UNIT_PATH,
+        interface=PROPERTIES_INTERFACE,
+        member="PropertiesChanged",
+        signature="sa{sv}as",
+        body=[
+            UNIT_INTERFACE,
+            {"ActiveState": ("s", "active"), "MainPID": ("u", 42), "Exec": ("a(sx)", [("a", -1), ("bc", 2**40)])},
+            ["UnitFileState"],
+        ],
+    )
+    reader = asyncio.StreamReader()
+    reader.feed_data(message.encode())
+    reader.feed_eof()
+    decoded = await read_message(reader)
+    assert decoded.path == UNIT_PATH and decoded.member == "PropertiesChanged"
+    assert decoded.body == [
+        UNIT_INTERFACE,
+        {"ActiveState": "active", "MainPID": 42, "Exec": [("a", -1), ("bc", 2**40)]},
+        ["UnitFileState"],
+    ]
+
+
+class _FakeSystemd:
+    """Just enough of dbus-daemon + systemd on one socket for the tracker."""
+
+    def __init__(self):
+        self.props = {
+            UNIT_INTERFACE: {
+                "Id": ("s", "k3s.service"),
+                "LoadState": ("s", "loaded"),
+                "ActiveState": ("s", "active"),
+                "SubState": ("s", "running"),
+                "UnitFileState": ("s", "enabled"),
+                "Names": ("as", ["k3s.service"]),
+            },
+            SERVICE_INTERFACE: {"MainPID": ("u", 1234), "ExecMainStatus": ("i", 0), "ExecMainCode": ("i", 0)},
+        }
+        self.calls = []
+        self.writer = None
+        self.loaded = asyncio.Event()
+
+    async def handle(self, reader, writer):
+        self.writer = writer
+        await reader.readexactly(1)
+        await reader.readline()  # AUTH EXTERNAL
+        writer.write(b"OK 0123456789abcdef0123456789abcdef\r\n")
+        await reader.readline()  # BEGIN
+        serial = 100
+        while True:
+            try:
+                call = await read_message(reader)
+            except asyncio.IncompleteReadError:
+                return
+            self.calls.append(call.member)
+            signature, body = {
+                "Hello": ("s", [":1.5"]),
+                "LoadUnit": ("o", [UNIT_PATH]),
+                "GetAll": ("a{sv}", [self.props.get(call.body[0] if call.body else "", {})]),
+            }.get(call.member, ("", []))
+            serial += 1
+            reply = Message(
+                type=METHOD_RETURN, serial=serial, reply_serial=call.serial, signature=signature, body=body
+            )
+            writer.write(reply.encode())
+            if call.member == "GetAll" and call.body == [SERVICE_INTERFACE]:
+                self.loaded.set()
+
+    def emit(self, changed, invalidated=()):
+        self.writer.write(
+            Message(
+                type=SIGNAL, serial=999, path=UNIT_PATH, interface=PROPERTIES_INTERFACE,
+                member="PropertiesChanged", sender=":1.1", signature="sa{sv}as",
+                body=[UNIT_INTERFACE, changed, list(invalidated)],
+            ).encode()
+        )
+
+
+@pytest.mark.asyncio
+async def test_tracker_follows_property_changes(tmp_path):
+    fake = _FakeSystemd()
+    socket_path = str(tmp_path / "bus")
+    server = await asyncio.start_unix_server(fake.handle, path=socket_path)
+    tracker = UnitStateTracker([ServiceDefinition("k3s", "k3s.service", "k3s")], address=f"unix:path={socket_path}")
+    assert tracker.status("k3s.service") is None  # not connected: callers use systemctl
+
+    await tracker.start()
+    try:
+        await asyncio.wait_for(fake.loaded.wait(), 5)
+        for _ in range(50):
+            if tracker.connected:
+                break
+            await asyncio.sleep(0.01)
+        status = tracker.status("k3s.service")
+        assert (status.active_state, status.sub_state, status.main_pid, status.unit_file_state) == (
+            "active", "running", "1234", "enabled"
+        )
+        assert "Subscribe" in fake.calls
+
+        fake.emit({"ActiveState": ("s", "failed"), "SubState": ("s", "failed")})
+        for _ in range(50):
+            if tracker.status("k3s.service").active_state == "failed":
+                break
+            await asyncio.sleep(0.01)
+        assert tracker.status("k3s.service").sub_state == "failed"
+        assert tracker.status("other.service") is None
+    finally:
+        await tracker.stop()
+        server.close()
+        await server.wait_closed()
@@ -4,15 +4,16 @@ Unit tests for individual validators
 """
 
 import asyncio
+import json
 import pytest
 from unittest.mock import Mock, AsyncMock, patch
 import aiohttp
 
-from sek8s.validators.base import ValidationResult
-from sek8s.validators.cosign import CosignValidator
+from sek8s.validators.base import AdmissionContext, ValidationResult, raw_member
+from sek8s.validators.cosign import CosignValidator, ImageDigestCache
 from sek8s.validators.registry import RegistryValidator
 from sek8s.validators.opa import OPAValidator
-from sek8s.config import AdmissionConfig, CosignConfig, NamespacePolicy
+from sek8s.config import AdmissionConfig, CosignConfig, CosignVerificationConfig, NamespacePolicy
 
 
 @pytest.fixture
@@ -321,6 +322,63 @@ class TestValidationResult:
         assert "Denied" in combined.messages
         assert "Warning" in combined.warnings
 
+class TestAdmissionContext:
+    """Tests for the shared per-request AdmissionContext."""
+
+    def test_from_bytes_extracts_request_fields(self, config, deployment_review):
+        """Kind, namespace, images and parsed references are extracted once."""
+        raw = json.dumps(deployment_review).encode()
+        ctx = AdmissionContext.from_bytes(raw, config)
+
+        assert ctx.kind == "Deployment"
+        assert ctx.is_pod_kind is True
+        assert ctx.namespace == deployment_review["request"].get("namespace", "default")
+        assert ctx.images
+        assert set(ctx.references) == set(ctx.images)
+        assert ctx.enforcement_mode == "enforce"
+        assert ctx.raw == raw
+
+    def test_from_bytes_missing_request(self, config):
+        """Bodies without a request object are rejected."""
+        with pytest.raises(ValueError, match="missing request"):
+            AdmissionContext.from_bytes(b'{"kind": "AdmissionReview"}', config)
+
+    def test_opa_payload_passes_raw_request_through(self, config, valid_admission_review):
+        """OPA payload embeds the original request plus the extra input keys."""
+        raw = json.dumps(valid_admission_review, indent=2).encode() + b"\n"
+        ctx = AdmissionContext.from_bytes(raw, config)
+
+        payload = ctx.opa_payload({"allowed_registries": ["docker.io"], "namespace_policy": "warn"})
+
+        assert ctx.raw_request in payload
+        assert json.loads(payload) == {
+            "input": {
+                "request": valid_admission_review["request"],
+                "allowed_registries": ["docker.io"],
+                "namespace_policy": "warn",
+            }
+        }
+
+    def test_raw_member_finds_top_level_key(self):
+        """Only the top-level member is returned, byte for byte."""
+        raw = b'{"kind": "x", "nested": {"request": 1}, "request" : {"a": "}\\"", "b": [1, {}]} }'
+
+        assert raw_member(raw, "request") == b'{"a": "}\\"", "b": [1, {}]}'
+        assert raw_member(raw, "kind") == b'"x"'
+        assert raw_member(raw, "missing") is None
+        assert raw_member(b"[]", "request") is None
+
+    def test_opa_payload_without_raw(self, config, valid_admission_review):
+        """Contexts built from dicts serialize the request for OPA."""
+        ctx = AdmissionContext.from_review(valid_admission_review, config)
+
+        payload = json.loads(ctx.opa_payload({"namespace_policy": "enforce"}))
+
+        assert payload == {
+            "input": {"request": valid_admission_review["request"], "namespace_policy": "enforce"}
+        }
+
+
 class TestCosignValidator:
     """Tests for CosignValidator."""
 
@@ -425,4 +483,49 @@ class TestCosignValidator:
             review2["request"]["object"]["metadata"]["uid"] = "different-pod-uid"
             result2 = await validator.validate(review2)
         assert result1.allowed == result2.allowed
-        assert call_count == 1, "New pod with same images should hit admission cache, not run verification"
\ No newline at end of file
+        assert call_count == 1, "New pod with same images should hit admission cache, not run verification"
+
+
+class TestImageDigestCache:
+    """Tests for the verified tag -> digest cache used for digest pinning."""
+
+    def test_pin_replaces_tag(self):
+        digest = "sha256:" + "b" * 64
+        assert ImageDigestCache.pin("gcr.io/org/app:v1", digest) == f"gcr.io/org/app@{digest}"
+        assert ImageDigestCache.pin("localhost:5000/app", digest) == f"localhost:5000/app@{digest}"
+
+    def test_record_ignores_digest_images_and_bad_digests(self):
+        cache = ImageDigestCache(maxsize=8, ttl=60)
+        cache.record("app@sha256:abc", "sha256:abc")
+        cache.record("app:v1", "md5:abc")
+        cache.record("app:v2", None)
+        assert len(cache) == 0
+
+        cache.record("app:v1", "sha256:abc")
+        assert cache.get("app:v1") == "app@sha256:abc"
+
+    def test_manifest_digest_from_cosign_output(self):
+        output = [{"critical": {"image": {"docker-manifest-digest": "sha256:abc"}}}]
+        assert CosignValidator._manifest_digest(output) == "sha256:abc"
+        assert CosignValidator._manifest_digest([{}]) is None
+
+    @pytest.mark.asyncio
+    async def test_validator_resolves_tag_even_when_pinned(self, config):
+        """A cached pin never stands in for resolving the tag; a moved tag is verified anew."""
+        validator = CosignValidator(config)
+        verification = CosignVerificationConfig(verification_method="key")
+        old, new = "sha256:" + "a" * 64, "sha256:" + "b" * 64
+        validator.digest_cache.record("app:v1", old)
+        verified = []
+
+        async def verify(image, _config):
+            verified.append(image)
+            return True
+
+        with patch.object(validator, "_resolve_image_reference", return_value=f"app@{new}") as resolve, \
+                patch.object(validator, "_verify_with_key", side_effect=verify):
+            assert await validator._verify_image_signature("app:v1", verification)
+
+        resolve.assert_awaited_once_with("app:v1")
+        assert verified == [f"app@{new}"]
+        assert validator.digest_cache.get("app:v1") == f"app@{new}"
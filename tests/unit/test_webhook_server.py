@@ -3,6 +3,7 @@
 Unit tests for Admission Webhook Server
 """
 
+import base64
 import json
 import pytest
 from fastapi.testclient import TestClient
@@ -210,3 +211,32 @@ def test_mutate_endpoint_placeholder(client):
     data = resp.json()
     assert data["response"]["allowed"] is True
     assert data["response"]["uid"] == "test-mutate"
+
+
+def test_mutate_endpoint_pins_verified_digest(client, webhook_server):
+    """Test /mutate rewrites tag-based pod images whose digest was verified."""
+    digest = "sha256:" + "a" * 64
+    webhook_server.controller.digest_cache.record("nginx:latest", digest)
+    admission_review = {
+        "apiVersion": "admission.k8s.io/v1",
+        "kind": "AdmissionReview",
+        "request": {
+            "uid": "test-pin",
+            "operation": "CREATE",
+            "namespace": "default",
+            "kind": {"kind": "Pod"},
+            "object": {
+                "kind": "Pod",
+                "spec": {"containers": [{"name": "a", "image": "nginx:latest"}, {"name": "b", "image": "busybox:1"}]},
+            },
+        },
+    }
+
+    resp = client.post("/mutate", json=admission_review)
+
+    assert resp.status_code == 200
+    data = resp.json()
+    assert data["response"]["allowed"] is True
+    assert data["response"]["patchType"] == "JSONPatch"
+    patch = json.loads(base64.b64decode(data["response"]["patch"]))
+    assert patch == [{"op": "replace", "path": "/spec/containers/0/image", "value": f"nginx@{digest}"}]